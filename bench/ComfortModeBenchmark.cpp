@@ -0,0 +1,237 @@
+/******************************************************************************
+ *  FILE         : ComfortModeBenchmark.cpp
+ *  DESCRIPTION  : Runs ComfortMode control passes over 1k, 10k and 50k mixed
+ *                 thermostats whose readings drift between passes, and
+ *                 reports pass time (p50 / max) against the 1 ms budget
+ *                 together with how many thermostats were skipped or switched.
+ *                 Also checks that a 0 s control period is rejected, that
+ *                 a 1 s loop returns from every scheduler tick, and that a
+ *                 thermostat able to heat and cool idles between the two,
+ *                 and that a pass run late on an executor is ignored.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Automation/ComfortMode.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SmartHome::Devices;
+using namespace SmartHome::Devices::Thermostats;
+using SmartHome::Automation::ComfortMode;
+using SmartHome::Controller::Scheduler;
+
+namespace
+{
+    constexpr int PASSES = 200;
+    constexpr int ROOM_SIZE = 8;        // Thermostats per group
+
+    void measure(int thermostatCount)
+    {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> start(18.0f, 30.0f);
+        std::normal_distribution<float> drift(0.0f, 0.2f);
+
+        std::vector<std::shared_ptr<DeviceGroup>> groups;
+        std::vector<std::shared_ptr<BaseThermostat>> thermostats;
+        for (int i = 0; i < thermostatCount; ++i)
+        {
+            if (i % ROOM_SIZE == 0)
+                groups.push_back(std::make_shared<DeviceGroup>("zone-" + std::to_string(i / ROOM_SIZE)));
+
+            const std::string id = "tstat-" + std::to_string(i);
+            std::shared_ptr<BaseThermostat> thermostat;
+            switch (i % 3)
+            {
+                case 0: thermostat = std::make_shared<BaseThermostat>(id, "Thermostat"); break;
+                case 1: thermostat = std::make_shared<CoolerThermostat>(id, "AC"); break;
+                default: thermostat = std::make_shared<HeaterThermostat>(id, "Heater"); break;
+            }
+            thermostat->setCurrentTemperature(start(rng));
+            groups.back()->addDevice(thermostat);
+            thermostats.push_back(std::move(thermostat));
+        }
+
+        Scheduler scheduler;
+        ComfortMode comfort(scheduler);
+        comfort.activate(groups);
+
+        std::vector<std::int64_t> passNs;
+        std::size_t skipped = 0;
+        std::size_t changed = 0;
+        for (int pass = 0; pass < PASSES; ++pass)
+        {
+            // Rooms drift toward the target while conditioned and away otherwise
+            for (const auto& thermostat : thermostats)
+            {
+                float reading = thermostat->getCurrentTemperature() + drift(rng);
+                if (thermostat->getMode() == BaseThermostat::ThermostatMode::COOLING)
+                    reading -= 0.3f;
+                else if (thermostat->getMode() == BaseThermostat::ThermostatMode::HEATING)
+                    reading += 0.3f;
+                thermostat->setCurrentTemperature(reading);
+            }
+
+            const ComfortMode::TickStats stats = comfort.controlPass();
+            passNs.push_back(stats.durationNs);
+            skipped += stats.skipped;
+            changed += stats.changed;
+        }
+        comfort.deactivate();
+
+        std::sort(passNs.begin(), passNs.end());
+        std::cout << "  " << thermostatCount << " thermostats: p50 " << passNs[PASSES / 2] / 1000.0
+                  << " us, max " << passNs.back() / 1000.0 << " us per pass (budget "
+                  << ComfortMode::TICK_BUDGET_NS / 1000 << " us), "
+                  << skipped / PASSES << " in deadband, " << changed / PASSES << " switched per pass\n";
+    }
+
+    /*
+     * Description : A period under 1 s must be refused, and the shortest
+     *               allowed loop must run once per tick and let tick() return.
+     */
+    bool checkPeriod(void)
+    {
+        Scheduler scheduler;
+        auto group = std::make_shared<DeviceGroup>("zone");
+        auto heater = std::make_shared<HeaterThermostat>("tstat", "Heater");
+        heater->setCurrentTemperature(heater->getTargetTemperature() - 5.0f);
+        group->addDevice(heater);
+
+        int rejected = 0;
+        for (const int period : { 0, -5 })
+        {
+            try
+            {
+                ComfortMode comfort(scheduler, ComfortMode::ComfortPolicy{ 0.5f, period });
+            }
+            catch (const std::invalid_argument&)
+            {
+                ++rejected;
+            }
+            ComfortMode comfort(scheduler);
+            try
+            {
+                comfort.setPolicy(ComfortMode::ComfortPolicy{ 0.5f, period });
+            }
+            catch (const std::invalid_argument&)
+            {
+                ++rejected;
+            }
+        }
+
+        ComfortMode comfort(scheduler, ComfortMode::ComfortPolicy{ 0.5f, 1 });
+        comfort.activate({ group });
+        int passes = 0;
+        for (int second = 0; second < 5; ++second)
+        {
+            heater->setMode(BaseThermostat::ThermostatMode::OFF);
+            scheduler.tick(1);      // Would never return if the loop rearmed at 0 s
+            passes += heater->getMode() == BaseThermostat::ThermostatMode::HEATING ? 1 : 0;
+        }
+        comfort.deactivate();
+
+        const bool ok = rejected == 4 && passes == 5;
+        std::cout << "  period check: " << rejected << " of 4 bad periods rejected, " << passes
+                  << " of 5 ticks returned after a pass" << (ok ? "" : "  FAILED") << "\n";
+        return ok;
+    }
+
+    /*
+     * Description : A cold room with a heat-and-cool thermostat: heating
+     *               must stop at the target and the room must never be
+     *               switched from heating straight to cooling or back.
+     */
+    bool checkHysteresis(void)
+    {
+        Scheduler scheduler;
+        auto group = std::make_shared<DeviceGroup>("zone");
+        auto thermostat = std::make_shared<BaseThermostat>("tstat", "Thermostat");
+        thermostat->setCurrentTemperature(thermostat->getTargetTemperature() - 3.0f);
+        group->addDevice(thermostat);
+
+        ComfortMode comfort(scheduler);
+        comfort.activate({ group });
+
+        using Mode = BaseThermostat::ThermostatMode;
+        int flips = 0;
+        int idlePasses = 0;
+        Mode previous = thermostat->getMode();
+        for (int pass = 0; pass < 200; ++pass)
+        {
+            float reading = thermostat->getCurrentTemperature() - 0.1f;     // Heat loss
+            if (thermostat->getMode() == Mode::HEATING)
+                reading += 0.4f;
+            else if (thermostat->getMode() == Mode::COOLING)
+                reading -= 0.4f;
+            thermostat->setCurrentTemperature(reading);
+
+            comfort.controlPass();
+            const Mode mode = thermostat->getMode();
+            flips += (previous != Mode::OFF && mode != Mode::OFF && mode != previous) ? 1 : 0;
+            idlePasses += (mode == Mode::OFF) ? 1 : 0;
+            previous = mode;
+        }
+        comfort.deactivate();
+
+        const bool ok = flips == 0 && idlePasses > 0;
+        std::cout << "  hysteresis check: " << flips << " direct heat/cool flips, " << idlePasses
+                  << " of 200 passes idle" << (ok ? "" : "  FAILED") << "\n";
+        return ok;
+    }
+
+    /*
+     * Description : A pass handed to an executor that runs only after
+     *               deactivate() must not switch a thermostat or re-arm.
+     */
+    bool checkStalePass(void)
+    {
+        Scheduler scheduler;
+        std::vector<Scheduler::ScheduledTask> handedOff;
+        scheduler.setExecutor([&handedOff](Scheduler::ScheduledTask task) { handedOff.push_back(std::move(task)); });
+
+        auto group = std::make_shared<DeviceGroup>("zone");
+        auto heater = std::make_shared<HeaterThermostat>("tstat", "Heater");
+        heater->setCurrentTemperature(heater->getTargetTemperature() - 5.0f);
+        group->addDevice(heater);
+
+        ComfortMode comfort(scheduler, ComfortMode::ComfortPolicy{ 0.5f, 1 });
+        comfort.activate({ group });
+        heater->setMode(BaseThermostat::ThermostatMode::OFF);
+        scheduler.tick(1);
+        comfort.deactivate();
+
+        for (auto& task : handedOff)
+            task();
+
+        const bool ok = handedOff.size() == 1 && scheduler.pendingCount() == 0
+                     && heater->getMode() == BaseThermostat::ThermostatMode::OFF;
+        std::cout << "  stale pass check: " << (ok ? "ignored after deactivate" : "FAILED") << "\n";
+        return ok;
+    }
+}
+
+int main()
+{
+    std::cout << "ComfortMode control pass (" << PASSES << " passes, 0.5 C deadband)\n";
+
+    measure(1000);
+    measure(10000);
+    measure(50000);
+
+    const bool periodOk = checkPeriod();
+    const bool hysteresisOk = checkHysteresis();
+    const bool staleOk = checkStalePass();
+    return (periodOk && hysteresisOk && staleOk) ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,254 @@
+/******************************************************************************
+ *  FILE         : CommandBatchBenchmark.cpp
+ *  DESCRIPTION  : Switches 500 rooms from an evening scene to a night scene.
+ *                 Each room tears down the old scene, then the night scene,
+ *                 the security mode and the comfort loop issue their own
+ *                 commands. The stream runs once command by command and once
+ *                 through a CommandBatch, on two identical houses, first
+ *                 in memory only and then journaling every write as the
+ *                 controller does; in memory also through a batch that
+ *                 does not coalesce. Reports device writes issued vs.
+ *                 made, time per switch, and checks all houses end in the
+ *                 same state and that thermostat power and mode writes,
+ *                 which depend on earlier writes, are never dropped.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Commands/CommandBatch.hpp"
+#include "SmartHome/Commands/SupportedCommands.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+#include "SmartHome/Persistence/CommandJournal.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace SmartHome::Commands;
+using SmartHome::Core::CommandRecord;
+using SmartHome::Core::ICommand;
+using SmartHome::Devices::DoorLock;
+using SmartHome::Devices::Cameras::WirelessCamera;
+using SmartHome::Devices::Lights::DimmableLight;
+using SmartHome::Devices::Thermostats::BaseThermostat;
+using SmartHome::Devices::Thermostats::HeaterThermostat;
+using SmartHome::Persistence::CommandJournal;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr int ROOMS = 500;
+    constexpr int LIGHTS_PER_ROOM = 4;
+    constexpr int SWITCHES = 200;
+
+    const char* const JOURNAL_PATH = "batch_bench.journal";
+
+    struct Room
+    {
+        std::vector<std::shared_ptr<DimmableLight>> lights;
+        std::shared_ptr<HeaterThermostat> thermostat;
+        std::shared_ptr<DoorLock> lock;
+        std::shared_ptr<WirelessCamera> camera;
+    };
+
+    std::vector<Room> buildHouse(void)
+    {
+        std::vector<Room> house(ROOMS);
+        for (int r = 0; r < ROOMS; ++r)
+        {
+            const std::string room = "room-" + std::to_string(r);
+            for (int l = 0; l < LIGHTS_PER_ROOM; ++l)
+                house[r].lights.push_back(std::make_shared<DimmableLight>(room + "-light-" + std::to_string(l), "bench"));
+            house[r].thermostat = std::make_shared<HeaterThermostat>(room + "-thermostat", "bench");
+            house[r].lock = std::make_shared<DoorLock>(room + "-lock", "bench");
+            house[r].camera = std::make_shared<WirelessCamera>(room + "-camera", "bench", 100, true);
+        }
+        return house;
+    }
+
+    /*
+     * Description : The commands of one evening -> night switch, in the order
+     *               the scene, the modes and the comfort loop issue them.
+     */
+    std::vector<std::shared_ptr<ICommand>> sceneSwitch(const std::vector<Room>& house)
+    {
+        std::vector<std::shared_ptr<ICommand>> commands;
+        for (const Room& room : house)
+        {
+            // Tear down the evening scene
+            for (const auto& light : room.lights)
+                commands.push_back(std::make_shared<TurnOffCommand>(light));
+            commands.push_back(std::make_shared<SetThermostatModeCommand>(room.thermostat, BaseThermostat::ThermostatMode::OFF));
+            commands.push_back(std::make_shared<StopRecordingCommand>(room.camera));
+
+            // Night scene: night lights, cooler target, locked, watched
+            for (const auto& light : room.lights)
+            {
+                commands.push_back(std::make_shared<TurnOnCommand>(light));
+                commands.push_back(std::make_shared<SetBrightnessCommand>(light, 20));
+            }
+            commands.push_back(std::make_shared<SetTargetTemperatureCommand>(room.thermostat, 19));
+            commands.push_back(std::make_shared<SetThermostatModeCommand>(room.thermostat, BaseThermostat::ThermostatMode::HEATING));
+            commands.push_back(std::make_shared<LockCommand>(room.lock));
+            commands.push_back(std::make_shared<EnableNightVisionCommand>(room.camera));
+            commands.push_back(std::make_shared<StartRecordingCommand>(room.camera));
+
+            // Security mode arms the same room; comfort trims the target
+            commands.push_back(std::make_shared<LockCommand>(room.lock));
+            commands.push_back(std::make_shared<StartRecordingCommand>(room.camera));
+            commands.push_back(std::make_shared<SetTargetTemperatureCommand>(room.thermostat, 18));
+
+            // Hall lights stay off at night
+            commands.push_back(std::make_shared<TurnOffCommand>(room.lights[0]));
+        }
+        return commands;
+    }
+
+    std::string stateOf(const std::vector<Room>& house)
+    {
+        std::string state;
+        for (const Room& room : house)
+        {
+            for (const auto& light : room.lights)
+                state += light->getStatus() + std::to_string(light->getBrightness()) + ";";
+            state += room.thermostat->getStatus() + ";" + room.lock->getStatus() + ";" + room.camera->getStatus() + ";";
+        }
+        return state;
+    }
+
+    /*
+     * Description : Runs 'commands' on a fresh thermostat one by one and
+     *               through a CommandBatch; true if both end the same.
+     */
+    template <typename MakeCommands>
+    bool sameAsSerial(const char* label, MakeCommands makeCommands)
+    {
+        auto serial = std::make_shared<BaseThermostat>("serial", "bench");
+        auto batched = std::make_shared<BaseThermostat>("batched", "bench");
+
+        for (const auto& command : makeCommands(serial))
+            command->execute();
+
+        CommandBatch batch;
+        for (const auto& command : makeCommands(batched))
+            batch.add(command);
+        batch.execute();
+
+        const bool ok = serial->getStatus() == batched->getStatus();
+        std::cout << "  " << label << ": " << (ok ? "same as serial" : "DIFFERENT") << "\n";
+        return ok;
+    }
+
+    std::size_t writesOf(const std::vector<std::shared_ptr<ICommand>>& commands)
+    {
+        std::vector<CommandRecord> writes;
+        for (const auto& command : commands)
+            command->describe(writes);
+        return writes.size();
+    }
+}
+
+int main()
+{
+    std::vector<Room> direct = buildHouse();
+    std::vector<Room> batched = buildHouse();
+    std::vector<Room> deferred = buildHouse();
+    const auto directCommands = sceneSwitch(direct);
+    const auto batchedCommands = sceneSwitch(batched);
+    const auto deferredCommands = sceneSwitch(deferred);
+
+    std::cout << "Scene switch: " << ROOMS << " rooms, " << directCommands.size() << " commands, "
+              << writesOf(directCommands) << " device writes issued\n";
+
+    bool same = true;
+    for (const bool journaled : { false, true })
+    {
+        std::remove(JOURNAL_PATH);
+        CommandJournal journal;
+        if (journaled)
+            journal.open(JOURNAL_PATH);
+
+        // Command by command
+        const auto directStart = Clock::now();
+        for (int s = 0; s < SWITCHES; ++s)
+        {
+            for (const auto& command : directCommands)
+            {
+                if (journaled)
+                    JournaledCommand(command, journal).execute();
+                else
+                    command->execute();
+            }
+        }
+        const double directUs = std::chrono::duration<double, std::micro>(Clock::now() - directStart).count() / SWITCHES;
+
+        // Coalesced per switch
+        CommandBatch batch;
+        const auto batchStart = Clock::now();
+        for (int s = 0; s < SWITCHES; ++s)
+        {
+            for (const auto& command : batchedCommands)
+                batch.add(command);
+            if (journaled)
+                JournaledCommand(batch.release(), journal).execute();
+            else
+                batch.execute();
+        }
+        const double batchUs = std::chrono::duration<double, std::micro>(Clock::now() - batchStart).count() / SWITCHES;
+
+        journal.close();
+        std::remove(JOURNAL_PATH);
+
+        const BatchStats& stats = batch.stats();
+        same = same && stateOf(direct) == stateOf(batched);
+        std::cout << (journaled ? " journaled writes:\n" : " in-memory writes:\n")
+                  << "  direct      : " << directCommands.size() << " commands run, " << directUs << " us/switch\n"
+                  << "  CommandBatch: " << stats.commandsRun / SWITCHES << " commands run, "
+                  << stats.writesRun / SWITCHES << " of " << stats.writesAdded / SWITCHES << " writes made ("
+                  << 100.0 * static_cast<double>(stats.writesAdded - stats.writesRun) / static_cast<double>(stats.writesAdded)
+                  << "% saved), " << batchUs << " us/switch\n";
+
+        if (!journaled)
+        {
+            // Deferred only, as RuleEngine runs its actions
+            CommandBatch plain(false);
+            const auto plainStart = Clock::now();
+            for (int s = 0; s < SWITCHES; ++s)
+            {
+                for (const auto& command : deferredCommands)
+                    plain.add(command);
+                plain.execute();
+            }
+            const double plainUs = std::chrono::duration<double, std::micro>(Clock::now() - plainStart).count() / SWITCHES;
+
+            same = same && stateOf(direct) == stateOf(deferred);
+            std::cout << "  no coalesce : " << plain.stats().commandsRun / SWITCHES << " commands run, "
+                      << plainUs << " us/switch\n";
+        }
+    }
+    std::cout << "  final state " << (same ? "identical" : "DIFFERENT") << "\n";
+
+    using Mode = BaseThermostat::ThermostatMode;
+    std::cout << " state-dependent writes:\n";
+    same = sameAsSerial("mode, off, on     ", [](const std::shared_ptr<BaseThermostat>& t)
+    {
+        return std::vector<std::shared_ptr<ICommand>>{ std::make_shared<SetThermostatModeCommand>(t, Mode::HEATING),
+                                                       std::make_shared<TurnOffCommand>(t),
+                                                       std::make_shared<TurnOnCommand>(t) };
+    }) && same;
+    same = sameAsSerial("mode, target, mode", [](const std::shared_ptr<BaseThermostat>& t)
+    {
+        return std::vector<std::shared_ptr<ICommand>>{ std::make_shared<SetThermostatModeCommand>(t, Mode::COOLING),
+                                                       std::make_shared<SetTargetTemperatureCommand>(t, 30),
+                                                       std::make_shared<SetThermostatModeCommand>(t, Mode::HEATING) };
+    }) && same;
+
+    return same ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
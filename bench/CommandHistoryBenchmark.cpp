@@ -0,0 +1,138 @@
+/******************************************************************************
+ *  FILE         : CommandHistoryBenchmark.cpp
+ *  DESCRIPTION  : Pushes one million executed SetBrightness commands into a
+ *                 1024-deep history, once as retained shared_ptr<ICommand>
+ *                 objects in a capped deque and once as CommandHistory
+ *                 records. Reports ns per command, heap bytes held by the
+ *                 full history and the cost of undoing all of it.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Controllers/CommandHistory.hpp"
+#include "SmartHome/Commands/SetBrightnessCommand.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+using SmartHome::Commands::SetBrightnessCommand;
+using SmartHome::Controller::CommandHistory;
+using SmartHome::Core::CommandRecord;
+using SmartHome::Core::ICommand;
+using SmartHome::Core::IDevice;
+using SmartHome::Devices::Lights::DimmableLight;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    std::atomic<long long> g_liveBytes{0};
+}
+
+// Count heap bytes in use; the size is stored in front of each block
+void* operator new(std::size_t size)
+{
+    auto* block = static_cast<std::size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if (!block)
+        throw std::bad_alloc();
+    *block = size;
+    g_liveBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (!pointer)
+        return;
+    auto* block = reinterpret_cast<std::size_t*>(static_cast<char*>(pointer) - sizeof(std::max_align_t));
+    g_liveBytes.fetch_sub(static_cast<long long>(*block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+namespace
+{
+    constexpr int COMMANDS = 1000000;
+    constexpr std::size_t DEPTH = 1024;
+
+    double nsPer(Clock::time_point start, long long count)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+    }
+}
+
+int main()
+{
+    auto light = std::make_shared<DimmableLight>("hall", "bench");
+    std::cout << "Command history: " << COMMANDS << " commands, depth " << DEPTH << "\n";
+
+    // Retained command objects, oldest dropped past the depth
+    {
+        const long long before = g_liveBytes.load();
+        std::deque<std::shared_ptr<ICommand>> history;
+
+        const auto start = Clock::now();
+        for (int i = 0; i < COMMANDS; ++i)
+        {
+            auto command = std::make_shared<SetBrightnessCommand>(light, i % 101);
+            command->execute();
+            history.push_back(std::move(command));
+            if (history.size() > DEPTH)
+                history.pop_front();
+        }
+        const double pushNs = nsPer(start, COMMANDS);
+        const long long held = g_liveBytes.load() - before;
+
+        const auto undoStart = Clock::now();
+        while (!history.empty())
+        {
+            history.back()->undo();
+            history.pop_back();
+        }
+        std::cout << "  shared_ptr<ICommand> deque: " << pushNs << " ns/command, "
+                  << held << " heap bytes held, undo " << nsPer(undoStart, DEPTH) << " ns/command\n";
+    }
+
+    // Flat records in a fixed ring
+    {
+        const long long before = g_liveBytes.load();
+        CommandHistory history(DEPTH, [&light](const IDevice&) { return light; });
+        std::vector<CommandRecord> writes;
+
+        const auto start = Clock::now();
+        for (int i = 0; i < COMMANDS; ++i)
+        {
+            auto command = std::make_shared<SetBrightnessCommand>(light, i % 101);
+            command->execute();
+            writes.clear();
+            command->describe(writes);
+            history.push(writes);
+        }
+        const double pushNs = nsPer(start, COMMANDS);
+        const long long held = g_liveBytes.load() - before - static_cast<long long>(writes.capacity() * sizeof(CommandRecord));
+
+        std::vector<CommandRecord> applied;
+        applied.reserve(DEPTH);
+        const auto undoStart = Clock::now();
+        while (history.undo(applied))
+        {
+        }
+        std::cout << "  CommandHistory records    : " << pushNs << " ns/command, "
+                  << held << " heap bytes held, undo " << nsPer(undoStart, DEPTH) << " ns/command\n";
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
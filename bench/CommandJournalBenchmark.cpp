@@ -0,0 +1,193 @@
+/******************************************************************************
+ *  FILE         : CommandJournalBenchmark.cpp
+ *  DESCRIPTION  : Four threads run journaled SetBrightness commands and
+ *                 wait until each is durable, once with an fsync per
+ *                 command and once with group commit; a third run appends
+ *                 without waiting. Reports commands/s, fsyncs and p50 / p99
+ *                 command latency, then replays the journal to check it.
+ *                 Also checks that rule actions are journaled and that a
+ *                 reset keeps the records appended after its snapshot mark.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Persistence/CommandJournal.hpp"
+#include "SmartHome/Automation/RuleEngine.hpp"
+#include "SmartHome/Commands/JournaledCommand.hpp"
+#include "SmartHome/Commands/SetBrightnessCommand.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using SmartHome::Automation::RuleEngine;
+using SmartHome::Commands::JournaledCommand;
+using SmartHome::Commands::SetBrightnessCommand;
+using SmartHome::Core::DeviceEvent;
+using SmartHome::Core::EventType;
+using SmartHome::Core::IDevice;
+using SmartHome::Devices::Lights::DimmableLight;
+using SmartHome::Persistence::CommandJournal;
+using SmartHome::Persistence::JournalOptions;
+using SmartHome::Persistence::SyncPolicy;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr int THREADS = 4;
+    constexpr int COMMANDS_PER_THREAD = 2000;
+    constexpr int LIGHTS_PER_THREAD = 16;
+
+    const char* const JOURNAL_PATH = "journal_bench.log";
+
+    void measure(const char* label, SyncPolicy policy, bool waitForDisk,
+                 const std::vector<std::vector<std::shared_ptr<DimmableLight>>>& lights)
+    {
+        std::remove(JOURNAL_PATH);
+
+        JournalOptions options;
+        options.policy = policy;
+        CommandJournal journal(options);
+        journal.open(JOURNAL_PATH);
+
+        std::vector<std::vector<double>> latencies(THREADS);
+        std::vector<std::thread> threads;
+
+        const auto start = Clock::now();
+        for (int t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                latencies[t].reserve(COMMANDS_PER_THREAD);
+                for (int i = 0; i < COMMANDS_PER_THREAD; ++i)
+                {
+                    const auto issued = Clock::now();
+                    JournaledCommand command(std::make_shared<SetBrightnessCommand>(
+                        lights[t][i % LIGHTS_PER_THREAD], 1 + i % 100), journal);
+                    command.execute();
+                    if (waitForDisk)
+                        journal.waitDurable(command.lastLsn());
+                    latencies[t].push_back(std::chrono::duration<double, std::micro>(Clock::now() - issued).count());
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        journal.flush();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::vector<double> all;
+        for (const auto& perThread : latencies)
+            all.insert(all.end(), perThread.begin(), perThread.end());
+        std::sort(all.begin(), all.end());
+
+        const int total = THREADS * COMMANDS_PER_THREAD;
+        std::cout << "  " << label << ": " << static_cast<long long>(total / seconds) << " commands/s, "
+                  << journal.syncCount() << " fsyncs, latency p50 " << all[all.size() / 2]
+                  << " us, p99 " << all[all.size() * 99 / 100] << " us\n";
+    }
+
+    /*
+     * Description : Two rules start two cameras through a journaled
+     *               RuleEngine; a reset at a mark taken between them must
+     *               drop the first record only, as after a snapshot taken
+     *               while automation was still running.
+     */
+    bool journalsAutomation()
+    {
+        using namespace SmartHome::Devices;
+
+        std::remove(JOURNAL_PATH);
+        std::unordered_map<std::string, std::shared_ptr<IDevice>> byId;
+        auto firstSensor = std::make_shared<Sensors::MotionSensor>("m1");
+        auto secondSensor = std::make_shared<Sensors::MotionSensor>("m2");
+        auto firstCamera = std::make_shared<Cameras::BaseCamera>("c1", "Cam");
+        auto secondCamera = std::make_shared<Cameras::BaseCamera>("c2", "Cam");
+        for (const std::shared_ptr<IDevice>& device : { std::shared_ptr<IDevice>(firstSensor), std::shared_ptr<IDevice>(secondSensor),
+                                                        std::shared_ptr<IDevice>(firstCamera), std::shared_ptr<IDevice>(secondCamera) })
+            byId.emplace(device->getID(), device);
+        auto resolve = [&byId](std::string_view id) -> std::shared_ptr<IDevice>
+        {
+            auto it = byId.find(std::string(id));
+            return it != byId.end() ? it->second : nullptr;
+        };
+
+        CommandJournal journal;
+        journal.open(JOURNAL_PATH);
+        RuleEngine engine(&journal);
+        engine.load("rule one: when motion(m1) then record(c1)\n"
+                    "rule two: when motion(m2) then record(c2)\n", resolve);
+
+        engine.onEvent(DeviceEvent{ EventType::MOTION, true, 0.0f, firstSensor.get(), 0 });
+        journal.flush();
+        const std::uint64_t covered = journal.lastLsn();
+        engine.onEvent(DeviceEvent{ EventType::MOTION, true, 0.0f, secondSensor.get(), 0 });
+        journal.flush();    // Both records are on disk; reset must rewrite the second
+        journal.reset(covered);
+        journal.close();
+
+        firstCamera->stopRecording();
+        secondCamera->stopRecording();
+        const auto result = CommandJournal::replay(JOURNAL_PATH, resolve);
+        std::remove(JOURNAL_PATH);
+
+        const bool ok = covered > 0 && result.applied == 1 && !firstCamera->isRecording() && secondCamera->isRecording();
+        std::cout << "  automation: " << (ok ? "rule actions journaled, reset keeps later records\n" : "FAILED\n");
+        return ok;
+    }
+}
+
+int main()
+{
+    std::vector<std::vector<std::shared_ptr<DimmableLight>>> lights(THREADS);
+    std::unordered_map<std::string, std::shared_ptr<IDevice>> byId;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        for (int l = 0; l < LIGHTS_PER_THREAD; ++l)
+        {
+            auto light = std::make_shared<DimmableLight>("light-" + std::to_string(t) + "-" + std::to_string(l), "bench");
+            lights[t].push_back(light);
+            byId.emplace(light->getID(), light);
+        }
+    }
+
+    std::cout << "CommandJournal: " << THREADS << " threads x " << COMMANDS_PER_THREAD
+              << " commands, each acknowledged once durable\n";
+
+    measure("fsync per command", SyncPolicy::EVERY_RECORD, true, lights);
+    measure("group commit     ", SyncPolicy::GROUP_COMMIT, true, lights);
+    measure("group, no wait   ", SyncPolicy::GROUP_COMMIT, false, lights);
+
+    // Undo the last run's effect, then check replay brings it back
+    const int expected = lights[0][(COMMANDS_PER_THREAD - 1) % LIGHTS_PER_THREAD]->getBrightness();
+    for (auto& perThread : lights)
+        for (auto& light : perThread)
+            light->setBrightness(0);
+
+    const auto replayStart = Clock::now();
+    const auto result = CommandJournal::replay(JOURNAL_PATH, [&byId](std::string_view id)
+    {
+        auto it = byId.find(std::string(id));
+        return it != byId.end() ? it->second : nullptr;
+    });
+    const double replayMs = std::chrono::duration<double, std::milli>(Clock::now() - replayStart).count();
+
+    const bool restored = lights[0][(COMMANDS_PER_THREAD - 1) % LIGHTS_PER_THREAD]->getBrightness() == expected;
+    std::cout << "  replay: " << result.applied << " records in " << replayMs << " ms, "
+              << result.skipped << " skipped, state " << (restored ? "restored" : "NOT restored") << "\n";
+
+    std::remove(JOURNAL_PATH);
+    const bool automated = journalsAutomation();
+    return (restored && automated && result.applied == static_cast<std::size_t>(THREADS * COMMANDS_PER_THREAD)) ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
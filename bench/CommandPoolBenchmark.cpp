@@ -0,0 +1,132 @@
+/******************************************************************************
+ *  FILE         : CommandPoolBenchmark.cpp
+ *  DESCRIPTION  : Runs bursts of 10,000 mixed commands (turn on, turn off,
+ *                 set brightness, lock) that are created, executed and
+ *                 released together, once with std::make_shared and once
+ *                 from a CommandPool. Reports heap allocations per burst
+ *                 and ns per command.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Commands/CommandPool.hpp"
+#include "SmartHome/Commands/SupportedCommands.hpp"
+#include "SmartHome/Devices/DoorLock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+using SmartHome::Commands::CommandPool;
+using SmartHome::Commands::LockCommand;
+using SmartHome::Commands::SetBrightnessCommand;
+using SmartHome::Commands::TurnOffCommand;
+using SmartHome::Commands::TurnOnCommand;
+using SmartHome::Core::ICommand;
+using SmartHome::Devices::DoorLock;
+using SmartHome::Devices::Lights::DimmableLight;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    std::atomic<long long> g_allocations{0};
+}
+
+// Count every call into the global allocator
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(size ? size : 1))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace
+{
+    constexpr int BURST = 10000;
+    constexpr int BURSTS = 100;
+
+    /*
+     * Description : Creates, executes and releases BURSTS bursts with
+     *               'make(kind, i)'; prints allocations and time per command.
+     */
+    template <typename Make>
+    void measure(const char* label, Make&& make)
+    {
+        std::vector<std::shared_ptr<ICommand>> burst;
+        burst.reserve(BURST);
+
+        long long firstBurst = 0;
+        const long long before = g_allocations.load();
+        const auto start = Clock::now();
+        for (int round = 0; round < BURSTS; ++round)
+        {
+            for (int i = 0; i < BURST; ++i)
+                burst.push_back(make(i % 4, i));
+            for (auto& command : burst)
+                command->execute();
+            burst.clear();
+
+            if (round == 0)
+                firstBurst = g_allocations.load() - before;
+        }
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        const long long total = g_allocations.load() - before;
+
+        std::cout << "  " << label << ": first burst " << firstBurst << " allocations, later bursts "
+                  << (total - firstBurst) / (BURSTS - 1) << " each, "
+                  << ns / (static_cast<double>(BURST) * BURSTS) << " ns/command\n";
+    }
+}
+
+int main()
+{
+    auto light = std::make_shared<DimmableLight>("hall", "bench");
+    auto lock = std::make_shared<DoorLock>("front", "bench");
+
+    std::cout << "Command allocation: " << BURSTS << " bursts of " << BURST << " commands\n";
+
+    measure("std::make_shared", [&](int kind, int i) -> std::shared_ptr<ICommand>
+    {
+        switch (kind)
+        {
+            case 0:  return std::make_shared<TurnOnCommand>(light);
+            case 1:  return std::make_shared<SetBrightnessCommand>(light, i % 101);
+            case 2:  return std::make_shared<TurnOffCommand>(light);
+            default: return std::make_shared<LockCommand>(lock);
+        }
+    });
+
+    CommandPool pool;
+    measure("CommandPool     ", [&](int kind, int i) -> std::shared_ptr<ICommand>
+    {
+        switch (kind)
+        {
+            case 0:  return pool.make<TurnOnCommand>(light);
+            case 1:  return pool.make<SetBrightnessCommand>(light, i % 101);
+            case 2:  return pool.make<TurnOffCommand>(light);
+            default: return pool.make<LockCommand>(lock);
+        }
+    });
+    std::cout << "  pool: " << pool.slabCount() << " slabs, " << pool.blocksInUse() << " blocks in use\n";
+
+    return pool.blocksInUse() == 0 ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,165 @@
+/******************************************************************************
+ *  FILE         : DeviceFactoryBenchmark.cpp
+ *  DESCRIPTION  : Resolves user-typed device keys ("light :: dimmable") the
+ *                 way the factory used to, normalizing into a new string and
+ *                 looking it up in an unordered_map of std::function, and
+ *                 through the DeviceFactory's compile-time perfect hash.
+ *                 Reports time and heap allocations per lookup, then
+ *                 creates 100,000 devices one call at a time and with
+ *                 createDevices().
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Factory/DeviceFactory.hpp"
+#include "SmartHome/Factory/DeviceRegistration.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using SmartHome::Core::IDevice;
+using SmartHome::Factory::DeviceFactory;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    std::atomic<long long> g_allocations{0};
+}
+
+// Count every call into the global allocator
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(size ? size : 1))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace
+{
+    constexpr int LOOKUPS = 1000000;
+    constexpr int DEVICES = 100000;
+
+    using CreatorFunc = DeviceFactory::CreatorFunc;
+
+    /*
+     * Description : The previous lookup: normalize into a new string, then
+     *               find it in a map of std::function creators.
+     */
+    struct MapFactory
+    {
+        std::unordered_map<std::string, CreatorFunc> creators;
+
+        static std::string makeKey(const std::string& raw)
+        {
+            std::string key = raw;
+            std::transform(key.begin(), key.end(), key.begin(), ::toupper);
+            key.erase(std::remove_if(key.begin(), key.end(), ::isspace), key.end());
+            return key;
+        }
+
+        bool isRegistered(const std::string& raw) const
+        {
+            return creators.find(makeKey(raw)) != creators.end();
+        }
+    };
+
+    template <typename... Devices>
+    void registerAll(MapFactory& factory, std::tuple<Devices...>*)
+    {
+        (factory.creators.emplace(std::string(SmartHome::Factory::DeviceTraits<Devices>::KEY),
+                                  &SmartHome::Factory::DeviceTraits<Devices>::create), ...);
+    }
+
+    double nsPer(Clock::time_point start, int count)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+    }
+}
+
+int main()
+{
+    const std::vector<std::string> typed = {
+        "light :: dimmable", "Light::Basic", "camera::wireless", "THERMOSTAT :: HEATER",
+        "thermostat::cooler", "lock::door", "sensor::motion", "light::led" };
+
+    MapFactory mapFactory;
+    registerAll(mapFactory, static_cast<SmartHome::Factory::BuiltInDevices*>(nullptr));
+    DeviceFactory& factory = DeviceFactory::getInstance();
+
+    std::cout << "Key lookup, " << LOOKUPS << " user-typed keys:\n";
+
+    std::size_t found = 0;
+    long long allocations = g_allocations.load();
+    auto start = Clock::now();
+    for (int i = 0; i < LOOKUPS; ++i)
+        found += mapFactory.isRegistered(typed[i % typed.size()]) ? 1 : 0;
+    double ns = nsPer(start, LOOKUPS);
+    std::cout << "  map + makeKey : " << ns << " ns/lookup, "
+              << static_cast<double>(g_allocations.load() - allocations) / LOOKUPS << " allocations/lookup\n";
+
+    std::size_t foundPerfect = 0;
+    allocations = g_allocations.load();
+    start = Clock::now();
+    for (int i = 0; i < LOOKUPS; ++i)
+        foundPerfect += factory.isRegistered(typed[i % typed.size()]) ? 1 : 0;
+    ns = nsPer(start, LOOKUPS);
+    std::cout << "  perfect hash  : " << ns << " ns/lookup, "
+              << static_cast<double>(g_allocations.load() - allocations) / LOOKUPS << " allocations/lookup\n";
+
+    std::vector<std::string> ids;
+    ids.reserve(DEVICES);
+    for (int d = 0; d < DEVICES; ++d)
+        ids.push_back("light-" + std::to_string(d));
+
+    std::cout << "Creating " << DEVICES << " dimmable lights:\n";
+    {
+        std::vector<std::shared_ptr<IDevice>> devices;
+        start = Clock::now();
+        for (const std::string& id : ids)
+            devices.push_back(mapFactory.creators.at(MapFactory::makeKey("light :: dimmable"))(id, "bench"));
+        std::cout << "  createDevice per id (map)  : " << nsPer(start, DEVICES) << " ns/device\n";
+    }
+    {
+        std::vector<std::shared_ptr<IDevice>> devices;
+        start = Clock::now();
+        for (const std::string& id : ids)
+            devices.push_back(factory.createDevice("light :: dimmable", id, "bench"));
+        std::cout << "  createDevice per id        : " << nsPer(start, DEVICES) << " ns/device\n";
+    }
+    std::size_t created = 0;
+    {
+        start = Clock::now();
+        const auto devices = factory.createDevices("light :: dimmable", ids, "bench");
+        std::cout << "  createDevices              : " << nsPer(start, DEVICES) << " ns/device\n";
+        created = devices.size();
+    }
+
+    const bool ok = found == foundPerfect && created == static_cast<std::size_t>(DEVICES);
+    std::cout << "  lookups agree: " << (found == foundPerfect ? "yes" : "NO") << "\n";
+    return ok ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
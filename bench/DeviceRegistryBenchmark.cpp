@@ -0,0 +1,120 @@
+/******************************************************************************
+ *  FILE         : DeviceRegistryBenchmark.cpp
+ *  DESCRIPTION  : Looks up devices by ID among 100k registered devices,
+ *                 comparing the controller's previous std::find_if over a
+ *                 vector (virtual getID() per probe) with an
+ *                 std::unordered_map and the DeviceRegistry. Reports time
+ *                 and heap allocations per lookup.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Controllers/DeviceRegistry.hpp"
+#include "SmartHome/Devices/Lights/BaseLight.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using SmartHome::Controller::DeviceRegistry;
+using SmartHome::Core::IDevice;
+using SmartHome::Devices::Lights::BaseLight;
+
+namespace
+{
+    std::atomic<std::size_t> g_allocations{0};
+
+    constexpr int DEVICES = 100000;
+    constexpr int LINEAR_LOOKUPS = 200;       // Each one walks half the vector on average
+    constexpr int HASHED_LOOKUPS = 1000000;
+
+    template <typename Lookup>
+    void measure(const char* label, const std::vector<std::string>& keys, int lookups, Lookup&& lookup)
+    {
+        const std::size_t allocationsBefore = g_allocations.load();
+        const auto start = std::chrono::steady_clock::now();
+
+        std::size_t found = 0;
+        for (int i = 0; i < lookups; ++i)
+            found += lookup(keys[i % keys.size()]) ? 1 : 0;
+
+        const auto end = std::chrono::steady_clock::now();
+        const std::size_t allocations = g_allocations.load() - allocationsBefore;
+
+        std::cout << "  " << label << ": "
+                  << std::chrono::duration<double, std::nano>(end - start).count() / lookups
+                  << " ns/lookup, "
+                  << static_cast<double>(allocations) / lookups << " allocations/lookup ("
+                  << found << "/" << lookups << " found)\n";
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    std::vector<std::shared_ptr<IDevice>> vector;
+    std::unordered_map<std::string, std::shared_ptr<IDevice>> map;
+    DeviceRegistry registry;
+
+    // IDs long enough to defeat the small-string buffer, as real ones usually are
+    std::vector<std::string> keys;
+    for (int i = 0; i < DEVICES; ++i)
+    {
+        keys.push_back("living-room-light-" + std::to_string(i));
+        auto device = std::make_shared<BaseLight>(keys.back(), "Bulb");
+        vector.push_back(device);
+        map.emplace(keys.back(), device);
+        registry.add(device);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+
+    std::cout << "Device lookup by ID among " << DEVICES << " devices\n";
+
+    measure("vector find_if", keys, LINEAR_LOOKUPS, [&vector](const std::string& id)
+    {
+        auto it = std::find_if(vector.begin(), vector.end(),
+            [&](auto& d) { return d->getID() == id; });
+        return it != vector.end();
+    });
+
+    measure("unordered_map ", keys, HASHED_LOOKUPS, [&map](const std::string& id)
+    {
+        return map.find(id) != map.end();
+    });
+
+    measure("DeviceRegistry", keys, HASHED_LOOKUPS, [&registry](const std::string& id)
+    {
+        return registry.get(id) != nullptr;
+    });
+
+    return 0;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,139 @@
+/******************************************************************************
+ *  FILE         : DeviceStoreBenchmark.cpp
+ *  DESCRIPTION  : Answers whole-house questions over 100k mixed devices two
+ *                 ways: walking shared_ptr<IDevice> with dynamic_pointer_cast
+ *                 (how the modes inspect devices today) and scanning the
+ *                 DeviceStoreManager's packed columns.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Devices/SupportedDevices.hpp"
+#include "SmartHome/Utils/DeviceStoreManager.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SmartHome::Devices;
+using SmartHome::Core::IDevice;
+using SmartHome::Utils::DeviceStoreManager;
+using Kind = DeviceStoreManager::DeviceKind;
+using Flag = DeviceStoreManager::Flag;
+
+namespace
+{
+    constexpr int DEVICES = 100000;
+    constexpr int ROUNDS = 20;
+
+    template <typename Body>
+    void measure(const char* label, Body&& body)
+    {
+        std::size_t result = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < ROUNDS; ++r)
+            result += body();
+        const auto end = std::chrono::steady_clock::now();
+
+        std::cout << "  " << label << ": "
+                  << std::chrono::duration<double, std::micro>(end - start).count() / ROUNDS
+                  << " us/query (result " << result / ROUNDS << ")\n";
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(11);
+    std::vector<std::shared_ptr<IDevice>> devices;
+    devices.reserve(DEVICES);
+
+    // Half lights, the rest split between locks, thermostats and motion sensors
+    for (int i = 0; i < DEVICES; ++i)
+    {
+        const std::string id = "device-" + std::to_string(i);
+        std::shared_ptr<IDevice> device;
+        switch (i % 6)
+        {
+            case 0: case 1: device = std::make_shared<Lights::BaseLight>(id, "Bulb"); break;
+            case 2:         device = std::make_shared<Lights::DimmableLight>(id, "Dimmer"); break;
+            case 3:         device = std::make_shared<DoorLock>(id, "Lock"); break;
+            case 4:         device = std::make_shared<Thermostats::CoolerThermostat>(id, "AC"); break;
+            default:        device = std::make_shared<Sensors::MotionSensor>(id); break;
+        }
+        if (rng() % 2)
+            device->turnOn();
+        devices.push_back(std::move(device));
+    }
+    // Shuffle so pointer-chasing sees the same scattered order a real registry would
+    std::shuffle(devices.begin(), devices.end(), rng);
+
+    DeviceStoreManager& store = DeviceStoreManager::getInstance();
+
+    std::cout << "Whole-house queries over " << DEVICES << " devices\n";
+
+    std::cout << "How many lights are on\n";
+    measure("shared_ptr + cast", [&devices]()
+    {
+        std::size_t on = 0;
+        for (const auto& device : devices)
+        {
+            if (auto light = std::dynamic_pointer_cast<Lights::BaseLight>(device))
+                on += light->isOn() ? 1 : 0;
+        }
+        return on;
+    });
+    measure("store popcount   ", [&store]()
+    {
+        return store.count(Kind::LIGHT, Flag::ON, true);
+    });
+
+    std::cout << "Visit all unlocked doors\n";
+    measure("shared_ptr + cast", [&devices]()
+    {
+        std::size_t unlocked = 0;
+        for (const auto& device : devices)
+        {
+            if (auto lock = std::dynamic_pointer_cast<DoorLock>(device))
+                unlocked += lock->isDoorLocked() ? 0 : 1;
+        }
+        return unlocked;
+    });
+    measure("store scan       ", [&store]()
+    {
+        std::size_t unlocked = 0;
+        store.forEach(Kind::DOOR_LOCK, Flag::LOCKED, false, [&unlocked](IDevice&) { ++unlocked; });
+        return unlocked;
+    });
+
+    std::cout << "Mean brightness of lights that are on\n";
+    measure("shared_ptr + cast", [&devices]()
+    {
+        std::size_t lights = 0, sum = 0;
+        for (const auto& device : devices)
+        {
+            if (auto dimmable = std::dynamic_pointer_cast<Lights::DimmableLight>(device))
+            {
+                if (dimmable->isOn()) { sum += dimmable->getBrightness(); ++lights; }
+            }
+            else if (auto light = std::dynamic_pointer_cast<Lights::BaseLight>(device))
+            {
+                if (light->isOn()) { sum += 100; ++lights; }
+            }
+        }
+        return lights ? sum / lights : 0;
+    });
+    measure("store scan       ", [&store]()
+    {
+        return static_cast<std::size_t>(store.averageBrightnessOn());
+    });
+
+    return 0;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
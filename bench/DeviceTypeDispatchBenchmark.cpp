@@ -0,0 +1,115 @@
+/******************************************************************************
+ *  FILE         : DeviceTypeDispatchBenchmark.cpp
+ *  DESCRIPTION  : Finds the camera, motion sensor and lock of 10k groups the
+ *                 way SecurityMode used to (a dynamic_pointer_cast per device
+ *                 and role) and through DeviceGroup's type index, then runs
+ *                 SecurityMode::activate over the same quiet groups.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Automation/SecurityMode.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace SmartHome::Devices;
+using SmartHome::Automation::SecurityMode;
+using SmartHome::Controller::Scheduler;
+using SmartHome::Core::DeviceType;
+
+namespace
+{
+    constexpr int GROUPS = 10000;
+    constexpr int ROUNDS = 20;
+
+    template <typename Body>
+    void measure(const char* label, Body&& body)
+    {
+        std::size_t found = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < ROUNDS; ++r)
+            found += body();
+        const auto end = std::chrono::steady_clock::now();
+
+        std::cout << "  " << label << ": "
+                  << std::chrono::duration<double, std::nano>(end - start).count()
+                         / (static_cast<double>(ROUNDS) * GROUPS)
+                  << " ns/group (" << found / ROUNDS << " roles found)\n";
+    }
+}
+
+int main()
+{
+    // A typical room: two lights, a thermostat, a camera, a motion sensor and a lock
+    std::vector<std::shared_ptr<DeviceGroup>> groups;
+    for (int g = 0; g < GROUPS; ++g)
+    {
+        const std::string prefix = "room-" + std::to_string(g) + "-";
+        auto group = std::make_shared<DeviceGroup>(prefix + "group");
+        group->addDevice(std::make_shared<Lights::BaseLight>(prefix + "ceiling", "Bulb"));
+        group->addDevice(std::make_shared<Lights::DimmableLight>(prefix + "lamp", "Dimmer"));
+        group->addDevice(std::make_shared<Thermostats::CoolerThermostat>(prefix + "ac", "AC"));
+        group->addDevice(std::make_shared<Cameras::BaseCamera>(prefix + "camera", "Cam"));
+        group->addDevice(std::make_shared<Sensors::MotionSensor>(prefix + "motion"));
+        group->addDevice(std::make_shared<DoorLock>(prefix + "lock", "Lock"));
+        groups.push_back(std::move(group));
+    }
+
+    std::cout << "Role lookup over " << GROUPS << " groups of 6 devices\n";
+
+    measure("dynamic_pointer_cast scan", [&groups]()
+    {
+        std::size_t found = 0;
+        for (const auto& group : groups)
+        {
+            std::shared_ptr<Cameras::BaseCamera> camera;
+            std::shared_ptr<Sensors::MotionSensor> motionSensor;
+            std::shared_ptr<DoorLock> lock;
+
+            for (const auto& [id, device] : group->getDevices())
+            {
+                if (!camera)
+                    camera = std::dynamic_pointer_cast<Cameras::BaseCamera>(device);
+                if (!motionSensor)
+                    motionSensor = std::dynamic_pointer_cast<Sensors::MotionSensor>(device);
+                if (!lock)
+                    lock = std::dynamic_pointer_cast<DoorLock>(device);
+            }
+            found += (camera != nullptr) + (motionSensor != nullptr) + (lock != nullptr);
+        }
+        return found;
+    });
+
+    measure("type index              ", [&groups]()
+    {
+        std::size_t found = 0;
+        for (const auto& group : groups)
+        {
+            found += (group->firstOfType(DeviceType::CAMERA) != nullptr)
+                   + (group->firstOfType(DeviceType::MOTION_SENSOR) != nullptr)
+                   + (group->firstOfType(DeviceType::DOOR_LOCK) != nullptr);
+        }
+        return found;
+    });
+
+    // No motion and every door locked; only the first round arms, later
+    // rounds find the groups unchanged
+    Scheduler scheduler;
+    SecurityMode security(scheduler);
+    measure("SecurityMode::activate  ", [&]()
+    {
+        security.activate(groups);
+        return std::size_t{0};
+    });
+
+    return 0;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,161 @@
+/******************************************************************************
+ *  FILE         : EventBusBenchmark.cpp
+ *  DESCRIPTION  : Measures the sensor event pipeline: producer-side publish
+ *                 cost with several threads, publish-to-delivery latency on
+ *                 the dispatch thread, and end-to-end SecurityMode reaction
+ *                 time (motion detected -> camera recording).
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Automation/SecurityMode.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+#include "SmartHome/Events/EventBus.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace SmartHome;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int EVENTS_PER_PRODUCER = 100000;
+    constexpr int LATENCY_SAMPLES = 2000;
+
+    /*
+     * Description : Counts deliveries and records publish-to-delivery latency.
+     */
+    class Probe : public Core::IObserver
+    {
+    public:
+        void onEvent(const Core::DeviceEvent& event) override
+        {
+            if (_record)
+                _latencyNs.push_back(Events::EventBus::nowNs() - event.timestampNs);
+            _delivered.fetch_add(1, std::memory_order_release);
+        }
+
+        void record(bool on) { _record = on; _latencyNs.reserve(LATENCY_SAMPLES); }
+        std::size_t delivered() const { return _delivered.load(std::memory_order_acquire); }
+        std::vector<std::int64_t>& samples() { return _latencyNs; }
+
+    private:
+        std::atomic<std::size_t> _delivered{0};
+        bool _record = false;
+        std::vector<std::int64_t> _latencyNs;
+    };
+
+    void printPercentiles(const char* label, std::vector<std::int64_t>& ns)
+    {
+        std::sort(ns.begin(), ns.end());
+        auto at = [&ns](double p) { return ns[static_cast<std::size_t>(p * (ns.size() - 1))] / 1000.0; };
+        std::cout << "  " << label << ": p50 " << at(0.50) << " us, p99 " << at(0.99)
+                  << " us, max " << ns.back() / 1000.0 << " us\n";
+    }
+}
+
+int main()
+{
+    Events::EventBus& bus = Events::EventBus::getInstance();
+    bus.start();
+
+    std::cout << "EventBus (" << std::thread::hardware_concurrency() << " hardware threads)\n";
+
+    // 1. Producer cost: every producer toggles its own motion sensor
+    {
+        Probe probe;
+        bus.subscribe(&probe, Core::eventMask(Core::EventType::MOTION));
+
+        std::vector<std::unique_ptr<Devices::Sensors::MotionSensor>> sensors;
+        for (int p = 0; p < PRODUCERS; ++p)
+            sensors.push_back(std::make_unique<Devices::Sensors::MotionSensor>("motion-" + std::to_string(p)));
+
+        std::vector<std::thread> producers;
+        const auto start = Clock::now();
+        for (int p = 0; p < PRODUCERS; ++p)
+        {
+            producers.emplace_back([&sensors, p]()
+            {
+                for (int i = 0; i < EVENTS_PER_PRODUCER; ++i)
+                    sensors[p]->setMotionDetected(i % 2 == 0);
+            });
+        }
+        for (auto& t : producers)
+            t.join();
+        const auto published = Clock::now();
+
+        while (probe.delivered() + bus.droppedCount() < static_cast<std::size_t>(PRODUCERS) * EVENTS_PER_PRODUCER)
+            std::this_thread::yield();
+        const auto delivered = Clock::now();
+
+        const double events = static_cast<double>(PRODUCERS) * EVENTS_PER_PRODUCER;
+        std::cout << "  publish        : "
+                  << std::chrono::duration<double, std::nano>(published - start).count() / events
+                  << " ns/event across " << PRODUCERS << " producers, drained after "
+                  << std::chrono::duration<double, std::milli>(delivered - start).count() << " ms ("
+                  << bus.droppedCount() << " dropped)\n";
+
+        bus.unsubscribe(&probe);
+    }
+
+    // 2. Latency of isolated events, each one waking the dispatcher
+    {
+        Probe probe;
+        probe.record(true);
+        bus.subscribe(&probe, Core::eventMask(Core::EventType::MOTION));
+
+        Devices::Sensors::MotionSensor sensor("hallway-motion");
+        for (int i = 0; i < LATENCY_SAMPLES; ++i)
+        {
+            sensor.setMotionDetected(i % 2 == 0);
+            while (probe.delivered() < static_cast<std::size_t>(i + 1))
+                std::this_thread::yield();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        bus.unsubscribe(&probe);
+        printPercentiles("delivery       ", probe.samples());
+    }
+
+    // 3. SecurityMode reaction: motion detected -> camera recording
+    {
+        Controller::Scheduler scheduler;
+        Automation::SecurityMode security(scheduler);
+
+        auto group = std::make_shared<Devices::DeviceGroup>("Hallway");
+        auto camera = std::make_shared<Devices::Cameras::BaseCamera>("hallway-cam", "Cam");
+        auto sensor = std::make_shared<Devices::Sensors::MotionSensor>("hallway-motion");
+        group->addDevice(camera);
+        group->addDevice(sensor);
+        security.activate({ group });
+
+        std::vector<std::int64_t> reactionNs;
+        for (int i = 0; i < LATENCY_SAMPLES; ++i)
+        {
+            camera->stopRecording();
+            sensor->setMotionDetected(false);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+            const auto start = Clock::now();
+            sensor->setMotionDetected(true);
+            while (!camera->isRecording())
+                std::this_thread::yield();
+            reactionNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+        security.deactivate();
+        printPercentiles("SecurityMode   ", reactionNs);
+    }
+
+    bus.stop();
+    return 0;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
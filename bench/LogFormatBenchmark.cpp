@@ -0,0 +1,177 @@
+/******************************************************************************
+ *  FILE         : LogFormatBenchmark.cpp
+ *  DESCRIPTION  : Compares the original log record path (std::string
+ *                 arguments, localtime + put_time through an ostringstream)
+ *                 with LogFormatter (string_view arguments, cached
+ *                 timestamp, reused buffer), then measures the whole
+ *                 synchronous Logger::log() path into the in-memory ring
+ *                 and into a stream. Reports time and heap allocations
+ *                 per record, and checks that fields are JSON-escaped.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Utils/LogFormatter.hpp"
+#include "SmartHome/Utils/Logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+using SmartHome::Utils::LogFormatter;
+using SmartHome::Utils::LogStreamConfig;
+using SmartHome::Utils::Logger;
+
+namespace
+{
+    std::atomic<std::size_t> g_allocations{0};
+
+    constexpr int RECORDS = 200000;
+
+    const char* const STREAM_PATH = "log_format_bench.ndjson";
+
+    /*
+     * Description : The record path as it was before LogFormatter.
+     */
+    std::string legacyFormat(const std::string& source,
+                             const std::string& action,
+                             const std::string& target,
+                             const std::string& result)
+    {
+        auto now = std::chrono::system_clock::now();
+        auto timeT = std::chrono::system_clock::to_time_t(now);
+        std::tm tm = *std::localtime(&timeT);
+
+        std::ostringstream logStream;
+        logStream << "{ ";
+        logStream << "\"timestamp\": \"" << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "\", ";
+        logStream << "\"source\": \"" << source << "\", ";
+        logStream << "\"action\": \"" << action << "\"";
+
+        if (!target.empty())
+            logStream << ", \"target\": \"" << target << "\"";
+
+        if (!result.empty())
+            logStream << ", \"result\": \"" << result << "\"";
+
+        logStream << " }";
+
+        return logStream.str();
+    }
+
+    std::int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    template <typename Body>
+    void measure(const char* label, Body&& body)
+    {
+        const std::size_t allocationsBefore = g_allocations.load();
+        const auto start = std::chrono::steady_clock::now();
+
+        std::size_t checksum = 0;
+        for (int i = 0; i < RECORDS; ++i)
+            checksum += body();
+
+        const auto end = std::chrono::steady_clock::now();
+        const std::size_t allocations = g_allocations.load() - allocationsBefore;
+
+        std::cout << "  " << label << ": "
+                  << std::chrono::duration<double, std::nano>(end - start).count() / RECORDS
+                  << " ns/record, "
+                  << static_cast<double>(allocations) / RECORDS << " allocations/record"
+                  << " (checksum " << checksum << ")\n";
+    }
+
+    /*
+     * Description : Quotes, backslashes and control characters in any field
+     *               must come out escaped, keeping the record one JSON line.
+     */
+    bool escapesFields()
+    {
+        LogFormatter formatter;
+        const std::string_view record = formatter.format(nowNs(), "say \"hi\"", "C:\\logs",
+                                                         "line\nbreak\ttab", "\x01");
+        const std::string_view expected =
+            "\"source\": \"say \\\"hi\\\"\", \"action\": \"C:\\\\logs\", "
+            "\"target\": \"line\\nbreak\\ttab\", \"result\": \"\\u0001\" }";
+
+        const std::size_t at = record.find("\"source\"");
+        const bool ok = at != std::string_view::npos && record.substr(at) == expected;
+        std::cout << "  escaping: " << (ok ? "fields escaped\n" : "FAILED\n");
+        return ok;
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    std::cout << "Log record construction (" << RECORDS << " records)\n";
+
+    // Literals as SecurityMode passes them; the legacy API turns them into std::strings
+    measure("legacy         ", []()
+    {
+        return legacyFormat("SecurityMode", "Motion detected - Camera started recording",
+                            "LivingRoom", "").size();
+    });
+
+    LogFormatter formatter;
+    measure("formatter      ", [&formatter]()
+    {
+        return formatter.format(nowNs(), "SecurityMode", "Motion detected - Camera started recording",
+                                "LivingRoom", {}).size();
+    });
+
+    Logger& logger = Logger::getInstance();
+    auto logOne = [&logger]()
+    {
+        logger.log("SecurityMode", "Motion detected - Camera started recording", "LivingRoom");
+        return std::size_t(1);
+    };
+
+    // Fill the in-memory ring once so its buffers exist, as in a running system
+    for (std::size_t i = 0; i < Logger::MEMORY_ENTRIES; ++i)
+        logOne();
+    measure("log() -> memory", logOne);
+
+    std::remove(STREAM_PATH);
+    LogStreamConfig config;
+    config.filePath = STREAM_PATH;
+    config.maxFileBytes = std::size_t(1) << 30;  // Measure appends, not rotations
+    logger.openStream(config);
+    measure("log() -> stream", logOne);
+    logger.closeStream();
+    std::remove(STREAM_PATH);
+
+    return escapesFields() ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
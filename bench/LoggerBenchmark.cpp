@@ -0,0 +1,106 @@
+/******************************************************************************
+ *  FILE         : LoggerBenchmark.cpp
+ *  DESCRIPTION  : Measures the producer-side cost of Logger::log with several
+ *                 concurrent producer threads, comparing the synchronous
+ *                 (mutex + formatting) path with the asynchronous ring backend.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Utils/Logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using SmartHome::Utils::Logger;
+
+namespace
+{
+    constexpr int PRODUCERS = 8;
+    constexpr int EVENTS_PER_PRODUCER = 20000;
+
+    struct Result
+    {
+        double perProducerNs;   // Mean wall time per event seen by one producer
+        double aggregateNs;     // Whole-run wall time divided by all events
+    };
+
+    /*
+     * Description : Runs PRODUCERS threads that each log EVENTS_PER_PRODUCER
+     *               entries and returns the producer cost in ns/event.
+     */
+    Result runProducers(Logger& logger)
+    {
+        const std::string source = "SecurityMode";
+        const std::string action = "Motion detected - Camera started recording";
+        const std::string target = "LivingRoom";
+
+        std::vector<double> nsPerEvent(PRODUCERS);
+        std::vector<std::thread> producers;
+        std::atomic<int> finished{0};
+
+        const auto runStart = std::chrono::steady_clock::now();
+        for (int p = 0; p < PRODUCERS; ++p)
+        {
+            producers.emplace_back([&, p]()
+            {
+                logger.log(source, "warm-up"); // Claims this thread's ring outside the timed loop
+
+                const auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < EVENTS_PER_PRODUCER; ++i)
+                    logger.log(source, action, target, "OK");
+                const auto end = std::chrono::steady_clock::now();
+
+                nsPerEvent[p] = std::chrono::duration<double, std::nano>(end - start).count()
+                              / EVENTS_PER_PRODUCER;
+
+                // Stay alive until every producer is done so no ring is recycled mid-run
+                finished.fetch_add(1);
+                while (finished.load() < PRODUCERS)
+                    std::this_thread::yield();
+            });
+        }
+        for (auto& t : producers)
+            t.join();
+        const auto runEnd = std::chrono::steady_clock::now();
+
+        double total = 0.0;
+        for (double ns : nsPerEvent)
+            total += ns;
+
+        return { total / PRODUCERS,
+                 std::chrono::duration<double, std::nano>(runEnd - runStart).count()
+                     / (static_cast<double>(PRODUCERS) * EVENTS_PER_PRODUCER) };
+    }
+}
+
+int main()
+{
+    Logger& logger = Logger::getInstance();
+
+    const Result sync = runProducers(logger);
+
+    // Large rings so the measurement reflects the enqueue cost, not drops
+    logger.startAsync(EVENTS_PER_PRODUCER);
+    const Result async = runProducers(logger);
+    logger.stopAsync();
+
+    std::cout << "Logger producer cost (" << PRODUCERS << " threads x "
+              << EVENTS_PER_PRODUCER << " events, "
+              << std::thread::hardware_concurrency() << " hardware threads)\n"
+              << "  synchronous  : " << sync.perProducerNs  << " ns/event per producer, "
+              << sync.aggregateNs << " ns/event aggregate\n"
+              << "  asynchronous : " << async.perProducerNs << " ns/event per producer, "
+              << async.aggregateNs << " ns/event aggregate\n"
+              << "  dropped      : " << logger.droppedCount() << "\n";
+
+    return 0;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,168 @@
+/******************************************************************************
+ *  FILE         : MacroCommandBenchmark.cpp
+ *  DESCRIPTION  : Runs a "good night" macro over a house: every light is
+ *                 turned off, dimmed and turned off again, every door is
+ *                 unlocked then locked, and one group command covers a
+ *                 wing. The macro runs serially and on a ThreadPool, with
+ *                 plain in-memory devices and with a simulated 50 us device
+ *                 round trip per command. Checks that the parallel run and
+ *                 its undo end in the same states as the serial ones.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Commands/SupportedCommands.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+#include "SmartHome/Executors/ThreadPool.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SmartHome::Commands;
+using SmartHome::Core::CommandRecord;
+using SmartHome::Core::ICommand;
+using SmartHome::Devices::DeviceGroup;
+using SmartHome::Devices::DoorLock;
+using SmartHome::Devices::Lights::DimmableLight;
+using SmartHome::Executors::ThreadPool;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr int LIGHTS = 400;
+    constexpr int DOORS = 50;
+    constexpr int WING = 100;      // Lights in the group command
+    constexpr int WORKERS = 8;
+
+    /*
+     * Description : Waits 'latency' before running the command, like a
+     *               device that must acknowledge over the network.
+     */
+    class RemoteCommand : public ICommand
+    {
+    public:
+        RemoteCommand(std::shared_ptr<ICommand> command, std::chrono::microseconds latency)
+            : _command(std::move(command)), _latency(latency) {}
+
+        void execute(void) override { std::this_thread::sleep_for(_latency); _command->execute(); }
+        void undo(void) override { std::this_thread::sleep_for(_latency); _command->undo(); }
+        void describe(std::vector<CommandRecord>& records) const override { _command->describe(records); }
+
+    private:
+        std::shared_ptr<ICommand> _command;
+        std::chrono::microseconds _latency;
+    };
+
+    struct House
+    {
+        std::vector<std::shared_ptr<DimmableLight>> lights;
+        std::vector<std::shared_ptr<DoorLock>> doors;
+        std::shared_ptr<DeviceGroup> wing;
+    };
+
+    House buildHouse(void)
+    {
+        House house;
+        house.wing = std::make_shared<DeviceGroup>("wing");
+        for (int l = 0; l < LIGHTS; ++l)
+        {
+            house.lights.push_back(std::make_shared<DimmableLight>("light-" + std::to_string(l), "bench"));
+            house.lights.back()->setBrightness(60 + l % 40);
+            if (l < WING)
+                house.wing->addDevice(house.lights.back());
+        }
+        for (int d = 0; d < DOORS; ++d)
+            house.doors.push_back(std::make_shared<DoorLock>("door-" + std::to_string(d), "bench"));
+        return house;
+    }
+
+    /*
+     * Description : Fills 'macro'; same-device commands are interleaved with
+     *               others so only the dependency analysis keeps them apart.
+     */
+    void goodNight(MacroCommand& macro, const House& house, std::chrono::microseconds latency)
+    {
+        auto add = [&](std::shared_ptr<ICommand> command)
+        {
+            if (latency.count() > 0)
+                command = std::make_shared<RemoteCommand>(std::move(command), latency);
+            macro.addCommand(std::move(command));
+        };
+
+        for (const auto& light : house.lights)
+            add(std::make_shared<TurnOffCommand>(light));
+        for (const auto& door : house.doors)
+            add(std::make_shared<UnlockCommand>(door));
+        for (const auto& light : house.lights)
+            add(std::make_shared<SetBrightnessCommand>(light, 10));
+        add(std::make_shared<GroupOnCommand>(house.wing));
+        for (const auto& door : house.doors)
+            add(std::make_shared<LockCommand>(door));
+        for (int l = WING; l < LIGHTS; l += 2)
+            add(std::make_shared<TurnOffCommand>(house.lights[l]));
+    }
+
+    std::string stateOf(const House& house)
+    {
+        std::string state;
+        for (const auto& light : house.lights)
+            state += std::to_string(light->getBrightness()) + (light->isOn() ? "+" : "-");
+        for (const auto& door : house.doors)
+            state += door->getStatus();
+        return state;
+    }
+
+    double msSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    ThreadPool pool(WORKERS);
+    std::cout << "Good-night macro: " << LIGHTS << " lights, " << DOORS << " doors, "
+              << pool.size() << " workers\n";
+
+    bool ok = true;
+    for (const auto latency : { std::chrono::microseconds(0), std::chrono::microseconds(50) })
+    {
+        House serialHouse = buildHouse();
+        House parallelHouse = buildHouse();
+
+        MacroCommand serial;
+        MacroCommand parallel(pool);
+        goodNight(serial, serialHouse, latency);
+        goodNight(parallel, parallelHouse, latency);
+
+        auto start = Clock::now();
+        serial.execute();
+        const double serialMs = msSince(start);
+
+        start = Clock::now();
+        parallel.execute();
+        const double parallelMs = msSince(start);
+        const bool same = stateOf(serialHouse) == stateOf(parallelHouse);
+
+        serial.undo();
+        start = Clock::now();
+        parallel.undo();
+        const double undoMs = msSince(start);
+        const bool undone = stateOf(serialHouse) == stateOf(parallelHouse);
+
+        std::cout << "  " << latency.count() << " us per device: serial " << serialMs << " ms, parallel "
+                  << parallelMs << " ms, parallel undo " << undoMs << " ms, state "
+                  << (same ? "matches" : "DIFFERS") << ", undone state " << (undone ? "matches" : "DIFFERS") << "\n";
+        ok = ok && same && undone;
+    }
+
+    return ok ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
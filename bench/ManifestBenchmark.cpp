@@ -0,0 +1,105 @@
+/******************************************************************************
+ *  FILE         : ManifestBenchmark.cpp
+ *  DESCRIPTION  : Writes the manifest of a 100,000-device campus (500
+ *                 floors of 50 rooms, four devices a room, initial state on
+ *                 every device, each device in its room and floor group)
+ *                 once as CSV and once as JSON lines, then loads each and
+ *                 reports devices per second against the 100k/s target.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Persistence/Manifest.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using SmartHome::Persistence::Manifest;
+
+namespace
+{
+    constexpr int FLOORS = 500;
+    constexpr int ROOMS_PER_FLOOR = 50;
+    constexpr double TARGET_PER_SECOND = 100000.0;
+
+    const char* const CSV_PATH = "manifest_bench.csv";
+    const char* const JSON_PATH = "manifest_bench.jsonl";
+
+    void writeCsv(const char* path)
+    {
+        std::ofstream out(path);
+        out << "kind,id,model,type,groups,state\n";
+        for (int f = 0; f < FLOORS; ++f)
+        {
+            const std::string floor = "floor-" + std::to_string(f);
+            out << "group," << floor << ",campus\n";
+            for (int r = 0; r < ROOMS_PER_FLOOR; ++r)
+            {
+                const std::string room = floor + "-room-" + std::to_string(r);
+                out << "group," << room << "," << floor << "\n"
+                    << "device," << room << "-light,LIGHT::DIMMABLE,Ceiling," << room << ",power=on;brightness=" << 20 + r << "\n"
+                    << "device," << room << "-thermostat,THERMOSTAT::HEATER,Wall," << room << ",power=on;mode=heating;target=21\n"
+                    << "device," << room << "-lock,LOCK::DOOR,Front," << room << ",locked=true\n"
+                    << "device," << room << "-camera,CAMERA::WIRELESS,Corner," << room << ";" << floor
+                    << ",power=on;recording=true;nightvision=false\n";
+            }
+        }
+    }
+
+    void writeJson(const char* path)
+    {
+        std::ofstream out(path);
+        for (int f = 0; f < FLOORS; ++f)
+        {
+            const std::string floor = "floor-" + std::to_string(f);
+            out << "{\"group\":\"" << floor << "\",\"parent\":\"campus\"}\n";
+            for (int r = 0; r < ROOMS_PER_FLOOR; ++r)
+            {
+                const std::string room = floor + "-room-" + std::to_string(r);
+                out << "{\"group\":\"" << room << "\",\"parent\":\"" << floor << "\"}\n"
+                    << "{\"device\":\"" << room << "-light\",\"model\":\"LIGHT::DIMMABLE\",\"type\":\"Ceiling\",\"groups\":[\""
+                    << room << "\"],\"state\":{\"power\":true,\"brightness\":" << 20 + r << "}}\n"
+                    << "{\"device\":\"" << room << "-thermostat\",\"model\":\"THERMOSTAT::HEATER\",\"type\":\"Wall\",\"groups\":[\""
+                    << room << "\"],\"state\":{\"power\":true,\"mode\":\"heating\",\"target\":21}}\n"
+                    << "{\"device\":\"" << room << "-lock\",\"model\":\"LOCK::DOOR\",\"type\":\"Front\",\"groups\":[\""
+                    << room << "\"],\"state\":{\"locked\":true}}\n"
+                    << "{\"device\":\"" << room << "-camera\",\"model\":\"CAMERA::WIRELESS\",\"type\":\"Corner\",\"groups\":[\""
+                    << room << "\",\"" << floor << "\"],\"state\":{\"power\":true,\"recording\":true,\"nightvision\":false}}\n";
+            }
+        }
+    }
+
+    bool run(const char* label, const char* path)
+    {
+        const Manifest::Contents contents = Manifest::load(path);
+        const Manifest::Stats& stats = contents.stats;
+        const bool ok = stats.devices == static_cast<std::size_t>(FLOORS * ROOMS_PER_FLOOR * 4)
+                     && stats.devicesPerSecond() >= TARGET_PER_SECOND;
+
+        std::cout << "  " << label << ": " << stats.devices << " devices, " << stats.groups << " groups, "
+                  << stats.memberships << " memberships, " << stats.stateWrites << " state values in "
+                  << stats.seconds * 1000.0 << " ms = " << static_cast<long long>(stats.devicesPerSecond())
+                  << " devices/s" << (ok ? "" : "  BELOW TARGET") << "\n";
+        return ok;
+    }
+}
+
+int main()
+{
+    writeCsv(CSV_PATH);
+    writeJson(JSON_PATH);
+
+    std::cout << "Manifest import, target " << static_cast<long long>(TARGET_PER_SECOND) << " devices/s:\n";
+    bool ok = run("CSV        ", CSV_PATH);
+    ok = run("JSON lines ", JSON_PATH) && ok;
+
+    std::remove(CSV_PATH);
+    std::remove(JSON_PATH);
+    return ok ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,173 @@
+/******************************************************************************
+ *  FILE         : RealTimeSchedulerBenchmark.cpp
+ *  DESCRIPTION  : Measures RealTimeScheduler firing jitter: the delay between
+ *                 a timer's requested deadline and the moment its task
+ *                 starts running. Reports p50 / p99 / max, and checks a
+ *                 timer armed just before 2^32 ticks (~4.97 days) of uptime,
+ *                 a delay beyond INT_MAX ticks and an inline executor whose
+ *                 tasks schedule again.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Controllers/RealTimeScheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using SmartHome::Controller::RealTimeScheduler;
+using SmartHome::Controller::Scheduler;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr int TIMERS = 2000;
+    constexpr int MAX_DELAY_MS = 500;
+
+    /*
+     * Description : Schedules TIMERS timers with random millisecond delays and
+     *               prints the distribution of their firing lateness.
+     */
+    void measure(const char* label, RealTimeScheduler::Executor executor)
+    {
+        RealTimeScheduler scheduler(std::move(executor));
+        scheduler.start();
+
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> delayDist(1, MAX_DELAY_MS);
+
+        std::mutex samplesMutex;
+        std::vector<double> lateUs;
+        lateUs.reserve(TIMERS);
+        std::atomic<int> fired{0};
+
+        for (int i = 0; i < TIMERS; ++i)
+        {
+            const auto delay = std::chrono::milliseconds(delayDist(rng));
+            const auto deadline = Clock::now() + delay;
+
+            scheduler.scheduleAfter(delay, [&, deadline]()
+            {
+                const double late = std::chrono::duration<double, std::micro>(Clock::now() - deadline).count();
+                {
+                    std::lock_guard<std::mutex> lock(samplesMutex);
+                    lateUs.push_back(late);
+                }
+                fired.fetch_add(1);
+            });
+        }
+
+        while (fired.load() < TIMERS)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        scheduler.stop();
+
+        std::sort(lateUs.begin(), lateUs.end());
+        auto percentile = [&lateUs](double p)
+        {
+            return lateUs[static_cast<std::size_t>(p * (lateUs.size() - 1))];
+        };
+
+        std::cout << "  " << label << ": p50 " << percentile(0.50) << " us, p99 "
+                  << percentile(0.99) << " us, max " << lateUs.back() << " us, min "
+                  << lateUs.front() << " us\n";
+    }
+
+    /*
+     * Description : Replays the timer thread's wheel at 100 us per tick: a
+     *               1 s timer armed half a second before the 2^32-tick mark
+     *               must fire 10000 ticks later, not a wheel rotation later.
+     */
+    bool firesAcrossUptimeWrap()
+    {
+        constexpr std::uint64_t WRAP_TICK = std::uint64_t(1) << 32;
+        constexpr int HALF_SECOND = 5000;
+        constexpr int ONE_SECOND = 10000;
+
+        Scheduler wheel;
+        while (wheel.now() < WRAP_TICK - HALF_SECOND)
+            wheel.tick(static_cast<int>(std::min<std::uint64_t>(WRAP_TICK - HALF_SECOND - wheel.now(), 0x7FFFFFFF)));
+
+        std::uint64_t firedAt = 0;
+        wheel.scheduleAfter(ONE_SECOND, [&]() { firedAt = wheel.now(); });
+        while (wheel.pendingCount() != 0 && wheel.now() < WRAP_TICK + 2 * ONE_SECOND)
+            wheel.tick(1);
+
+        const bool ok = firedAt == WRAP_TICK - HALF_SECOND + ONE_SECOND;
+        std::cout << "  uptime wrap: 1 s timer across 2^32 ticks " << (ok ? "fired on time\n" : "FAILED\n");
+        return ok;
+    }
+
+    /*
+     * Description : A 60 hour timer is more than INT_MAX ticks away; armed
+     *               at its absolute tick, it must fire exactly there.
+     */
+    bool firesAfterLongDelay()
+    {
+        constexpr std::uint64_t SIXTY_HOURS = std::uint64_t(60) * 3600 * 10000;
+
+        Scheduler wheel;
+        std::uint64_t firedAt = 0;
+        wheel.scheduleAt(SIXTY_HOURS, [&]() { firedAt = wheel.now(); });
+        while (wheel.pendingCount() != 0 && wheel.now() < 2 * SIXTY_HOURS)
+            wheel.tick(0x7FFFFFFF);
+
+        const bool ok = firedAt == SIXTY_HOURS;
+        std::cout << "  long delay: 60 h timer " << (ok ? "fired on time\n" : "FAILED\n");
+        return ok;
+    }
+
+    /*
+     * Description : An executor that runs tasks inline on the timer thread
+     *               must be able to schedule and cancel from those tasks.
+     *               On failure the scheduler is leaked, not joined.
+     */
+    bool inlineTasksMaySchedule()
+    {
+        auto* scheduler = new RealTimeScheduler([](RealTimeScheduler::ScheduledTask task) { task(); });
+        scheduler->start();
+
+        std::atomic<bool> fired{false};
+        scheduler->scheduleAfter(std::chrono::milliseconds(1), [&]()
+        {
+            const auto spare = scheduler->scheduleAfter(std::chrono::seconds(10), [] {});
+            scheduler->cancel(spare);
+            scheduler->scheduleAfter(std::chrono::milliseconds(1), [&]() { fired = true; });
+        });
+
+        const auto giveUp = Clock::now() + std::chrono::seconds(2);
+        while (!fired && Clock::now() < giveUp)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        const bool ok = fired;
+        if (ok)
+            delete scheduler;
+        std::cout << "  inline executor: nested schedule/cancel " << (ok ? "ran\n" : "FAILED (deadlock)\n");
+        return ok;
+    }
+}
+
+int main()
+{
+    std::cout << "RealTimeScheduler firing jitter (" << TIMERS << " timers, 1.."
+              << MAX_DELAY_MS << " ms)\n";
+
+    measure("timer thread   ", [](RealTimeScheduler::ScheduledTask task) { task(); });
+    measure("dispatch thread", nullptr);
+
+    bool ok = firesAcrossUptimeWrap();
+    ok = firesAfterLongDelay() && ok;
+    ok = inlineTasksMaySchedule() && ok;
+
+    return ok ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,222 @@
+/******************************************************************************
+ *  FILE         : RuleEngineBenchmark.cpp
+ *  DESCRIPTION  : Compiles 100, 1k and 10k "motion and unlocked -> record"
+ *                 rules over as many rooms, then feeds motion and lock
+ *                 events straight to the RuleEngine and reports compile time
+ *                 and ns per event. With the inverted index the per-event
+ *                 cost should not grow with the number of rules. Also
+ *                 checks that absurdly nested conditions are rejected,
+ *                 that refresh() picks up a group's new members and that
+ *                 on/off actions on a group act on its compiled members.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Automation/RuleEngine.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace SmartHome::Devices;
+using SmartHome::Automation::RuleEngine;
+using SmartHome::Core::DeviceEvent;
+using SmartHome::Core::EventType;
+using SmartHome::Core::IDevice;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr int EVENTS = 1000000;
+
+    void measure(int rooms)
+    {
+        std::unordered_map<std::string, std::shared_ptr<IDevice>> devices;
+        std::vector<const IDevice*> sensors;
+        std::vector<const IDevice*> locks;
+        std::string source = "# generated\n";
+
+        for (int r = 0; r < rooms; ++r)
+        {
+            const std::string n = std::to_string(r);
+            auto sensor = std::make_shared<Sensors::MotionSensor>("motion-" + n);
+            auto lock = std::make_shared<DoorLock>("lock-" + n, "Lock");
+            auto camera = std::make_shared<Cameras::BaseCamera>("cam-" + n, "Cam");
+            sensors.push_back(sensor.get());
+            locks.push_back(lock.get());
+            devices.emplace(sensor->getID(), sensor);
+            devices.emplace(lock->getID(), lock);
+            devices.emplace(camera->getID(), camera);
+
+            source += "rule room-" + n + ": when motion(motion-" + n + ") and unlocked(lock-" + n
+                    + ") then record(cam-" + n + ")\n";
+        }
+
+        RuleEngine engine;
+        const auto compileStart = Clock::now();
+        engine.load(source, [&devices](std::string_view id) -> std::shared_ptr<IDevice>
+        {
+            auto it = devices.find(std::string(id));
+            return it != devices.end() ? it->second : nullptr;
+        });
+        const double compileMs = std::chrono::duration<double, std::milli>(Clock::now() - compileStart).count();
+
+        // Alternate motion and lock changes on random rooms
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<int> room(0, rooms - 1);
+        std::vector<bool> motion(rooms, false);
+        std::vector<bool> locked(rooms, true);
+
+        const auto start = Clock::now();
+        for (int i = 0; i < EVENTS; ++i)
+        {
+            const int r = room(rng);
+            if (i % 2 == 0)
+            {
+                motion[r] = !motion[r];
+                engine.onEvent(DeviceEvent{ EventType::MOTION, motion[r], 0.0f, sensors[r], 0 });
+            }
+            else
+            {
+                locked[r] = !locked[r];
+                engine.onEvent(DeviceEvent{ EventType::LOCK, locked[r], 0.0f, locks[r], 0 });
+            }
+        }
+        const double eventNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / EVENTS;
+
+        std::cout << "  " << rooms << " rules: compile " << compileMs << " ms, "
+                  << eventNs << " ns/event, " << engine.firedCount() << " firings\n";
+        engine.clear();
+    }
+
+    /*
+     * Description : A condition nested 100k deep must fail to compile with
+     *               an error instead of overflowing the parser's stack.
+     */
+    bool rejectsDeepNesting()
+    {
+        auto sensor = std::make_shared<Sensors::MotionSensor>("m");
+        auto camera = std::make_shared<Cameras::BaseCamera>("c", "Cam");
+        auto resolve = [&](std::string_view id) -> std::shared_ptr<IDevice>
+        {
+            return id == "m" ? std::shared_ptr<IDevice>(sensor) : id == "c" ? std::shared_ptr<IDevice>(camera) : nullptr;
+        };
+
+        constexpr std::size_t DEPTH = 100000;
+        bool ok = true;
+        for (const std::string& open : { std::string("("), std::string("not ") })
+        {
+            std::string condition;
+            for (std::size_t i = 0; i < DEPTH; ++i)
+                condition += open;
+            condition += "motion(m)";
+            if (open == "(")
+                condition += std::string(DEPTH, ')');
+
+            RuleEngine engine;
+            try
+            {
+                engine.load("rule deep: when " + condition + " then record(c)\n", resolve);
+                ok = false;
+            }
+            catch (const std::invalid_argument&)
+            {
+            }
+        }
+
+        std::cout << "  deep nesting: " << (ok ? "rejected\n" : "ACCEPTED\n");
+        return ok;
+    }
+
+    /*
+     * Description : A rule on a group fires for a member added after
+     *               loading only once refresh() has recompiled it.
+     */
+    bool refreshesGroups()
+    {
+        auto group = std::make_shared<DeviceGroup>("hall");
+        auto first = std::make_shared<Sensors::MotionSensor>("m1");
+        auto second = std::make_shared<Sensors::MotionSensor>("m2");
+        auto camera = std::make_shared<Cameras::BaseCamera>("c", "Cam");
+        group->addDevice(first);
+
+        RuleEngine engine;
+        engine.load("rule hall: when motion(hall) then record(c)\n", [&](std::string_view id) -> std::shared_ptr<IDevice>
+        {
+            return id == "hall" ? std::shared_ptr<IDevice>(group) : id == "c" ? std::shared_ptr<IDevice>(camera) : nullptr;
+        });
+
+        const bool unchanged = !engine.refresh();
+        group->addDevice(second);
+        engine.onEvent(DeviceEvent{ EventType::MOTION, true, 0.0f, second.get(), 0 });
+        const bool ignoredBefore = engine.firedCount() == 0;
+
+        const bool refreshed = engine.refresh();
+        engine.onEvent(DeviceEvent{ EventType::MOTION, true, 0.0f, second.get(), 0 });
+        const bool ok = unchanged && ignoredBefore && refreshed && engine.firedCount() == 1;
+
+        std::cout << "  group refresh: " << (ok ? "new member picked up\n" : "FAILED\n");
+        return ok;
+    }
+
+    /*
+     *  Description : on(group) must act on the members seen at compile time,
+     *                never on the live group, and a group whose ID now names
+     *                another group must recompile.
+     */
+    bool expandsGroupActions()
+    {
+        auto group = std::make_shared<DeviceGroup>("lights");
+        auto replacement = std::make_shared<DeviceGroup>("lights");
+        auto sensor = std::make_shared<Sensors::MotionSensor>("m");
+        auto first = std::make_shared<Lights::BaseLight>("l1", "Lamp");
+        auto second = std::make_shared<Lights::BaseLight>("l2", "Lamp");
+        group->addDevice(first);
+        replacement->addDevice(first);
+
+        std::shared_ptr<DeviceGroup> current = group;
+        RuleEngine engine;
+        engine.load("rule lamps: when motion(m) then on(lights)\n", [&](std::string_view id) -> std::shared_ptr<IDevice>
+        {
+            return id == "lights" ? std::shared_ptr<IDevice>(current) : id == "m" ? std::shared_ptr<IDevice>(sensor) : nullptr;
+        });
+
+        group->addDevice(second);
+        engine.onEvent(DeviceEvent{ EventType::MOTION, true, 0.0f, sensor.get(), 0 });
+        const bool expanded = first->isOn() && !second->isOn();
+
+        engine.refresh();
+        const bool unchanged = !engine.refresh();
+        current = replacement;
+        const bool replaced = engine.refresh();
+
+        const bool ok = expanded && unchanged && replaced;
+        std::cout << "  group actions: " << (ok ? "expanded at compile time\n" : "FAILED\n");
+        return ok;
+    }
+}
+
+int main()
+{
+    std::cout << "RuleEngine (" << EVENTS << " events per run)\n";
+
+    measure(100);
+    measure(1000);
+    measure(10000);
+
+    bool ok = rejectsDeepNesting();
+    ok = refreshesGroups() && ok;
+    ok = expandsGroupActions() && ok;
+
+    return ok ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
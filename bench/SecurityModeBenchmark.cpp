@@ -0,0 +1,151 @@
+/******************************************************************************
+ *  FILE         : SecurityModeBenchmark.cpp
+ *  DESCRIPTION  : Arms SecurityMode over 10k rooms, then measures the cost of
+ *                 re-activating with unchanged groups and of applying single
+ *                 sensor changes against re-activating after every change.
+ *                 Also checks that facts are re-read after the event bus
+ *                 drops events.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Automation/SecurityMode.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+#include "SmartHome/Events/EventBus.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace SmartHome::Devices;
+using SmartHome::Automation::SecurityMode;
+using SmartHome::Controller::Scheduler;
+using SmartHome::Core::DeviceEvent;
+using SmartHome::Core::EventType;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr int GROUPS = 10000;
+    constexpr int ROUNDS = 20;
+    constexpr int EVENTS = 1000000;
+
+    double nsSince(Clock::time_point start, double per)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / per;
+    }
+
+    std::size_t recordingCount(const std::vector<std::shared_ptr<Cameras::BaseCamera>>& cameras)
+    {
+        std::size_t recording = 0;
+        for (const auto& camera : cameras)
+            recording += camera->isRecording();
+        return recording;
+    }
+
+    /*
+     * Description : With the bus not dispatching, flips a sensor until the
+     *               queue overflows and ends with motion. The mode never saw
+     *               that event, so a repeated activate() with the same
+     *               groups must re-read the sensor and start the camera.
+     */
+    bool reseedsAfterDrops()
+    {
+        auto group = std::make_shared<DeviceGroup>("drops");
+        auto camera = std::make_shared<Cameras::BaseCamera>("drops-camera", "Cam");
+        auto sensor = std::make_shared<Sensors::MotionSensor>("drops-motion");
+        group->addDevice(camera);
+        group->addDevice(sensor);
+
+        Scheduler scheduler;
+        SecurityMode security(scheduler);
+        security.activate({ group });
+
+        auto& bus = SmartHome::Events::EventBus::getInstance();
+        const auto dropped = bus.droppedCount();
+        while (bus.droppedCount() == dropped)
+        {
+            sensor->setMotionDetected(true);
+            sensor->setMotionDetected(false);
+        }
+        sensor->setMotionDetected(true);
+
+        const bool missed = !camera->isRecording();
+        security.activate({ group });
+        const bool ok = missed && camera->isRecording();
+
+        security.deactivate();
+        std::cout << "  dropped events      : " << (ok ? "facts re-read on activate\n" : "FAILED\n");
+        return ok;
+    }
+}
+
+int main()
+{
+    std::vector<std::shared_ptr<DeviceGroup>> groups;
+    std::vector<std::shared_ptr<Cameras::BaseCamera>> cameras;
+    std::vector<std::shared_ptr<Sensors::MotionSensor>> sensors;
+    for (int g = 0; g < GROUPS; ++g)
+    {
+        const std::string prefix = "room-" + std::to_string(g) + "-";
+        auto group = std::make_shared<DeviceGroup>(prefix + "group");
+        auto camera = std::make_shared<Cameras::BaseCamera>(prefix + "camera", "Cam");
+        auto sensor = std::make_shared<Sensors::MotionSensor>(prefix + "motion");
+        group->addDevice(std::make_shared<Lights::BaseLight>(prefix + "ceiling", "Bulb"));
+        group->addDevice(camera);
+        group->addDevice(sensor);
+        group->addDevice(std::make_shared<DoorLock>(prefix + "lock", "Lock"));
+        groups.push_back(group);
+        cameras.push_back(camera);
+        sensors.push_back(sensor);
+    }
+
+    Scheduler scheduler;
+    SecurityMode security(scheduler);
+
+    std::cout << "SecurityMode over " << GROUPS << " rooms\n";
+
+    auto start = Clock::now();
+    security.activate(groups);
+    std::cout << "  first activate      : " << nsSince(start, GROUPS) << " ns/group\n";
+
+    start = Clock::now();
+    for (int r = 0; r < ROUNDS; ++r)
+        security.activate(groups);
+    std::cout << "  repeated activate   : " << nsSince(start, static_cast<double>(ROUNDS) * GROUPS)
+              << " ns/group (unchanged groups)\n";
+
+    // Motion starts in every room once: one recording command per room
+    for (const auto& sensor : sensors)
+        security.onEvent(DeviceEvent{ EventType::MOTION, true, 0.0f, sensor.get(), 0 });
+    std::cout << "  cameras recording   : " << recordingCount(cameras) << " / " << GROUPS << "\n";
+
+    // Chattering sensors in rooms already recording: facts move, no commands
+    start = Clock::now();
+    for (int i = 0; i < EVENTS; ++i)
+    {
+        const auto* sensor = sensors[static_cast<std::size_t>(i) % GROUPS].get();
+        security.onEvent(DeviceEvent{ EventType::MOTION, (i / GROUPS) % 2 == 1, 0.0f, sensor, 0 });
+    }
+    std::cout << "  sensor change       : " << nsSince(start, EVENTS) << " ns/event\n";
+
+    // Same change applied the old way: re-activate and rescan every room
+    start = Clock::now();
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        sensors[static_cast<std::size_t>(r)]->setMotionDetected(r % 2 == 0);
+        groups[static_cast<std::size_t>(r)]->addDevice(
+            std::make_shared<Lights::BaseLight>("extra-" + std::to_string(r), "Bulb"));   // Forces a rescan
+        security.activate(groups);
+    }
+    std::cout << "  rescan per change   : " << nsSince(start, ROUNDS) << " ns/change\n";
+
+    security.deactivate();
+    return reseedsAfterDrops() ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
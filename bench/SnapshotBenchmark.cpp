@@ -0,0 +1,485 @@
+/******************************************************************************
+ *  FILE         : SnapshotBenchmark.cpp
+ *  DESCRIPTION  : Saves and restores 100k mixed devices in 1000 groups
+ *                 through the binary Snapshot and through a hand-written
+ *                 JSON writer and parser carrying the same fields, and
+ *                 reports save time, restore time and file size for each.
+ *                 The restored snapshot is checked device by device.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Persistence/Snapshot.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace SmartHome::Devices;
+using SmartHome::Core::IDevice;
+using SmartHome::Persistence::Snapshot;
+using Thermostats::BaseThermostat;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr int DEVICES = 100000;
+    constexpr int GROUPS = 1000;
+    constexpr int ROUNDS = 5;
+
+    const char* const SNAPSHOT_PATH = "snapshot_bench.snap";
+    const char* const JSON_PATH = "snapshot_bench.json";
+
+    /*
+     * Description : Everything the JSON baseline stores about one device.
+     */
+    struct DeviceState
+    {
+        std::string kind;
+        std::string id;
+        std::string type;
+        bool on = false;
+        int brightness = 0;
+        bool recording = false;
+        bool nightVision = false;
+        bool charging = false;
+        int battery = 0;
+        float target = 0;
+        float current = 0;
+        int mode = 0;
+        bool locked = false;
+        std::vector<std::string> cards;
+        std::vector<std::string> phones;
+    };
+
+    struct GroupState
+    {
+        std::string name;
+        std::vector<std::string> members;
+    };
+
+    double msSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    std::size_t fileSize(const char* path)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        return static_cast<std::size_t>(in.tellg());
+    }
+
+    std::vector<DeviceState> generateDevices()
+    {
+        static const char* const KINDS[] = { "dimmable_light", "dimmable_light", "dimmable_light", "dimmable_light",
+                                             "camera", "wireless_camera", "cooler", "heater",
+                                             "door_lock", "motion_sensor" };
+        std::vector<DeviceState> states(DEVICES);
+        for (int i = 0; i < DEVICES; ++i)
+        {
+            DeviceState& s = states[i];
+            s.kind = KINDS[i % 10];
+            s.id = s.kind + "-" + std::to_string(i);
+            s.type = (s.kind == "motion_sensor") ? "" : "model-" + std::to_string(i % 7);
+            s.on = (i % 3) != 0;
+            s.brightness = s.on ? 10 + i % 90 : 0;
+            s.recording = (i % 4) == 0;
+            s.nightVision = (i % 5) == 0;
+            s.charging = (i % 2) == 0;
+            s.battery = i % 101;
+            s.mode = (s.kind == "cooler") ? static_cast<int>(BaseThermostat::ThermostatMode::COOLING)
+                                          : static_cast<int>(BaseThermostat::ThermostatMode::HEATING);
+            s.target = 18.0f + static_cast<float>(i % 10);
+            s.current = 15.5f + static_cast<float>(i % 20) * 0.5f;
+            s.locked = (i % 6) != 0;
+            if (s.kind == "door_lock")
+            {
+                s.cards = { "card-" + std::to_string(i), "card-" + std::to_string(i + 1) };
+                s.phones = { "phone-" + std::to_string(i) };
+            }
+        }
+        return states;
+    }
+
+    /*
+     * Description : Builds a device from its state through the public API,
+     *               as a JSON loader without friend access has to.
+     */
+    std::shared_ptr<IDevice> build(const DeviceState& s)
+    {
+        if (s.kind == "dimmable_light")
+        {
+            auto light = std::make_shared<Lights::DimmableLight>(s.id, s.type);
+            light->setBrightness(s.on ? s.brightness : 0);
+            return light;
+        }
+        if (s.kind == "camera" || s.kind == "wireless_camera")
+        {
+            std::shared_ptr<Cameras::BaseCamera> camera;
+            if (s.kind == "wireless_camera")
+                camera = std::make_shared<Cameras::WirelessCamera>(s.id, s.type, s.battery, s.charging);
+            else
+                camera = std::make_shared<Cameras::BaseCamera>(s.id, s.type);
+            if (s.on) camera->turnOn();
+            if (s.recording) camera->startRecording();
+            if (s.nightVision) camera->enableNightVision();
+            return camera;
+        }
+        if (s.kind == "cooler" || s.kind == "heater")
+        {
+            std::shared_ptr<BaseThermostat> thermostat;
+            if (s.kind == "cooler")
+                thermostat = std::make_shared<Thermostats::CoolerThermostat>(s.id, s.type);
+            else
+                thermostat = std::make_shared<Thermostats::HeaterThermostat>(s.id, s.type);
+            thermostat->setMode(static_cast<BaseThermostat::ThermostatMode>(s.mode));
+            thermostat->setTargetTemperature(s.target);
+            thermostat->setCurrentTemperature(s.current);
+            if (!s.on) thermostat->turnOff();
+            return thermostat;
+        }
+        if (s.kind == "door_lock")
+        {
+            auto lock = std::make_shared<DoorLock>(s.id, s.type);
+            if (s.on) lock->turnOn();
+            if (!s.locked) lock->unlockDoor();
+            for (const auto& card : s.cards) lock->addCard(card);
+            for (const auto& phone : s.phones) lock->addPhoneToken(phone);
+            return lock;
+        }
+        auto sensor = std::make_shared<Sensors::MotionSensor>(s.id);
+        if (s.on) sensor->turnOn();
+        sensor->setMotionDetected(s.on && (s.brightness % 2) == 0);
+        return sensor;
+    }
+
+    // ---------------------------------------------------------------------------
+    // JSON baseline
+    // ---------------------------------------------------------------------------
+    void writeString(std::string& out, const std::string& text)
+    {
+        out += '"';
+        out += text;    // Generated IDs need no escaping
+        out += '"';
+    }
+
+    void writeJson(const char* path, const std::vector<DeviceState>& devices, const std::vector<GroupState>& groups)
+    {
+        std::string out;
+        out.reserve(devices.size() * 300);
+        out += "{\"devices\":[";
+        for (std::size_t i = 0; i < devices.size(); ++i)
+        {
+            const DeviceState& s = devices[i];
+            out += i ? ",{" : "{";
+            out += "\"kind\":"; writeString(out, s.kind);
+            out += ",\"id\":"; writeString(out, s.id);
+            out += ",\"type\":"; writeString(out, s.type);
+            out += ",\"on\":"; out += s.on ? "true" : "false";
+            out += ",\"brightness\":"; out += std::to_string(s.brightness);
+            out += ",\"recording\":"; out += s.recording ? "true" : "false";
+            out += ",\"nightVision\":"; out += s.nightVision ? "true" : "false";
+            out += ",\"charging\":"; out += s.charging ? "true" : "false";
+            out += ",\"battery\":"; out += std::to_string(s.battery);
+            out += ",\"target\":"; out += std::to_string(s.target);
+            out += ",\"current\":"; out += std::to_string(s.current);
+            out += ",\"mode\":"; out += std::to_string(s.mode);
+            out += ",\"locked\":"; out += s.locked ? "true" : "false";
+            out += ",\"cards\":[";
+            for (std::size_t c = 0; c < s.cards.size(); ++c) { if (c) out += ','; writeString(out, s.cards[c]); }
+            out += "],\"phones\":[";
+            for (std::size_t p = 0; p < s.phones.size(); ++p) { if (p) out += ','; writeString(out, s.phones[p]); }
+            out += "]}";
+        }
+        out += "],\"groups\":[";
+        for (std::size_t g = 0; g < groups.size(); ++g)
+        {
+            out += g ? ",{\"name\":" : "{\"name\":";
+            writeString(out, groups[g].name);
+            out += ",\"members\":[";
+            for (std::size_t m = 0; m < groups[g].members.size(); ++m)
+            {
+                if (m) out += ',';
+                writeString(out, groups[g].members[m]);
+            }
+            out += "]}";
+        }
+        out += "]}";
+
+        std::ofstream(path, std::ios::binary).write(out.data(), static_cast<std::streamsize>(out.size()));
+    }
+
+    /*
+     * Description : A small recursive-descent reader for the document above:
+     *               objects, arrays, strings, numbers and booleans.
+     */
+    class JsonReader
+    {
+    public:
+        explicit JsonReader(const std::string& text) : _p(text.c_str()) {}
+
+        void expect(char c)
+        {
+            skipSpace();
+            if (*_p != c)
+                throw std::runtime_error(std::string("json: expected ") + c);
+            ++_p;
+        }
+
+        bool consume(char c)
+        {
+            skipSpace();
+            if (*_p != c)
+                return false;
+            ++_p;
+            return true;
+        }
+
+        std::string string()
+        {
+            expect('"');
+            const char* start = _p;
+            while (*_p && *_p != '"')
+                _p += (*_p == '\\') ? 2 : 1;
+            std::string value(start, _p);
+            expect('"');
+            return value;
+        }
+
+        double number()
+        {
+            skipSpace();
+            char* end;
+            const double value = std::strtod(_p, &end);
+            _p = end;
+            return value;
+        }
+
+        bool boolean()
+        {
+            skipSpace();
+            const bool value = (*_p == 't');
+            _p += value ? 4 : 5;
+            return value;
+        }
+
+        std::vector<std::string> strings()
+        {
+            std::vector<std::string> values;
+            expect('[');
+            if (!consume(']'))
+            {
+                do { values.push_back(string()); } while (consume(','));
+                expect(']');
+            }
+            return values;
+        }
+
+        /*
+         * Description : Calls 'field(key)' for every key of an object; the
+         *               callback reads the value.
+         */
+        template <typename Field>
+        void object(Field&& field)
+        {
+            expect('{');
+            if (consume('}'))
+                return;
+            do
+            {
+                const std::string key = string();
+                expect(':');
+                field(key);
+            } while (consume(','));
+            expect('}');
+        }
+
+        template <typename Element>
+        void array(Element&& element)
+        {
+            expect('[');
+            if (consume(']'))
+                return;
+            do { element(); } while (consume(','));
+            expect(']');
+        }
+
+    private:
+        void skipSpace()
+        {
+            while (*_p == ' ' || *_p == '\n' || *_p == '\t' || *_p == '\r')
+                ++_p;
+        }
+
+        const char* _p;
+    };
+
+    Snapshot::Contents readJson(const char* path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        const std::string text = buffer.str();
+
+        Snapshot::Contents contents;
+        std::unordered_map<std::string, std::shared_ptr<IDevice>> byId;
+        JsonReader reader(text);
+
+        reader.object([&](const std::string& section)
+        {
+            if (section == "devices")
+            {
+                reader.array([&]()
+                {
+                    DeviceState s;
+                    reader.object([&](const std::string& key)
+                    {
+                        if (key == "kind") s.kind = reader.string();
+                        else if (key == "id") s.id = reader.string();
+                        else if (key == "type") s.type = reader.string();
+                        else if (key == "on") s.on = reader.boolean();
+                        else if (key == "brightness") s.brightness = static_cast<int>(reader.number());
+                        else if (key == "recording") s.recording = reader.boolean();
+                        else if (key == "nightVision") s.nightVision = reader.boolean();
+                        else if (key == "charging") s.charging = reader.boolean();
+                        else if (key == "battery") s.battery = static_cast<int>(reader.number());
+                        else if (key == "target") s.target = static_cast<float>(reader.number());
+                        else if (key == "current") s.current = static_cast<float>(reader.number());
+                        else if (key == "mode") s.mode = static_cast<int>(reader.number());
+                        else if (key == "locked") s.locked = reader.boolean();
+                        else if (key == "cards") s.cards = reader.strings();
+                        else if (key == "phones") s.phones = reader.strings();
+                        else throw std::runtime_error("json: unknown key " + key);
+                    });
+                    auto device = build(s);
+                    byId.emplace(s.id, device);
+                    contents.devices.push_back(std::move(device));
+                });
+            }
+            else
+            {
+                reader.array([&]()
+                {
+                    std::shared_ptr<DeviceGroup> group;
+                    reader.object([&](const std::string& key)
+                    {
+                        if (key == "name")
+                            group = std::make_shared<DeviceGroup>(reader.string());
+                        else
+                            for (const std::string& id : reader.strings())
+                                group->addDevice(byId.at(id));
+                    });
+                    contents.groups.push_back(std::move(group));
+                });
+            }
+        });
+        return contents;
+    }
+
+    /*
+     * Description : True if both sides hold the same devices in the same
+     *               state and groups of the same size.
+     */
+    bool sameState(const std::vector<std::shared_ptr<IDevice>>& expected,
+                   const std::vector<std::shared_ptr<DeviceGroup>>& expectedGroups,
+                   const Snapshot::Contents& actual)
+    {
+        if (expected.size() != actual.devices.size() || expectedGroups.size() != actual.groups.size())
+            return false;
+
+        std::unordered_map<std::string, std::string> status;
+        for (const auto& device : actual.devices)
+            status.emplace(device->getID(), device->getStatus());
+        for (const auto& device : expected)
+        {
+            auto it = status.find(device->getID());
+            if (it == status.end() || it->second != device->getStatus())
+                return false;
+        }
+
+        std::unordered_map<std::string, std::size_t> sizes;
+        for (const auto& group : actual.groups)
+            sizes.emplace(group->getID(), group->getDevices().size());
+        for (const auto& group : expectedGroups)
+            if (sizes[group->getID()] != group->getDevices().size())
+                return false;
+        return true;
+    }
+}
+
+int main()
+{
+    const std::vector<DeviceState> states = generateDevices();
+
+    std::vector<std::shared_ptr<IDevice>> devices;
+    devices.reserve(states.size());
+    for (const DeviceState& s : states)
+        devices.push_back(build(s));
+
+    std::vector<GroupState> groupStates(GROUPS);
+    std::vector<std::shared_ptr<DeviceGroup>> groups;
+    for (int g = 0; g < GROUPS; ++g)
+    {
+        groupStates[g].name = "room-" + std::to_string(g);
+        groups.push_back(std::make_shared<DeviceGroup>(groupStates[g].name));
+    }
+    for (int i = 0; i < DEVICES; ++i)
+    {
+        groupStates[i % GROUPS].members.push_back(states[i].id);
+        groups[i % GROUPS]->addDevice(devices[i]);
+    }
+
+    std::cout << "Snapshot vs JSON: " << DEVICES << " devices in " << GROUPS
+              << " groups, best of " << ROUNDS << "\n";
+
+    double snapSave = 1e300, snapLoad = 1e300, jsonSave = 1e300, jsonLoad = 1e300;
+    bool verified = true;
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        auto start = Clock::now();
+        Snapshot::save(SNAPSHOT_PATH, devices, groups);
+        snapSave = std::min(snapSave, msSince(start));
+
+        start = Clock::now();
+        {
+            const Snapshot::Contents restored = Snapshot::load(SNAPSHOT_PATH);
+            snapLoad = std::min(snapLoad, msSince(start));
+            if (round == 0)
+                verified = sameState(devices, groups, restored);
+        }
+
+        start = Clock::now();
+        writeJson(JSON_PATH, states, groupStates);
+        jsonSave = std::min(jsonSave, msSince(start));
+
+        start = Clock::now();
+        {
+            const Snapshot::Contents restored = readJson(JSON_PATH);
+            jsonLoad = std::min(jsonLoad, msSince(start));
+        }
+    }
+
+    std::cout << "  snapshot: save " << snapSave << " ms, load " << snapLoad << " ms, "
+              << fileSize(SNAPSHOT_PATH) / 1024 << " KiB\n"
+              << "  json    : save " << jsonSave << " ms, load " << jsonLoad << " ms, "
+              << fileSize(JSON_PATH) / 1024 << " KiB\n"
+              << "  restored state " << (verified ? "matches" : "DIFFERS") << "\n";
+
+    std::remove(SNAPSHOT_PATH);
+    std::remove(JSON_PATH);
+    return verified ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,283 @@
+/******************************************************************************
+ *  FILE         : TransactionalMacroBenchmark.cpp
+ *  DESCRIPTION  : Runs a 10,000-command scene over 5,000 devices whose last
+ *                 command fails, as a plain MacroCommand and as a
+ *                 transactional one (serial and on a ThreadPool). Reports
+ *                 the cost of staging pre-images on success, the cost of a
+ *                 rollback, heap allocations of a warm run, and how many
+ *                 devices are left changed after the failure. Also checks
+ *                 that a rolled back thermostat turns on in its old mode.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Commands/SupportedCommands.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+#include "SmartHome/Executors/ThreadPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace SmartHome::Commands;
+using SmartHome::Core::ICommand;
+using SmartHome::Core::IDevice;
+using SmartHome::Devices::DoorLock;
+using SmartHome::Devices::Cameras::WirelessCamera;
+using SmartHome::Devices::Lights::DimmableLight;
+using SmartHome::Devices::Thermostats::BaseThermostat;
+using SmartHome::Devices::Thermostats::HeaterThermostat;
+using SmartHome::Executors::ThreadPool;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    std::atomic<long long> g_allocations{0};
+}
+
+// Count every call into the global allocator
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(size ? size : 1))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace
+{
+    constexpr int ROOMS = 1250;     // 4 devices each
+
+    /*
+     * Description : Targets a device, then fails like a device that stopped
+     *               answering halfway through a scene.
+     */
+    class FailingCommand : public ICommand
+    {
+    public:
+        explicit FailingCommand(std::shared_ptr<DimmableLight> light) : _light(std::move(light)) {}
+
+        void execute(void) override
+        {
+            _light->setBrightness(1);
+            throw std::runtime_error("device timeout");
+        }
+        void undo(void) override {}
+        void describe(std::vector<SmartHome::Core::CommandRecord>& records) const override
+        {
+            records.push_back({ SmartHome::Core::CommandCode::BRIGHTNESS, _light.get(), 0.0f, 1.0f });
+        }
+
+    private:
+        std::shared_ptr<DimmableLight> _light;
+    };
+
+    struct House
+    {
+        std::vector<std::shared_ptr<DimmableLight>> lights;
+        std::vector<std::shared_ptr<HeaterThermostat>> thermostats;
+        std::vector<std::shared_ptr<DoorLock>> locks;
+        std::vector<std::shared_ptr<WirelessCamera>> cameras;
+    };
+
+    House buildHouse(void)
+    {
+        House house;
+        for (int r = 0; r < ROOMS; ++r)
+        {
+            const std::string room = "room-" + std::to_string(r);
+            house.lights.push_back(std::make_shared<DimmableLight>(room + "-light", "bench"));
+            house.lights.back()->setBrightness(30 + r % 60);
+            house.thermostats.push_back(std::make_shared<HeaterThermostat>(room + "-thermostat", "bench"));
+            house.locks.push_back(std::make_shared<DoorLock>(room + "-lock", "bench"));
+            house.cameras.push_back(std::make_shared<WirelessCamera>(room + "-camera", "bench", 100, true));
+        }
+        return house;
+    }
+
+    /*
+     * Description : Two commands per device, then the failing one.
+     */
+    void fillScene(MacroCommand& macro, const House& house, bool fail)
+    {
+        for (int r = 0; r < ROOMS; ++r)
+        {
+            macro.addCommand(std::make_shared<SetBrightnessCommand>(house.lights[r], 5));
+            macro.addCommand(std::make_shared<TurnOffCommand>(house.lights[r]));
+            macro.addCommand(std::make_shared<SetTargetTemperatureCommand>(house.thermostats[r], 17));
+            macro.addCommand(std::make_shared<SetThermostatModeCommand>(house.thermostats[r], BaseThermostat::ThermostatMode::HEATING));
+            macro.addCommand(std::make_shared<LockCommand>(house.locks[r]));
+            macro.addCommand(std::make_shared<UnlockCommand>(house.locks[r]));
+            macro.addCommand(std::make_shared<StartRecordingCommand>(house.cameras[r]));
+            macro.addCommand(std::make_shared<EnableNightVisionCommand>(house.cameras[r]));
+        }
+        if (fail)
+            macro.addCommand(std::make_shared<FailingCommand>(house.lights[ROOMS / 2]));
+    }
+
+    std::vector<std::string> stateOf(const House& house)
+    {
+        std::vector<std::string> state;
+        for (int r = 0; r < ROOMS; ++r)
+        {
+            state.push_back(house.lights[r]->getStatus() + std::to_string(house.lights[r]->getBrightness()));
+            state.push_back(house.thermostats[r]->getStatus());
+            state.push_back(house.locks[r]->getStatus());
+            state.push_back(house.cameras[r]->getStatus() + (house.cameras[r]->isRecording() ? "R" : "")
+                            + (house.cameras[r]->isNightVisionEnabled() ? "N" : ""));
+        }
+        return state;
+    }
+
+    std::size_t changedDevices(const std::vector<std::string>& before, const House& house)
+    {
+        const std::vector<std::string> after = stateOf(house);
+        std::size_t changed = 0;
+        for (std::size_t i = 0; i < before.size(); ++i)
+            changed += (before[i] != after[i]) ? 1 : 0;
+        return changed;
+    }
+
+    struct Run
+    {
+        double ms;
+        long long allocations;
+        bool threw;
+    };
+
+    /*
+     * Description : Executes 'macro' twice from the same starting state and
+     *               reports the second (warm) run.
+     */
+    Run runWarm(MacroCommand& macro, House& house)
+    {
+        Run run{};
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (auto& light : house.lights)
+                light->setBrightness(50);
+
+            const long long before = g_allocations.load();
+            const auto start = Clock::now();
+            try
+            {
+                macro.execute();
+                run.threw = false;
+            }
+            catch (const std::runtime_error&)
+            {
+                run.threw = true;
+            }
+            run.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            run.allocations = g_allocations.load() - before;
+        }
+        return run;
+    }
+
+    void report(const char* label, const Run& run, std::size_t changed)
+    {
+        std::cout << "  " << label << ": " << run.ms << " ms, " << run.allocations << " allocations"
+                  << (run.threw ? ", failed, " : ", succeeded, ") << changed << " devices changed\n";
+    }
+
+    /*
+     * Description : A thermostat switched off in HEATING is turned on, set
+     *               to COOLING and rolled back; turning it on afterwards
+     *               must give HEATING again, not the mode the rollback's
+     *               turnOff() saw.
+     */
+    bool restoresLastMode(void)
+    {
+        auto thermostat = std::make_shared<BaseThermostat>("t", "bench");
+        thermostat->setMode(BaseThermostat::ThermostatMode::HEATING);
+        thermostat->turnOff();
+
+        MacroCommand macro;
+        macro.setTransactional(true);
+        macro.addCommand(std::make_shared<TurnOnCommand>(thermostat));
+        macro.addCommand(std::make_shared<SetThermostatModeCommand>(thermostat, BaseThermostat::ThermostatMode::COOLING));
+        macro.addCommand(std::make_shared<FailingCommand>(std::make_shared<DimmableLight>("l", "bench")));
+        try
+        {
+            macro.execute();
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+
+        const bool off = thermostat->getMode() == BaseThermostat::ThermostatMode::OFF;
+        thermostat->turnOn();
+        const bool ok = off && thermostat->getMode() == BaseThermostat::ThermostatMode::HEATING;
+        std::cout << " thermostat rollback: " << (ok ? "last mode kept\n" : "FAILED\n");
+        return ok;
+    }
+}
+
+int main()
+{
+    ThreadPool pool(4);
+    std::cout << "Scene: " << ROOMS * 4 << " devices, " << ROOMS * 8 << " commands\n";
+
+    bool ok = true;
+    for (const bool fail : { false, true })
+    {
+        std::cout << (fail ? " last command fails:\n" : " all commands succeed:\n");
+
+        House plainHouse = buildHouse();
+        MacroCommand plain;
+        fillScene(plain, plainHouse, fail);
+        for (auto& light : plainHouse.lights)
+            light->setBrightness(50);
+        const auto plainBefore = stateOf(plainHouse);
+        const Run plainRun = runWarm(plain, plainHouse);
+        report("plain                 ", plainRun, changedDevices(plainBefore, plainHouse));
+
+        House serialHouse = buildHouse();
+        MacroCommand serial;
+        serial.setTransactional(true);
+        fillScene(serial, serialHouse, fail);
+        for (auto& light : serialHouse.lights)
+            light->setBrightness(50);
+        const auto serialBefore = stateOf(serialHouse);
+        const Run serialRun = runWarm(serial, serialHouse);
+        const std::size_t serialChanged = changedDevices(serialBefore, serialHouse);
+        report("transactional         ", serialRun, serialChanged);
+
+        House parallelHouse = buildHouse();
+        MacroCommand parallel(pool);
+        parallel.setTransactional(true);
+        fillScene(parallel, parallelHouse, fail);
+        for (auto& light : parallelHouse.lights)
+            light->setBrightness(50);
+        const auto parallelBefore = stateOf(parallelHouse);
+        const Run parallelRun = runWarm(parallel, parallelHouse);
+        const std::size_t parallelChanged = changedDevices(parallelBefore, parallelHouse);
+        report("transactional, 4 pool ", parallelRun, parallelChanged);
+
+        if (fail)
+            ok = ok && serialChanged == 0 && parallelChanged == 0;
+    }
+    ok = restoresLastMode() && ok;
+
+    return ok ? 0 : 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,165 @@
+/******************************************************************************
+ *  MODULE NAME  : Comfort Mode
+ *  FILE         : ComfortMode.hpp
+ *  DESCRIPTION  : Declares the ComfortMode class that implements
+ *                 IAutomationMode to hold every thermostat of the given
+ *                 groups at its target temperature with a periodic
+ *                 hysteresis control loop.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "SmartHome/Core/IAutomationMode.hpp"
+#include "SmartHome/Devices/DeviceGroup.hpp"
+#include "SmartHome/Devices/Thermostats/BaseThermostat.hpp"
+#include "SmartHome/Controllers/Scheduler.hpp"
+#include "SmartHome/Persistence/CommandJournal.hpp"
+
+namespace SmartHome::Automation
+{
+    /******************************************************************************
+     *  CLASS NAME   : ComfortMode
+     *  DESCRIPTION  : Every control period, one pass over the thermostats
+     *                 compares current against target temperature. Idle
+     *                 thermostats inside the deadband are skipped; outside it
+     *                 they start heating or cooling (or stay off, if they
+     *                 cannot). A heating or cooling thermostat is switched OFF
+     *                 once its reading reaches the target. Mode changes are
+     *                 collected first and applied together at the end of the
+     *                 pass. Runs wherever the scheduler runs its tasks; the
+     *                 loop state is locked, so that may be a pool. Budget:
+     *                 10,000 thermostats per tick in under 1 ms.
+     ******************************************************************************/
+    class ComfortMode : public Core::IAutomationMode
+    {
+    public:
+        /*
+         *  Description: Control loop tuning.
+         */
+        struct ComfortPolicy
+        {
+            float deadbandCelsius = 0.5f;   // Idle devices start only when |current - target| > deadband
+            int periodSeconds = 60;         // Time between control passes, at least 1
+        };
+
+        /*
+         *  Description: What one control pass did.
+         */
+        struct TickStats
+        {
+            std::size_t evaluated = 0;      // Thermostats looked at
+            std::size_t skipped = 0;        // Idle and inside the deadband
+            std::size_t changed = 0;        // Mode changes applied
+            std::int64_t durationNs = 0;    // Wall time of the pass
+        };
+
+        static constexpr std::int64_t TICK_BUDGET_NS = 1000000;
+
+        /*
+         *  Description: Constructor that takes a reference to the shared system
+         *               scheduler and, optionally, a journal that records the
+         *               mode changes of each pass. The journal must outlive
+         *               the mode.
+         */
+        ComfortMode(SmartHome::Controller::Scheduler& scheduler, Persistence::CommandJournal* journal = nullptr);
+
+        /*
+         *  Description: Same, with a non-default policy. Throws
+         *               std::invalid_argument for an invalid one (see setPolicy).
+         */
+        ComfortMode(SmartHome::Controller::Scheduler& scheduler, const ComfortPolicy& policy,
+                    Persistence::CommandJournal* journal = nullptr);
+
+        /*
+         *  Description: Cancels the control timer.
+         */
+        ~ComfortMode() override;
+
+        /*
+         *  Description: Takes over the thermostats of the given groups, runs a
+         *               control pass right away and then one per period.
+         *  Parameters : groups - A list of device groups whose thermostats are controlled.
+         */
+        void activate(const std::vector<std::shared_ptr<SmartHome::Devices::DeviceGroup>>& groups) override;
+
+        /*
+         *  Description: Stops the control loop; thermostats keep their last mode.
+         */
+        void deactivate() override;
+
+        /*
+         *  Description: Runs one control pass now and returns what it did.
+         */
+        TickStats controlPass();
+
+        /*
+         *  Description: Sets the deadband and period; a new period applies
+         *               from the next pass. Throws std::invalid_argument if
+         *               the period is under 1 second (a 0 s timer would rearm
+         *               inside the tick running it) or the deadband is
+         *               negative.
+         */
+        void setPolicy(const ComfortPolicy& policy);
+
+        /*
+         *  Description: Statistics of the most recent pass.
+         */
+        TickStats lastTick() const;
+
+    private:
+        using ThermostatMode = SmartHome::Devices::Thermostats::BaseThermostat::ThermostatMode;
+
+        /*
+         *  Description: A mode change decided during a pass, applied after it.
+         */
+        struct ModeChange
+        {
+            std::uint32_t index;            // Into _thermostats
+            ThermostatMode mode;
+        };
+
+        /*
+         *  Description: Throws std::invalid_argument if 'policy' is unusable.
+         */
+        static const ComfortPolicy& validated(const ComfortPolicy& policy);
+
+        /*
+         *  Description: controlPass() and deactivate() without the lock;
+         *               caller holds _mutex.
+         */
+        TickStats runPass();
+        void stop();
+
+        /*
+         *  Description: Schedules the next control pass; caller holds _mutex.
+         */
+        void armTimer();
+
+        SmartHome::Controller::Scheduler& _scheduler;
+        Persistence::CommandJournal* const _journal;  // Where mode changes are journaled, or nullptr
+        mutable std::mutex _mutex;                  // Guards everything below (timer task vs. controller)
+        std::uint64_t _epoch = 0;                   // Bumped by stop(); stale timer tasks compare it
+        SmartHome::Controller::Scheduler::TimerHandle _timer;
+        ComfortPolicy _policy;
+        TickStats _lastTick;
+
+        // Controlled thermostats and what each can do, indexed alike
+        std::vector<std::shared_ptr<SmartHome::Devices::Thermostats::BaseThermostat>> _thermostats;
+        std::vector<ThermostatMode> _whenTooWarm;   // COOLING, or OFF for heat-only devices
+        std::vector<ThermostatMode> _whenTooCold;   // HEATING, or OFF for cool-only devices
+
+        std::vector<ModeChange> _changes;           // Reused batch of the current pass
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -9,48 +9,164 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 
 #include "SmartHome/Core/IAutomationMode.hpp"
+#include "SmartHome/Core/IObserver.hpp"
 #include "SmartHome/Devices/DeviceGroup.hpp"
 #include "SmartHome/Devices/MotionSensor.hpp"
 #include "SmartHome/Controllers/Scheduler.hpp"
 #include "SmartHome/Commands/GroupOffCommand.hpp"
+#include "SmartHome/Persistence/CommandJournal.hpp"
 
 namespace SmartHome::Automation
 {
-    class EnergySavingMode : public Core::IAutomationMode
+    /******************************************************************************
+     *  CLASS NAME   : EnergySavingMode
+     *  DESCRIPTION  : Turns a group off once it has been vacant for its idle
+     *                 timeout. Each group is a small state machine
+     *                 (OCCUPIED -> OFF -> OCCUPIED) fed by MOTION events, with
+     *                 exactly one idle timer. Motion does not touch the
+     *                 scheduler; it moves the group's deadline, and the timer
+     *                 re-arms itself for the new deadline when it fires early.
+     *                 Group state is locked, so timers may run on a pool
+     *                 (Scheduler::setExecutor) concurrently with events.
+     ******************************************************************************/
+    class EnergySavingMode : public Core::IAutomationMode, public Core::IObserver
     {
     public:
         /*
-         *  Description: Constructor that takes a reference to the shared system scheduler.
+         *  Description: Timing of a group's state machine, in seconds.
          */
-        EnergySavingMode(SmartHome::Controller::Scheduler& scheduler);
+        struct IdlePolicy
+        {
+            int idleTimeoutSeconds = 600;   // Vacancy before the group is turned off
+            int debounceSeconds = 2;        // Shorter motion is a glitch, not presence
+            int hysteresisSeconds = 10;     // Motion needed to count as presence again once off
+        };
+
+        /*
+         *  Description: Returns the current time in nanoseconds on the clock
+         *               event timestamps use.
+         */
+        using Clock = std::int64_t (*)();
+
+        /*
+         *  Description: Constructor that takes a reference to the shared system
+         *               scheduler and, optionally, a journal that records the
+         *               groups the mode turns off. The journal must outlive
+         *               the mode.
+         */
+        EnergySavingMode(SmartHome::Controller::Scheduler& scheduler, Persistence::CommandJournal* journal = nullptr);
+
+        /*
+         *  Description: Unsubscribes and cancels the idle timers.
+         */
+        ~EnergySavingMode() override;
 
         /*
          *  Description: Activates energy-saving mode for the given device groups.
+         *               Groups with a motion sensor get one idle timer each,
+         *               started from now; previous timers are cancelled.
          *  Parameters : groups - A list of device groups to monitor and control.
          */
         void activate(const std::vector<std::shared_ptr<SmartHome::Devices::DeviceGroup>>& groups) override;
 
         /*
-         *  Description: Deactivates the energy-saving mode and clears scheduled commands.
+         *  Description: Deactivates the energy-saving mode and cancels pending turn-off timers.
          */
         void deactivate() override;
 
+        /*
+         *  Description: Applies a motion edge to the groups containing the sensor.
+         */
+        void onEvent(const Core::DeviceEvent& event) override;
+
+        /*
+         *  Description: Policy for groups without one of their own.
+         */
+        void setDefaultPolicy(const IdlePolicy& policy);
+
+        /*
+         *  Description: Policy for one group; takes effect immediately if the
+         *               group is being monitored.
+         */
+        void setIdlePolicy(const std::string& groupId, const IdlePolicy& policy);
+
+        /*
+         *  Description: Replaces the clock, e.g. to drive the mode with
+         *               simulated time. Defaults to EventBus::nowNs.
+         */
+        void setClock(Clock clock);
+
     private:
-        SmartHome::Controller::Scheduler& _scheduler;
+        /*
+         *  Description: A monitored group. 'lastPresenceNs' plus the idle
+         *               timeout is the group's deadline.
+         */
+        struct GroupState
+        {
+            std::shared_ptr<SmartHome::Devices::DeviceGroup> group;
+            std::string groupId;
+            IdlePolicy policy;
+
+            std::uint32_t motionCount = 0;          // Sensors currently reporting motion
+            std::int64_t motionSinceNs = 0;         // When motionCount last became non-zero
+            std::int64_t lastPresenceNs = 0;        // End of the last motion accepted as presence
+            bool off = false;                       // Turned off by this mode and still vacant
+            SmartHome::Controller::Scheduler::TimerHandle timer;
+        };
 
-        // Map of group ID to its associated turn-off command
-        std::unordered_map<std::string, std::shared_ptr<SmartHome::Commands::GroupOffCommand>> _scheduledCommands;
+        /*
+         *  Description: Last known state of a motion sensor and the monitored
+         *               groups it belongs to.
+         */
+        struct SensorFact
+        {
+            bool motion = false;
+            std::vector<std::size_t> groups;        // Indices into _groups
+        };
+
+        /*
+         *  Description: Accepts motion that lasted from 'sinceNs' to 'nowNs' as
+         *               presence if it beats the debounce window, or the
+         *               hysteresis window while the group is off.
+         */
+        static void notePresence(GroupState& state, std::int64_t sinceNs, std::int64_t nowNs);
 
         /*
-         *  Description: Handles logic when motion is detected or not for a group.
-         *  Parameters : group - The device group to evaluate.
+         *  Description: Runs when a group's idle timer fires: turns the group
+         *               off if its deadline has passed, then re-arms the timer.
+         *               Ignored if 'epoch' is not the current one.
          */
-        void handleMotionState(const std::shared_ptr<SmartHome::Devices::DeviceGroup>& group);
+        void onIdleTimer(std::size_t index, std::uint64_t epoch);
+
+        /*
+         *  Description: Arms the group's timer to fire 'delayNs' from now.
+         */
+        void armTimer(std::size_t index, std::int64_t delayNs);
+
+        /*
+         *  Description: Cancels every idle timer and starts a new epoch;
+         *               caller holds _mutex.
+         */
+        void cancelTimers();
+
+        SmartHome::Controller::Scheduler& _scheduler;
+        Persistence::CommandJournal* const _journal;          // Where turn-offs are journaled, or nullptr
+
+        mutable std::mutex _mutex;                            // Guards group state (event thread vs. scheduler)
+        std::uint64_t _epoch = 0;                             // Identifies the current _groups for timer tasks
+        Clock _clock;
+        IdlePolicy _defaultPolicy;
+        std::unordered_map<std::string, IdlePolicy> _policies; // Per-group overrides by group ID
+        std::vector<GroupState> _groups;                       // Monitored groups
+        std::unordered_map<const Core::IDevice*, SensorFact> _sensors;
     };
 }
 
@@ -0,0 +1,60 @@
+/******************************************************************************
+ *  MODULE NAME  : Automation Rules
+ *  FILE         : RuleCompiler.hpp
+ *  DESCRIPTION  : Declares the RuleCompiler, which turns the text of a rules
+ *                 file into a RuleProgram. One rule per line:
+ *
+ *                   # comment
+ *                   rule hall-intruder: when motion(Hallway) and unlocked(front-door)
+ *                                       then record(hall-cam)
+ *
+ *                 (written on a single line). Conditions combine motion(ID),
+ *                 locked(ID), unlocked(ID) and temperature(ID) > / < N with
+ *                 and, or, not and parentheses, nested at most 64 deep. A
+ *                 group ID in a condition means "any matching device of the
+ *                 group", as of compile time (see RuleEngine::refresh()).
+ *                 Actions are
+ *                 record, stop_recording, lock, unlock, on and off, separated
+ *                 by commas; a group ID in an action is expanded the same
+ *                 way, on and off to every member. IDs containing spaces are
+ *                 written in quotes.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string_view>
+
+#include "SmartHome/Automation/RuleProgram.hpp"
+
+namespace SmartHome::Automation
+{
+    /******************************************************************************
+     *  CLASS NAME   : RuleCompiler
+     *  DESCRIPTION  : Resolves every ID once, emits postfix bytecode per rule,
+     *                 builds the action commands and the input-to-rule index,
+     *                 and reads the current state of every input.
+     ******************************************************************************/
+    class RuleCompiler
+    {
+    public:
+        /*
+         *  Description : Looks up a device or group by ID; nullptr if unknown.
+         */
+        using Resolver = std::function<std::shared_ptr<Core::IDevice>(std::string_view id)>;
+
+        /*
+         *  Description : Compiles 'source'. Throws std::invalid_argument naming
+         *                the line on a syntax error, an unknown ID or a device
+         *                of the wrong kind.
+         */
+        static RuleProgram compile(std::string_view source, const Resolver& resolve);
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
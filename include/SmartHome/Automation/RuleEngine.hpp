@@ -0,0 +1,129 @@
+/******************************************************************************
+ *  MODULE NAME  : Automation Rules
+ *  FILE         : RuleEngine.hpp
+ *  DESCRIPTION  : Declares the RuleEngine, which runs compiled automation
+ *                 rules against sensor events. Each event updates one input
+ *                 and re-evaluates only the rules that read it.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "SmartHome/Automation/RuleCompiler.hpp"
+#include "SmartHome/Automation/RuleProgram.hpp"
+#include "SmartHome/Commands/CommandBatch.hpp"
+#include "SmartHome/Core/IObserver.hpp"
+#include "SmartHome/Persistence/CommandJournal.hpp"
+
+namespace SmartHome::Automation
+{
+    /******************************************************************************
+     *  CLASS NAME   : RuleEngine
+     *  DESCRIPTION  : Holds one RuleProgram and subscribes to the event types
+     *                 it reads. A rule's actions run when its condition turns
+     *                 true; it must turn false again before they run again.
+     *                 The actions of all rules fired by one event run in order
+     *                 as one CommandBatch once evaluation is done, so a later
+     *                 rule overrides an earlier one. Without a journal the
+     *                 batch does not coalesce: the actions are in-memory
+     *                 device writes, cheaper to make than to deduplicate.
+     *                 With one, superseded writes are dropped before they
+     *                 are journaled.
+     *                 Loading replaces the previous rules as a whole. Groups
+     *                 are expanded to their members when rules are compiled;
+     *                 refresh() recompiles after membership changes.
+     ******************************************************************************/
+    class RuleEngine : public Core::IObserver
+    {
+    public:
+        /*
+         *  Description : 'journal', if set, records the writes of every rule
+         *                action; it must outlive the engine.
+         */
+        explicit RuleEngine(Persistence::CommandJournal* journal = nullptr);
+
+        /*
+         *  Description : Unsubscribes from the event bus.
+         */
+        ~RuleEngine() override;
+
+        RuleEngine(const RuleEngine&) = delete;
+        RuleEngine& operator=(const RuleEngine&) = delete;
+
+        /*
+         *  Description : Compiles 'source' and makes it the active rule set.
+         *                Conditions that already hold are recorded as such
+         *                without running their actions. Throws
+         *                std::invalid_argument on a compile error, leaving the
+         *                previous rules in place. Returns the number of rules.
+         */
+        std::size_t load(std::string_view source, const RuleCompiler::Resolver& resolve);
+
+        /*
+         *  Description : load() with the contents of a rules file. Throws
+         *                std::runtime_error if the file cannot be read.
+         */
+        std::size_t loadFile(const std::string& path, const RuleCompiler::Resolver& resolve);
+
+        /*
+         *  Description : Recompiles the last loaded rules if a group they
+         *                expand has gained or lost members, or its ID no
+         *                longer names it (deleted or replaced). Call from
+         *                the thread that changes groups. Returns true if the
+         *                rules were recompiled; throws like load() if they no
+         *                longer compile, keeping the previous rules.
+         */
+        bool refresh();
+
+        /*
+         *  Description : Drops every rule and unsubscribes.
+         */
+        void clear();
+
+        /*
+         *  Description : Applies the event to its input and re-evaluates the
+         *                dependent rules only.
+         */
+        void onEvent(const Core::DeviceEvent& event) override;
+
+        /*
+         *  Description : Number of rules loaded.
+         */
+        std::size_t ruleCount() const;
+
+        /*
+         *  Description : Number of times any rule's actions have run.
+         */
+        std::uint64_t firedCount() const;
+
+    private:
+        /*
+         *  Description : Runs a rule's bytecode over the current input values.
+         */
+        bool evaluate(const Rule& rule) const;
+
+        /*
+         *  Description : Queues a rule's actions and logs it.
+         */
+        void fire(const Rule& rule);
+
+        mutable std::mutex _mutex;          // Guards the program (event thread vs. controller)
+        RuleProgram _program;
+        std::string _source;                // Text of the loaded rules, for refresh()
+        RuleCompiler::Resolver _resolve;    // Resolver they were loaded with
+        Persistence::CommandJournal* const _journal; // Where actions are journaled, or nullptr
+        Commands::CommandBatch _batch;      // Actions of the rules fired by one event
+        std::uint64_t _fired = 0;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
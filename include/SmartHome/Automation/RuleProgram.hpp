@@ -0,0 +1,120 @@
+/******************************************************************************
+ *  MODULE NAME  : Automation Rules
+ *  FILE         : RuleProgram.hpp
+ *  DESCRIPTION  : Declares the compiled form of automation rules: flat
+ *                 bytecode per rule, the device inputs it reads, prebuilt
+ *                 action commands and the inverted index from each input
+ *                 to the rules that depend on it.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SmartHome/Core/DeviceEvent.hpp"
+#include "SmartHome/Core/ICommand.hpp"
+#include "SmartHome/Core/IDevice.hpp"
+
+namespace SmartHome::Devices
+{
+    class DeviceGroup;
+}
+
+namespace SmartHome::Automation
+{
+    /*
+     *  Description : Instructions of the condition stack machine. Input ops
+     *                push one bool; AND/OR pop two and push one; NOT flips
+     *                the top.
+     */
+    enum class OpCode : std::uint8_t
+    {
+        IS_SET,     // values[input] != 0
+        IS_CLEAR,   // values[input] == 0
+        GREATER,    // values[input] > operand
+        LESS,       // values[input] < operand
+        AND,
+        OR,
+        NOT
+    };
+
+    struct Instruction
+    {
+        OpCode op;
+        std::uint32_t input = 0;    // Index into RuleProgram::inputs
+        float operand = 0.0f;       // Threshold for GREATER / LESS
+    };
+
+    /*
+     *  Description : Maximum stack depth a condition may need.
+     */
+    constexpr std::size_t RULE_STACK_DEPTH = 32;
+
+    /*
+     *  Description : A device state read by rules. A device provides at
+     *                most one input: the event type it publishes.
+     */
+    struct RuleInput
+    {
+        std::shared_ptr<Core::IDevice> device;
+        Core::EventType type;
+    };
+
+    /*
+     *  Description : A group whose members were expanded into the program,
+     *                with its membership revision at that time.
+     */
+    struct RuleGroup
+    {
+        std::shared_ptr<Devices::DeviceGroup> group;
+        std::uint64_t revision = 0;
+    };
+
+    /*
+     *  Description : One rule: ranges into the program's code and actions.
+     *                'active' holds the last result; actions run only when it
+     *                turns from false to true.
+     */
+    struct Rule
+    {
+        std::string name;
+        std::uint32_t codeBegin = 0;
+        std::uint32_t codeEnd = 0;
+        std::uint32_t actionsBegin = 0;
+        std::uint32_t actionsEnd = 0;
+        bool active = false;
+    };
+
+    /******************************************************************************
+     *  STRUCT NAME  : RuleProgram
+     *  DESCRIPTION  : Everything rules need at run time, in flat arrays. The
+     *                 dependents of input i are
+     *                 dependents[dependentsBegin[i] .. dependentsBegin[i + 1]).
+     ******************************************************************************/
+    struct RuleProgram
+    {
+        std::vector<Rule> rules;
+        std::vector<Instruction> code;
+        std::vector<std::shared_ptr<Core::ICommand>> actions;
+
+        std::vector<RuleInput> inputs;
+        std::vector<float> values;                      // Current value per input (bools as 0/1)
+        std::vector<std::uint32_t> dependentsBegin;     // inputs.size() + 1 offsets
+        std::vector<std::uint32_t> dependents;          // Rule indices
+        std::unordered_map<const Core::IDevice*, std::uint32_t> inputOf;
+        std::vector<RuleGroup> groups;                  // Expanded groups, to detect membership changes
+
+        Core::EventMask events = 0;                     // Event types any rule reads
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
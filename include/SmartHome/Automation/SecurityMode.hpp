@@ -9,28 +9,50 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 #include "SmartHome/Core/IAutomationMode.hpp"
+#include "SmartHome/Core/IObserver.hpp"
 #include "SmartHome/Devices/DeviceGroup.hpp"
 #include "SmartHome/Controllers/Scheduler.hpp"
 #include "SmartHome/Commands/StartRecordingCommand.hpp"
+#include "SmartHome/Persistence/CommandJournal.hpp"
+#include "SmartHome/Devices/Cameras/BaseCamera.hpp"
 #include "SmartHome/Utils/Logger.hpp"
 
 namespace SmartHome::Automation
 {
-    class SecurityMode : public Core::IAutomationMode
+    class SecurityMode : public Core::IAutomationMode, public Core::IObserver
     {
     public:
         /*
          * Description : Constructor that initializes SecurityMode with a reference to the scheduler.
          * Parameters  : scheduler - Reference to the system scheduler used for delayed execution.
+         *               journal   - Optional; if set, cameras started by the mode are journaled
+         *                           there. Must outlive the mode.
          */
-        SecurityMode(SmartHome::Controller::Scheduler& scheduler);
+        SecurityMode(SmartHome::Controller::Scheduler& scheduler, Persistence::CommandJournal* journal = nullptr);
 
         /*
-         * Description : Activates security mode by enabling surveillance devices in given groups.
+         * Description : Unsubscribes from the event bus.
+         */
+        ~SecurityMode() override;
+
+        /*
+         * Description : Arms security mode on the given groups. Groups with a
+         *               camera are armed; once subscribed, their motion
+         *               sensors and locks are read to seed per-group facts,
+         *               after which MOTION and LOCK events keep those facts
+         *               current. Calling it again with the same, unchanged
+         *               groups is a no-op unless the bus dropped events, in
+         *               which case the facts are re-read. Re-activate to pick
+         *               up group membership changes.
          * Parameters  : groups - A vector of shared pointers to DeviceGroup instances to activate.
          */
         void activate(const std::vector<std::shared_ptr<SmartHome::Devices::DeviceGroup>>& groups) override;
@@ -40,8 +62,85 @@ namespace SmartHome::Automation
          */
         void deactivate() override;
 
+        /*
+         * Description : Updates the facts of the groups containing the event's
+         *               sensor and re-evaluates only those groups. If the bus
+         *               has dropped events since the facts were read, re-reads
+         *               them all instead.
+         */
+        void onEvent(const Core::DeviceEvent& event) override;
+
+        /*
+         * Description : True between activate() and deactivate().
+         */
+        bool isArmed() const;
+
     private:
+        /*
+         * Description : An armed group and the facts derived from its sensors.
+         *               Everything the event thread needs is captured here, so
+         *               it never reads the group itself.
+         */
+        struct ArmedGroup
+        {
+            std::shared_ptr<SmartHome::Devices::Cameras::BaseCamera> camera;
+            std::string groupId;
+
+            std::uint32_t motionCount = 0;          // Sensors currently reporting motion
+            std::uint32_t unlockedCount = 0;        // Locks currently open
+            bool recording = false;                 // We started the camera and it is still on
+        };
+
+        /*
+         * Description : Last known state of a watched sensor or lock and the
+         *               armed groups it belongs to.
+         */
+        struct SensorFact
+        {
+            Core::EventType type;
+            bool active = false;                    // Motion present / door unlocked
+            std::vector<std::size_t> groups;        // Indices into _armedGroups
+        };
+
+        /*
+         * Description : True if 'groups' is exactly the armed set, unchanged.
+         */
+        bool isArmedWith(const std::vector<std::shared_ptr<SmartHome::Devices::DeviceGroup>>& groups) const;
+
+        /*
+         * Description : Reads whether a motion sensor reports motion, or a
+         *               lock is open. The type says which class 'device' is.
+         */
+        static bool isActive(const Core::IDevice* device, Core::EventType type);
+
+        /*
+         * Description : Records one sensor of an armed group and its current state.
+         */
+        void watch(std::size_t index, const Core::IDevice* device, Core::EventType type);
+
+        /*
+         * Description : Re-reads every watched sensor and lock and rebuilds
+         *               the group counters, after events were dropped.
+         */
+        void resync();
+
+        /*
+         * Description : Starts the group's camera if one of its facts calls for
+         *               it and it is not already recording.
+         */
+        void evaluate(ArmedGroup& armed);
+
         SmartHome::Controller::Scheduler& _scheduler; // Reference to the shared task scheduler
+        Persistence::CommandJournal* const _journal;  // Where started recordings are journaled, or nullptr
+
+        mutable std::mutex _mutex;                            // Guards the armed state (event thread vs. controller)
+        bool _armed = false;
+        std::uint64_t _droppedSeen = 0;                       // EventBus::droppedCount() the facts account for
+        std::vector<ArmedGroup> _armedGroups;                 // Groups with a camera
+        std::vector<std::pair<std::shared_ptr<SmartHome::Devices::DeviceGroup>, std::uint64_t>>
+            _activatedWith;                                   // Groups and revisions of the last activate()
+        std::unordered_map<const Core::IDevice*, SensorFact>
+            _sensors;                                         // Watched sensors and locks
     };
 }
 
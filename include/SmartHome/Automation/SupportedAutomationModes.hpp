@@ -2,13 +2,14 @@
  *  MODULE NAME  : Supported Automation Modes
  *  FILE         : SupportedAutomationModes.hpp
  *  DESCRIPTION  : Aggregates and exposes all automation modes supported by
- *                 the Smart Home system, such as Energy Saving and Security Mode.
+ *                 the Smart Home system, such as Energy Saving, Security and Comfort Mode.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : July 2025
  ******************************************************************************/
 
 #pragma once
 
+#include "SmartHome/Automation/ComfortMode.hpp"
 #include "SmartHome/Automation/EnergySavingMode.hpp"
 #include "SmartHome/Automation/SecurityMode.hpp"
 
@@ -19,6 +20,7 @@
  ******************************************************************************/
 
 // Currently supported modes:
+// - ComfortMode
 // - EnergySavingMode
 // - SecurityMode
 
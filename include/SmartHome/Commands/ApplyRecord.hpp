@@ -0,0 +1,43 @@
+/******************************************************************************
+ *  MODULE NAME  : Command Records
+ *  FILE         : ApplyRecord.hpp
+ *  DESCRIPTION  : Declares applyValue(), which performs the state write a
+ *                 Core::CommandRecord describes. Used to replay journaled
+ *                 commands and to redo or undo recorded ones. Also
+ *                 declares captureValues(), which snapshots a device.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "SmartHome/Core/CommandRecord.hpp"
+#include "SmartHome/Core/IDevice.hpp"
+
+namespace SmartHome::Commands
+{
+    /*
+     *  Description : Writes 'value' to the 'code' property of 'target' through
+     *                the same device call the original command made, so
+     *                side effects and events repeat as well. Throws
+     *                std::invalid_argument if the device has no such property.
+     */
+    void applyValue(Core::IDevice& target, Core::CommandCode code, float value);
+
+    /*
+     *  Description : Appends one record per property of 'target' that a
+     *                command can write, with the current value as both old
+     *                and new value; a group adds its members instead.
+     *                Applying the old values in order restores the device:
+     *                power comes first, since switching it resets the rest,
+ *                and a thermostat's last mode comes last, since turning
+ *                it off overwrites that.
+     */
+    void captureValues(Core::IDevice& target, std::vector<Core::CommandRecord>& values);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
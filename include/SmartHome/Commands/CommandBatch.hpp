@@ -0,0 +1,140 @@
+/******************************************************************************
+ *  MODULE NAME  : Command Batch
+ *  FILE         : CommandBatch.hpp
+ *  DESCRIPTION  : Declares the CommandBatch class, which collects the
+ *                 commands issued during one tick and drops those whose
+ *                 writes are all safely overwritten later in the same batch.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SmartHome/Core/ICommand.hpp"
+#include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Commands/MacroCommand.hpp"
+
+namespace SmartHome::Commands
+{
+    /*
+     * Description : Running totals of a CommandBatch, for diagnostics.
+     */
+    struct BatchStats
+    {
+        std::uint64_t commandsAdded = 0;
+        std::uint64_t commandsRun = 0;      // Kept after coalescing
+        std::uint64_t writesAdded = 0;      // State writes described by the added commands
+        std::uint64_t writesRun = 0;
+    };
+
+    /******************************************************************************
+     *  CLASS NAME   : CommandBatch
+     *  DESCRIPTION  : Commands are keyed by the writes they describe (target
+     *                 and CommandCode). A command is dropped when every one of
+     *                 its writes is written again by a later command in the
+     *                 batch and is coalescable: the write sets the property
+     *                 outright, and no command reads it back (see
+     *                 isCoalescable()). Thermostat power and mode fail that
+     *                 test, since turnOn() restores the mode saved by
+     *                 turnOff() and the target is clamped by the mode. The
+     *                 rest keep their order, so each device ends in the state
+     *                 the full sequence would have left it in. A command that
+     *                 describes no writes is a barrier: nothing before it is
+     *                 dropped because of something after it. Writes are
+     *                 matched by target, so a group write does not supersede
+     *                 earlier writes to its members. Not thread-safe.
+     *
+     *                 Coalescing costs a describe() and a hash probe per
+     *                 write, more than an in-memory device write; it pays off
+     *                 when each write is journaled. Pass coalesce = false to
+     *                 only defer and run the commands in order.
+     ******************************************************************************/
+    class CommandBatch
+    {
+    public:
+        explicit CommandBatch(bool coalesce = true) : _coalesce(coalesce) {}
+
+        /*
+         * Description : True if a write of 'code' to a device of type 'type'
+         *               may be dropped when it is written again later.
+         */
+        static bool isCoalescable(Core::DeviceType type, Core::CommandCode code);
+
+        /*
+         * Description : Queues a command; nothing runs until execute() or
+         *               release().
+         */
+        void add(std::shared_ptr<Core::ICommand> command);
+
+        /*
+         * Description : Coalesces the queued commands, runs the ones kept in
+         *               order and empties the batch. Returns how many ran.
+         */
+        std::size_t execute(void);
+
+        /*
+         * Description : Coalesces the queued commands into a MacroCommand,
+         *               not yet executed (e.g. for a journal or undo history),
+         *               and empties the batch.
+         */
+        std::shared_ptr<MacroCommand> release(void);
+
+        std::size_t pending(void) const { return _commands.size(); }
+        bool empty(void) const { return _commands.empty(); }
+
+        /*
+         * Description : Drops the queued commands without running them.
+         */
+        void clear(void);
+
+        const BatchStats& stats(void) const { return _stats; }
+
+    private:
+        /*
+         * Description : One written property of one target, in an open
+         *               addressing table. Entries from an older stamp count
+         *               as empty, so the table is never cleared.
+         */
+        struct WriteSlot
+        {
+            const Core::IDevice* target = nullptr;
+            Core::CommandCode code = Core::CommandCode::COUNT;
+            std::uint32_t stamp = 0;
+        };
+
+        /*
+         * Description : Records that 'write' is made further on. Returns
+         *               false if it already was.
+         */
+        bool markLater(const Core::CommandRecord& write);
+
+        /*
+         * Description : Forgets every write marked so far.
+         */
+        void forgetLater(void);
+
+        /*
+         * Description : Marks the commands to keep in _keep and updates the
+         *               stats.
+         */
+        void coalesce(void);
+
+        std::vector<std::shared_ptr<Core::ICommand>> _commands;
+        std::vector<Core::CommandRecord> _writes;           // Writes of all commands, in order
+        std::vector<std::size_t> _writesEnd;                // One past each command's writes
+        std::vector<bool> _keep;
+        std::vector<WriteSlot> _later;                      // Written by a kept command further on
+        std::uint32_t _stamp = 0;
+        bool _coalesce;
+        BatchStats _stats;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,129 @@
+/******************************************************************************
+ *  MODULE NAME  : Command Pool
+ *  FILE         : CommandPool.hpp
+ *  DESCRIPTION  : Declares the CommandPool class, which creates command
+ *                 objects from recycled fixed-size blocks instead of the
+ *                 global allocator.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace SmartHome::Commands
+{
+    /******************************************************************************
+     *  CLASS NAME   : CommandPool
+     *  DESCRIPTION  : make<T>() returns an ordinary shared_ptr whose object and
+     *                 control block share one block, taken from a free list
+     *                 per 16-byte size class. Blocks are carved from slabs that
+     *                 are kept until the pool is destroyed, so once a burst has
+     *                 warmed the pool, later bursts of the same size allocate
+     *                 nothing. Blocks may be released on any thread. The pool
+     *                 must outlive every object it made.
+     ******************************************************************************/
+    class CommandPool
+    {
+    public:
+        /*
+         * Description : Minimal allocator handing out blocks of a CommandPool;
+         *               what std::allocate_shared needs.
+         */
+        template <typename T>
+        class Allocator
+        {
+        public:
+            using value_type = T;
+
+            explicit Allocator(CommandPool& pool) : _pool(&pool) {}
+
+            template <typename U>
+            Allocator(const Allocator<U>& other) : _pool(other._pool) {}
+
+            T* allocate(std::size_t count)
+            {
+                return static_cast<T*>(_pool->allocate(count * sizeof(T), alignof(T)));
+            }
+
+            void deallocate(T* pointer, std::size_t count) noexcept
+            {
+                _pool->deallocate(pointer, count * sizeof(T), alignof(T));
+            }
+
+            template <typename U>
+            bool operator==(const Allocator<U>& other) const { return _pool == other._pool; }
+
+            template <typename U>
+            bool operator!=(const Allocator<U>& other) const { return _pool != other._pool; }
+
+        private:
+            template <typename U>
+            friend class Allocator;
+
+            CommandPool* _pool;
+        };
+
+        /*
+         * Description : Each slab holds 'blocksPerSlab' blocks of one size class.
+         */
+        explicit CommandPool(std::size_t blocksPerSlab = 256);
+
+        CommandPool(const CommandPool&) = delete;
+        CommandPool& operator=(const CommandPool&) = delete;
+
+        /*
+         * Description : Creates a T, e.g. pool.make<TurnOnCommand>(device).
+         */
+        template <typename T, typename... Args>
+        std::shared_ptr<T> make(Args&&... args)
+        {
+            return std::allocate_shared<T>(Allocator<T>(*this), std::forward<Args>(args)...);
+        }
+
+        /*
+         * Description : Blocks currently handed out, and slabs taken from the
+         *               global allocator so far.
+         */
+        std::size_t blocksInUse(void) const;
+        std::size_t slabCount(void) const;
+
+    private:
+        static constexpr std::size_t GRANULE = alignof(std::max_align_t);
+        static constexpr std::size_t SIZE_CLASSES = 16;    // Blocks of 16 .. 256 bytes
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        /*
+         * Description : Requests too large or too aligned for a size class go
+         *               to the global allocator.
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment);
+        void deallocate(void* block, std::size_t bytes, std::size_t alignment) noexcept;
+
+        /*
+         * Description : Carves a new slab into the free list of 'sizeClass'.
+         */
+        void grow(std::size_t sizeClass);
+
+        const std::size_t _blocksPerSlab;
+        mutable std::mutex _mutex;
+        std::array<FreeBlock*, SIZE_CLASSES> _free{};
+        std::vector<std::unique_ptr<std::max_align_t[]>> _slabs;
+        std::size_t _inUse = 0;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
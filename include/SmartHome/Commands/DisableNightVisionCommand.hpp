@@ -40,6 +40,11 @@ public:
      */
     void undo(void) override;
 
+    /*
+     *  Description: Describes the write made by execute().
+     */
+    void describe(std::vector<Core::CommandRecord>& records) const override;
+
 private:
     std::shared_ptr<Devices::Cameras::BaseCamera> _camera;  // Target camera device
     bool _wasEnabledBefore;                                 // Previous night vision state
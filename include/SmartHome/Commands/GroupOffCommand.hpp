@@ -38,6 +38,11 @@ namespace SmartHome::Commands
          */
         void undo(void) override;
 
+        /*
+         *  Description: Describes the write made by execute().
+         */
+        void describe(std::vector<Core::CommandRecord>& records) const override;
+
     private:
         std::shared_ptr<Core::IDevice> _group;  // The group device (DeviceGroup)
         bool _wasOnBefore;                      // Stores state before execution
@@ -0,0 +1,67 @@
+/******************************************************************************
+ *  MODULE NAME  : Journaled Command
+ *  FILE         : JournaledCommand.hpp
+ *  DESCRIPTION  : Decorator that runs any command and appends the state
+ *                 writes it describes to the command journal, so they
+ *                 survive a crash.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SmartHome/Core/ICommand.hpp"
+#include "SmartHome/Persistence/CommandJournal.hpp"
+
+namespace SmartHome::Commands
+{
+
+/******************************************************************************
+ *  CLASS NAME   : JournaledCommand
+ *  DESCRIPTION  : Journals after the wrapped command has run, so only
+ *                 writes that happened are logged. execute() does not wait
+ *                 for the disk; the journal's SyncPolicy bounds how long a
+ *                 record can stay volatile.
+ ******************************************************************************/
+class JournaledCommand : public Core::ICommand
+{
+public:
+    /*
+     *  Description: Wraps 'command'; 'journal' must outlive this object.
+     */
+    JournaledCommand(std::shared_ptr<Core::ICommand> command, Persistence::CommandJournal& journal);
+
+    /*
+     *  Description: Executes the wrapped command and journals its writes.
+     */
+    void execute(void) override;
+
+    /*
+     *  Description: Undoes the wrapped command and journals the restoring
+     *               writes, last write first.
+     */
+    void undo(void) override;
+
+    void describe(std::vector<Core::CommandRecord>& records) const override;
+
+    /*
+     *  Description: LSN of the last record journaled, 0 if none; pass it to
+     *               CommandJournal::waitDurable() to wait for the disk.
+     */
+    std::uint64_t lastLsn(void) const { return _lastLsn; }
+
+private:
+    std::shared_ptr<Core::ICommand> _command;       // Wrapped command
+    Persistence::CommandJournal& _journal;          // Destination of the records
+    std::vector<Core::CommandRecord> _records;      // Writes of the last execute()
+    std::uint64_t _lastLsn = 0;
+};
+
+} // namespace SmartHome::Commands
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
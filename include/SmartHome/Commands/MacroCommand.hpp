@@ -9,9 +9,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <utility>
 #include "SmartHome/Core/ICommand.hpp"
+#include "SmartHome/Executors/ThreadPool.hpp"
 
 namespace SmartHome::Commands
 {
@@ -23,6 +26,14 @@ namespace SmartHome::Commands
          */
         MacroCommand(void) = default;
 
+        /*
+         * Description: Creates a macro whose execute() runs independent
+         *              commands concurrently on 'pool' and returns when all
+         *              are done. Commands that touch the same device still
+         *              run one after another, in the order they were added.
+         */
+        explicit MacroCommand(Executors::ThreadPool& pool);
+
         /*
          * Description: Adds a new command to the macro.
          * Parameters : command - A shared pointer to a command to be included.
@@ -30,17 +41,102 @@ namespace SmartHome::Commands
         void addCommand(std::shared_ptr<ICommand> command);
 
         /*
-         * Description: Executes all commands in the macro in the order they were added.
+         * Description: Adds a command and declares devices it touches besides
+         *              the targets it describes (e.g. a device it only reads).
+         */
+        void addCommand(std::shared_ptr<ICommand> command, const std::vector<const Core::IDevice*>& touches);
+
+        /*
+         * Description: In transactional mode execute() is all or nothing: if a
+         *              command throws, every device touched by a command that
+         *              had started is put back to its state before execute()
+         *              and the exception is rethrown.
+         */
+        void setTransactional(bool enabled) { _transactional = enabled; }
+        bool isTransactional(void) const { return _transactional; }
+
+        /*
+         * Description: Executes all commands in the macro in the order they were added,
+         *              or concurrently when the macro was given a pool.
          */
         void execute(void) override;
 
+
         /*
-         * Description: Undoes all commands in the macro in reverse order.
+         * Description: Undoes all commands in the macro in reverse order. With
+         *              a pool, the same independent sets as in execute() are
+         *              undone concurrently, each in reverse order.
          */
         void undo(void) override;
 
+        /*
+         *  Description: Describes the writes of every sub-command, in order.
+         */
+        void describe(std::vector<Core::CommandRecord>& records) const override;
+
     private:
+        /*
+         * Description: Splits the commands into stages of independent sets.
+         *              Commands that share a device (group members included)
+         *              are in the same set; a command that neither describes
+         *              nor declares a target is a stage of its own.
+         */
+        void plan(void);
+
+        /*
+         * Description: Runs every set of a stage, forwards or in reverse.
+         */
+        void runStage(std::size_t stage, bool forwards);
+
+        /*
+         * Description: Runs one set, forwards (execute) or backwards (undo).
+         */
+        void runSet(std::size_t set, bool forwards);
+
+        /*
+         * Description: Snapshots every device the commands describe as a
+         *              target, before any of them runs.
+         */
+        void stagePreImages(void);
+
+        /*
+         * Description: Restores the snapshots of the devices touched by the
+         *              commands that started; commands describing no target
+         *              are undone if they finished.
+         */
+        void rollback(void);
+
+        /*
+         * Description: Runs one command, tracking its progress in
+         *              transactional mode.
+         */
+        void runCommand(std::size_t index);
+
+        struct Stage
+        {
+            std::size_t setsBegin;
+            std::size_t setsEnd;
+        };
+
         std::vector<std::shared_ptr<ICommand>> _commands;  // List of commands in the macro
+        Executors::ThreadPool* _pool = nullptr;             // Runs commands concurrently if set
+        std::vector<std::pair<std::size_t, const Core::IDevice*>> _declared;    // Command index, device
+
+        // Plan of the last concurrent execute(), kept for undo()
+        std::vector<std::size_t> _order;                    // Command indices, grouped by set
+        std::vector<std::size_t> _setsEnd;                  // One past each set in _order
+        std::vector<Stage> _stages;
+
+        // Transactional mode; buffers are reused between runs
+        enum Progress : std::uint8_t { NOT_STARTED, STARTED, FINISHED };
+        bool _transactional = false;
+        std::vector<Core::IDevice*> _targets;               // Described targets, grouped by command
+        std::vector<std::size_t> _targetsEnd;               // One past each command's targets
+        std::vector<Core::IDevice*> _staged;                // Distinct targets, sorted
+        std::vector<std::size_t> _imagesEnd;                // One past each staged target's values
+        std::vector<Core::CommandRecord> _images;           // Values before execute()
+        std::vector<std::uint8_t> _progress;                // Progress per command
+        std::vector<std::uint8_t> _restore;                 // Per staged target
     };
 }
 
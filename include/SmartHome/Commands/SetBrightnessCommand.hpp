@@ -41,6 +41,11 @@ public:
      */
     void undo(void) override;
 
+    /*
+     *  Description: Describes the write made by execute().
+     */
+    void describe(std::vector<Core::CommandRecord>& records) const override;
+
 private:
     std::shared_ptr<Devices::Lights::DimmableLight> _light;  // Target dimmable light device
     int _newBrightness;  // New brightness value to apply
@@ -41,6 +41,11 @@ public:
      */
     void undo(void) override;
 
+    /*
+     *  Description: Describes the write made by execute().
+     */
+    void describe(std::vector<Core::CommandRecord>& records) const override;
+
 private:
     std::shared_ptr<Devices::Thermostats::BaseThermostat> _temperature;  // Target thermostat device
     int _newTargetTemperature;  // New temperature to be set
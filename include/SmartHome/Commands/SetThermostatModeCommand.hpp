@@ -44,6 +44,11 @@ public:
      */
     void undo(void) override;
 
+    /*
+     *  Description: Describes the write made by execute().
+     */
+    void describe(std::vector<Core::CommandRecord>& records) const override;
+
 private:
     std::shared_ptr<Devices::Thermostats::BaseThermostat> _thermostat;  // Target thermostat
     Devices::Thermostats::BaseThermostat::ThermostatMode _newMode;      // Mode to set
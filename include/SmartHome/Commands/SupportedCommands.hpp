@@ -35,6 +35,10 @@
 
 // Macro Commands
 #include "SmartHome/Commands/MacroCommand.hpp"
+#include "SmartHome/Commands/JournaledCommand.hpp"
+
+// Allocation
+#include "SmartHome/Commands/CommandPool.hpp"
 
 /******************************************************************************
  *  NOTE:
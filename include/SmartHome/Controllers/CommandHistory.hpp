@@ -0,0 +1,141 @@
+/******************************************************************************
+ *  MODULE NAME  : Command History
+ *  FILE         : CommandHistory.hpp
+ *  DESCRIPTION  : Declares the CommandHistory class, the controller's undo
+ *                 and redo history. Executed commands are kept as small
+ *                 fixed-size records in a ring of fixed capacity, not as
+ *                 command objects.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "SmartHome/Core/CommandRecord.hpp"
+#include "SmartHome/Core/IDevice.hpp"
+
+namespace SmartHome::Controller
+{
+    /******************************************************************************
+     *  CLASS NAME   : CommandHistory
+     *  DESCRIPTION  : Each record names its target by a slot in a small table
+     *                 of weak references, so undoing a write to a device or
+     *                 group that was deleted meanwhile is skipped instead of
+     *                 touching freed memory. When the ring is full the oldest
+     *                 whole commands are dropped. Not thread-safe; owned by
+     *                 the controller thread.
+     ******************************************************************************/
+    class CommandHistory
+    {
+    public:
+        /*
+         * Description : Returns the owning pointer of a command target, or
+         *               nullptr if it is not owned by the caller any more.
+         */
+        using Owner = std::function<std::shared_ptr<Core::IDevice>(const Core::IDevice&)>;
+
+        /*
+         * Description : Keeps up to 'capacity' records (one per state write).
+         */
+        CommandHistory(std::size_t capacity, Owner owner);
+
+        /*
+         * Description : Records one executed command given by its writes, in
+         *               execution order, and discards anything undone. A
+         *               command with more writes than the capacity clears
+         *               the history instead.
+         */
+        void push(const std::vector<Core::CommandRecord>& writes);
+
+        /*
+         * Description : Reverts the last recorded command, last write first.
+         *               The writes made are appended to 'applied' (e.g. for
+         *               the journal). Returns false if there is nothing to undo.
+         */
+        bool undo(std::vector<Core::CommandRecord>& applied);
+
+        /*
+         * Description : Reapplies the last undone command. Returns false if
+         *               there is nothing to redo.
+         */
+        bool redo(std::vector<Core::CommandRecord>& applied);
+
+        bool canUndo(void) const { return _cursor != _begin; }
+        bool canRedo(void) const { return _cursor != _end; }
+
+        /*
+         * Description : Number of commands that can be undone / redone.
+         */
+        std::size_t undoDepth(void) const { return _undoCommands; }
+        std::size_t redoDepth(void) const { return _redoCommands; }
+
+        void clear(void);
+
+    private:
+        static constexpr std::uint8_t LAST_OF_COMMAND = 1u << 0;
+
+        /*
+         * Description : One state write; 16 bytes, trivially copyable.
+         */
+        struct Entry
+        {
+            Core::CommandCode code;
+            std::uint8_t flags;
+            std::uint16_t reserved;
+            std::uint32_t target;       // Slot in _targets
+            float oldValue;
+            float newValue;
+        };
+
+        std::size_t next(std::size_t position) const { return position + 1 == _ring.size() ? 0 : position + 1; }
+        std::size_t prev(std::size_t position) const { return position == 0 ? _ring.size() - 1 : position - 1; }
+        std::size_t used(void) const { return (_end + _ring.size() - _begin) % _ring.size(); }
+
+        /*
+         * Description : Returns the slot of 'device', adding it if needed.
+         *               Returns false if the owner does not know it.
+         */
+        bool slotOf(Core::IDevice* device, std::uint32_t& slot);
+
+        /*
+         * Description : Drops the oldest command from the ring.
+         */
+        void dropOldest(void);
+
+        /*
+         * Description : Rebuilds the target table from the records still in
+         *               the ring, so it stays proportional to the capacity.
+         */
+        void compactTargets(void);
+
+        /*
+         * Description : Writes 'value' of one entry through its target.
+         */
+        void apply(const Entry& entry, float value, std::vector<Core::CommandRecord>& applied);
+
+        std::vector<Entry> _ring;               // One slot stays empty to tell full from empty
+        std::size_t _begin = 0;                 // Oldest record
+        std::size_t _cursor = 0;                // Records before it are undoable, after it redoable
+        std::size_t _end = 0;                   // One past the newest record
+        std::size_t _undoCommands = 0;
+        std::size_t _redoCommands = 0;
+
+        Owner _owner;
+        std::vector<std::weak_ptr<Core::IDevice>> _targets;
+        std::unordered_map<Core::IDevice*, std::uint32_t> _slotByDevice;
+        Core::IDevice* _lastDevice = nullptr;  // Target of the previous lookup
+        std::uint32_t _lastSlot = 0;
+        std::vector<std::uint32_t> _slots;      // Scratch for push()
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,146 @@
+/******************************************************************************
+ *  MODULE NAME  : Device Registry
+ *  FILE         : DeviceRegistry.hpp
+ *  DESCRIPTION  : Declares the DeviceRegistry class, the controller's flat
+ *                 store of registered devices. Devices live in dense arrays,
+ *                 IDs are interned once and looked up through an
+ *                 open-addressing hash index without allocating.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include "SmartHome/Core/IDevice.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace SmartHome::Controller
+{
+    /******************************************************************************
+     *  CLASS NAME   : DeviceRegistry
+     *  DESCRIPTION  : Owns the registered devices. Lookup by ID is O(1) with
+     *                 linear probing over a power-of-two table. Each device
+     *                 gets a stable handle that survives other devices being
+     *                 added or removed, while iteration stays over a dense
+     *                 array.
+     ******************************************************************************/
+    class DeviceRegistry
+    {
+    public:
+        /*
+         * Description : Stable reference to a registered device. Using a handle
+         *               after its device was removed simply fails.
+         */
+        struct DeviceHandle
+        {
+            std::uint32_t index = 0xFFFFFFFFu;
+            std::uint32_t generation = 0;
+
+            bool isValid() const { return index != 0xFFFFFFFFu; }
+        };
+
+        DeviceRegistry();
+
+        /*
+         * Description : Registers a device under its getID(), which is called
+         *               and interned exactly once. Returns an invalid handle
+         *               for nullptr or an ID that is already registered.
+         */
+        DeviceHandle add(std::shared_ptr<Core::IDevice> device);
+
+        /*
+         * Description : Unregisters a device. Returns false if it is unknown.
+         */
+        bool remove(DeviceHandle handle);
+        bool remove(std::string_view id);
+
+        /*
+         * Description : Looks up a device by ID. Returns an invalid handle if
+         *               no device is registered under it.
+         */
+        DeviceHandle find(std::string_view id) const;
+
+        /*
+         * Description : Returns the device behind a handle, or nullptr if the
+         *               handle is stale.
+         */
+        const std::shared_ptr<Core::IDevice>* get(DeviceHandle handle) const;
+
+        /*
+         * Description : Looks up a device by ID in one step. Returns nullptr
+         *               if no device is registered under it.
+         */
+        const std::shared_ptr<Core::IDevice>* get(std::string_view id) const;
+
+        /*
+         * Description : Returns the interned ID of a handle (empty if stale).
+         */
+        std::string_view idOf(DeviceHandle handle) const;
+
+        /*
+         * Description : Dense view of all registered devices, in no particular order.
+         */
+        const std::vector<std::shared_ptr<Core::IDevice>>& devices() const { return _devices; }
+
+        std::size_t size() const { return _devices.size(); }
+        bool empty() const { return _devices.empty(); }
+
+    private:
+        static constexpr std::uint32_t EMPTY = 0xFFFFFFFFu;
+        static constexpr std::size_t ARENA_BLOCK = 64 * 1024;
+
+        /*
+         * Description : Hash table bucket; 'handle' is EMPTY when unused. The
+         *               interned ID, dense position and generation ride along
+         *               so a lookup touches only the bucket and the ID bytes.
+         */
+        struct Bucket
+        {
+            std::uint32_t hash = 0;
+            std::uint32_t handle = EMPTY;
+            std::uint32_t generation = 0;
+            std::uint32_t dense = 0;
+            std::string_view id;
+        };
+
+        /*
+         * Description : Per-handle bookkeeping. 'dense' is EMPTY while free.
+         */
+        struct Slot
+        {
+            std::uint32_t dense = EMPTY;
+            std::uint32_t generation = 0;
+        };
+
+        static std::uint32_t hashOf(std::string_view id);
+
+        std::string_view intern(std::string_view id);
+        std::size_t probe(std::string_view id, std::uint32_t hash) const;
+        void eraseBucket(std::size_t bucket);
+        void grow();
+        bool resolve(DeviceHandle handle) const;
+
+        // Dense arrays, indexed by the same position
+        std::vector<std::shared_ptr<Core::IDevice>> _devices;
+        std::vector<std::string_view> _ids;
+        std::vector<std::uint32_t> _denseToHandle;
+
+        std::vector<Slot> _slots;                 // Indexed by handle
+        std::vector<std::uint32_t> _freeSlots;    // Recycled handle indices
+
+        std::vector<Bucket> _buckets;             // Open-addressing index, size is a power of two
+        std::size_t _mask = 0;
+
+        std::vector<std::unique_ptr<char[]>> _arena;   // Interned ID storage
+        std::size_t _arenaUsed = ARENA_BLOCK;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
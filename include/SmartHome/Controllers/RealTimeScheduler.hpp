@@ -0,0 +1,146 @@
+/******************************************************************************
+ *  MODULE NAME  : Real-Time Scheduler
+ *  FILE         : RealTimeScheduler.hpp
+ *  DESCRIPTION  : Declares the RealTimeScheduler class, which drives a
+ *                 millisecond timing wheel from steady_clock on a dedicated
+ *                 thread and hands due tasks to an executor.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "SmartHome/Controllers/Scheduler.hpp"
+
+namespace SmartHome::Controller
+{
+    /******************************************************************************
+     *  CLASS NAME   : RealTimeScheduler
+     *  DESCRIPTION  : Wall-clock counterpart of Scheduler. One wheel tick is
+     *                 100 us of steady_clock time, so deadlines are kept well
+     *                 below a millisecond. Deadlines are absolute ticks of
+     *                 the wheel's 64-bit clock, so no delay is truncated and
+     *                 deadlines past 2^32 ticks of uptime (about 4.97 days)
+     *                 fire on time. The timer thread sleeps until the next
+     *                 deadline (no polling), then passes due tasks to the
+     *                 executor so a slow task never delays the timers behind
+     *                 it. All methods are thread-safe, and the executor is
+     *                 called with no scheduler lock held, so it may run tasks
+     *                 inline and those may schedule and cancel.
+     ******************************************************************************/
+    class RealTimeScheduler
+    {
+    public:
+        using ScheduledTask = Scheduler::ScheduledTask;
+        using TimerHandle   = Scheduler::TimerHandle;
+
+        /*
+         * Description : Runs a due task somewhere other than the timer thread,
+         *               e.g. an Executors::ThreadPool.
+         */
+        using Executor = Scheduler::Executor;
+
+        /*
+         * Description : Creates a stopped scheduler.
+         * Parameters  : executor - Receives due tasks. When empty, tasks run
+         *                          on one internal dispatch thread.
+         */
+        explicit RealTimeScheduler(Executor executor = nullptr);
+
+        /*
+         * Description : Stops the threads; pending timers are discarded.
+         */
+        ~RealTimeScheduler();
+
+        RealTimeScheduler(const RealTimeScheduler&) = delete;
+        RealTimeScheduler& operator=(const RealTimeScheduler&) = delete;
+
+        /*
+         * Description : Starts the timer (and dispatch) threads.
+         */
+        void start();
+
+        /*
+         * Description : Stops and joins the threads. Tasks already handed to
+         *               the internal dispatcher finish first.
+         */
+        void stop();
+
+        /*
+         * Description : Schedules a task to run once 'delay' has elapsed.
+         * Parameters  : delay - Time from now (e.g. std::chrono::milliseconds).
+         *               task - The task to execute.
+         */
+        TimerHandle scheduleAfter(std::chrono::microseconds delay, ScheduledTask task);
+
+        /*
+         * Description : Same as above; replaces a task pending under dedupKey.
+         */
+        TimerHandle scheduleAfter(std::chrono::microseconds delay, ScheduledTask task, const std::string& dedupKey);
+
+        /*
+         * Description : Cancels a pending task. Returns false if it already fired.
+         */
+        bool cancel(TimerHandle handle);
+
+        /*
+         * Description : Returns the number of tasks waiting for their deadline.
+         */
+        std::size_t pendingCount() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::chrono::microseconds TICK{100};
+
+        /*
+         * Description : Timer thread: advances the wheel to the current time
+         *               and sleeps until the next deadline.
+         */
+        void timerLoop();
+
+        /*
+         * Description : Internal dispatch thread used when no executor is given.
+         */
+        void dispatchLoop();
+
+        /*
+         * Description : Wheel tick at which 'delay' from now has passed,
+         *               rounded up.
+         */
+        std::uint64_t deadlineTick(std::chrono::microseconds delay) const;
+
+        /*
+         * Description : Wraps a task so that firing only hands it to the executor.
+         */
+        ScheduledTask handOff(ScheduledTask task);
+
+        Scheduler _wheel;                      // Timing wheel in TICK units; locks itself
+        Executor _executor;
+        Clock::time_point _origin;             // Wall time of wheel tick 0
+
+        std::mutex _mutex;                     // Guards _running; pairs with _wake
+        std::condition_variable _wake;         // Signals new earlier deadlines or stop
+        std::thread _timerThread;
+        bool _running = false;
+
+        std::mutex _dispatchMutex;             // Internal dispatcher queue
+        std::condition_variable _dispatchReady;
+        std::deque<ScheduledTask> _dispatchQueue;
+        std::thread _dispatchThread;
+        bool _dispatchRunning = false;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
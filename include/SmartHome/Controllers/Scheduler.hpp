@@ -3,6 +3,7 @@
  *  FILE         : Scheduler.hpp
  *  DESCRIPTION  : Declares the Scheduler class responsible for scheduling 
  *                 and executing delayed tasks within the smart home system.
+ *                 Pending tasks are kept in a hierarchical timing wheel.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : July 2025
  ******************************************************************************/
@@ -10,48 +11,241 @@
 #pragma once
 
 #include <functional>
-#include <queue>
-#include <chrono>
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
 #include <vector>
 
 namespace SmartHome::Controller
 {
+    /******************************************************************************
+     *  CLASS NAME   : Scheduler
+     *  DESCRIPTION  : Runs tasks once their delay has elapsed on the scheduler's
+     *                 simulated clock. Four wheels of 256 slots cover 2^32
+     *                 seconds and later deadlines wait in an overflow list
+     *                 that is re-placed each time the top wheel wraps, so the
+     *                 64-bit clock never loses a timer. Scheduling, cancelling
+     *                 and rescheduling are O(1) and each task is cascaded to a
+     *                 finer wheel at most three times before it fires.
+     *                 All methods are thread-safe; tick() runs each due task
+     *                 with the lock released, so tasks may schedule, cancel
+     *                 and reschedule (including themselves) from any thread.
+     ******************************************************************************/
     class Scheduler
     {
     public:
         using ScheduledTask = std::function<void()>; // Alias for scheduled callable
 
+        /*
+         * Description : Receives due tasks instead of running them inline.
+         */
+        using Executor = std::function<void(ScheduledTask)>;
+
+        /*
+         * Description : Identifies a scheduled task for cancel()/reschedule().
+         *               Stays safe to use after the task fired or was cancelled;
+         *               operations on a stale handle simply return false.
+         */
+        struct TimerHandle
+        {
+            std::uint32_t index = 0xFFFFFFFFu;
+            std::uint32_t generation = 0;
+
+            bool isValid() const { return index != 0xFFFFFFFFu; }
+        };
+
         /*
          * Description : Schedules a task to be executed after the given delay.
          * Parameters  : delaySeconds - Number of seconds to delay execution.
          *               task - The task (lambda or function) to execute.
+         * Returns     : Handle of the pending task (invalid if rejected).
+         */
+        TimerHandle scheduleAfter(int delaySeconds, ScheduledTask task);
+
+        /*
+         * Description : Schedules a task under a deduplication key. A task still
+         *               pending under the same key is replaced in place (new
+         *               delay and callable) and keeps its handle.
+         * Parameters  : delaySeconds - Number of seconds to delay execution.
+         *               task - The task (lambda or function) to execute.
+         *               dedupKey - Key shared by interchangeable timers.
+         */
+        TimerHandle scheduleAfter(int delaySeconds, ScheduledTask task, const std::string& dedupKey);
+
+        /*
+         * Description : Same as scheduleAfter(), at an absolute time on the
+         *               scheduler's clock (see now()) instead of a delay, so
+         *               any 64-bit deadline can be expressed. A time already
+         *               passed runs on the next tick.
+         */
+        TimerHandle scheduleAt(std::uint64_t time, ScheduledTask task);
+        TimerHandle scheduleAt(std::uint64_t time, ScheduledTask task, const std::string& dedupKey);
+
+        /*
+         * Description : Removes a pending task in O(1). Returns false if it has
+         *               already run or been cancelled.
+         */
+        bool cancel(TimerHandle handle);
+
+        /*
+         * Description : Cancels the task pending under a deduplication key.
+         */
+        bool cancel(const std::string& dedupKey);
+
+        /*
+         * Description : Moves a pending task to fire 'delaySeconds' from now, in O(1).
+         */
+        bool reschedule(TimerHandle handle, int delaySeconds);
+
+        /*
+         * Description : Returns true while the task behind the handle is waiting to run.
          */
-        void scheduleAfter(int delaySeconds, ScheduledTask task);
+        bool isPending(TimerHandle handle) const;
 
         /*
          * Description : Advances the scheduler's internal clock and executes any 
-         *               tasks whose scheduled time has elapsed.
+         *               tasks whose scheduled time has elapsed. Driven from
+         *               one thread at a time.
          * Parameters  : secondsElapsed - Number of seconds since last tick.
          */
         void tick(int secondsElapsed);
 
+        /*
+         * Description : Hands due tasks to 'executor' from now on; an empty
+         *               executor restores inline execution inside tick(). Do
+         *               not call while tick() runs. A task handed to another
+         *               thread runs concurrently with tick() and with other
+         *               tasks, so it must guard its own state, and may still
+         *               run after it was cancelled. The automation modes lock
+         *               their state and ignore timers a later activate() or
+         *               deactivate() replaced, so they can run on a
+         *               ThreadPool; the groups they act on must then not
+         *               change meanwhile, and every handed-off task must have
+         *               run before its mode is destroyed.
+         */
+        void setExecutor(Executor executor);
+
+        /*
+         * Description : Returns the number of tasks waiting to run.
+         */
+        std::size_t pendingCount() const;
+
+        /*
+         * Description : Returns the scheduler's clock (time units since start).
+         */
+        std::uint64_t now() const;
+
+        /*
+         * Description : Returns the earliest time at which tick() can have work
+         *               to do (a task is due or a cascade must run), or
+         *               UINT64_MAX when nothing is pending. Lets a driver sleep
+         *               until then instead of polling.
+         */
+        std::uint64_t nextDueTime() const;
+
     private:
-        using TimePoint = int; // Tracks time in seconds since start
+        using TimePoint = std::uint64_t; // Tracks time in seconds since start
+
+        static constexpr unsigned WHEEL_BITS   = 8;
+        static constexpr unsigned WHEEL_SIZE   = 1u << WHEEL_BITS;
+        static constexpr unsigned WHEEL_MASK   = WHEEL_SIZE - 1;
+        static constexpr unsigned WHEEL_LEVELS = 4;
+        static constexpr unsigned OVERFLOW_LEVEL = WHEEL_LEVELS; // 'level' of _overflow entries
+        static constexpr std::uint32_t NIL     = 0xFFFFFFFFu;
 
         struct ScheduledEntry
         {
-            TimePoint executionTime;
+            TimePoint executionTime = 0;
             ScheduledTask task;
+            std::uint32_t next = NIL;    // Next entry in the same slot (or free list)
+            std::uint32_t prev = NIL;    // Previous entry in the same slot
+            std::uint32_t generation = 0; // Bumped on release to invalidate handles
+            bool pending = false;        // In a wheel slot, waiting to run
+            std::uint8_t level = 0;      // Wheel holding the entry, or OVERFLOW_LEVEL
+            std::uint8_t slot = 0;       // Slot within that wheel
+            const std::string* dedupKey = nullptr; // Key node in _byKey, if any
+        };
+
+        struct Slot
+        {
+            std::uint32_t head = NIL;
+            std::uint32_t tail = NIL;
+        };
 
-            // Priority queue comparator (earlier tasks have higher priority)
-            bool operator>(const ScheduledEntry& other) const
-            {
-                return executionTime > other.executionTime;
-            }
+        struct Wheel
+        {
+            std::array<Slot, WHEEL_SIZE> slots;
+            std::array<std::uint64_t, WHEEL_SIZE / 64> occupied{}; // One bit per non-empty slot
         };
 
-        std::priority_queue<ScheduledEntry, std::vector<ScheduledEntry>, std::greater<>> _taskQueue;
-        TimePoint _currentTime = 0; // Internal time tracker in seconds
+        /*
+         * Description : Places an entry in the wheel and slot matching its
+         *               execution time relative to the current time. Like
+         *               every private helper, expects _mutex to be held.
+         */
+        void place(std::uint32_t index);
+
+        /*
+         * Description : Appends / removes an entry to / from a slot list
+         *               (the overflow list when level is OVERFLOW_LEVEL).
+         */
+        void link(unsigned level, unsigned slot, std::uint32_t index);
+        void unlink(unsigned level, unsigned slot, std::uint32_t index);
+
+        /*
+         * Description : Re-places every entry of the coarser wheels whose slot
+         *               starts at the current time, and the overflow list
+         *               when the top wheel wraps.
+         */
+        void cascade();
+
+        /*
+         * Description : Locked parts of the public methods.
+         */
+        TimerHandle scheduleLocked(TimePoint when, ScheduledTask task);
+        TimerHandle scheduleKeyedLocked(TimePoint when, ScheduledTask task, const std::string& dedupKey);
+        bool cancelLocked(TimerHandle handle);
+        bool rescheduleLocked(TimerHandle handle, TimePoint when);
+
+        /*
+         * Description : Runs every entry in the finest wheel's current slot,
+         *               including ones scheduled for "now" by those tasks.
+         *               Unlocks 'lock' around each task.
+         */
+        void runDueSlot(std::unique_lock<std::mutex>& lock);
+
+        /*
+         * Description : Earliest time after now at which the finest wheel has
+         *               work or a cascade is due.
+         */
+        TimePoint nextEventTime() const;
+
+        std::uint32_t allocateEntry();
+        void releaseEntry(std::uint32_t index);
+
+        /*
+         * Description : Returns the entry index if the handle refers to a
+         *               pending task, NIL otherwise.
+         */
+        std::uint32_t resolve(TimerHandle handle) const;
+
+        /*
+         * Description : Returns the list an entry at (level, slot) lives in.
+         */
+        Slot& slotList(unsigned level, unsigned slot);
+
+        mutable std::mutex _mutex;               // Guards everything below
+        std::array<Wheel, WHEEL_LEVELS> _wheels;
+        Slot _overflow;                          // Deadlines beyond the top wheel's rotation
+        std::vector<ScheduledEntry> _entries;    // Entry pool addressed by index
+        std::uint32_t _freeList = NIL;           // Head of the unused entries
+        std::size_t _pending = 0;                // Entries currently in the wheels
+        std::unordered_map<std::string, TimerHandle> _byKey; // Pending tasks by dedup key
+        Executor _executor;                      // Runs due tasks; inline when empty
+        TimePoint _currentTime = 0;              // Internal time tracker in seconds
     };
 }
 
@@ -14,14 +14,21 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <chrono>
+#include <mutex>
 
 #include "SmartHome/Core/IDevice.hpp"
 #include "SmartHome/Core/ICommand.hpp"
 #include "SmartHome/Core/IAutomationMode.hpp"
 #include "SmartHome/Devices/SupportedDevices.hpp"
 #include "SmartHome/Automation/SupportedAutomationModes.hpp"
+#include "SmartHome/Automation/RuleEngine.hpp"
 #include "SmartHome/Commands/SupportedCommands.hpp"
 #include "SmartHome/Controllers/Scheduler.hpp"
+#include "SmartHome/Controllers/RealTimeScheduler.hpp"
+#include "SmartHome/Controllers/DeviceRegistry.hpp"
+#include "SmartHome/Controllers/CommandHistory.hpp"
+#include "SmartHome/Persistence/CommandJournal.hpp"
 #include "SmartHome/Factory/DeviceFactory.hpp"
 
 
@@ -49,22 +56,47 @@ namespace SmartHome
         void run();
 
     private:
-        std::vector<std::shared_ptr<Core::IDevice>> _devices;                     // All registered devices
-        std::shared_ptr<Core::ICommand> _cmd;                                     // All Commands
+        Controller::DeviceRegistry _devices;                                     // All registered devices
+        Commands::CommandPool _commandPool;                                      // Commands of controlDevice/controlGroup; must outlive them
+        Controller::Scheduler _scheduler;                                        // System task scheduler
+        std::chrono::steady_clock::time_point _lastTick;                         // Wall time the scheduler clock matches
+        // Modes and rules journal their writes, so the journal outlives them too
+        Persistence::CommandJournal _journal;                                    // Commands since the last snapshot
+        // Modes use the scheduler, so they are declared after it and destroyed first
         std::vector<std::shared_ptr<Core::IAutomationMode>> _modes;               // All Modes
         std::unordered_map<std::string, std::shared_ptr<Devices::DeviceGroup>>   
             _groups;                                                             // Named device groups
-
-        Controller::Scheduler _scheduler;                                        // System task scheduler
+        Automation::RuleEngine _rules;                                           // Rules loaded from a file
+        Controller::CommandHistory _history;                                     // Undo / redo of user commands
+        std::mutex _stateMutex;                                                  // Held by the menus and the timers while they change state
+        // Its tasks use everything above, so it is declared last and stopped first
+        Controller::RealTimeScheduler _clock;                                    // Advances _scheduler while the CLI waits for input
 
         /*
          *  Description: Enum made to select Automation Modes
          */
         enum Modes
         {
-            SECURITYMODE, ENERGYMODE
+            SECURITYMODE, ENERGYMODE, COMFORTMODE
         };
 
+        static constexpr const char* SNAPSHOT_FILE = "smarthome.snap";         // Saved state, next to the binary
+        static constexpr const char* JOURNAL_FILE = "smarthome.journal";       // Commands not yet in the snapshot
+        static constexpr std::size_t HISTORY_CAPACITY = 1024;                  // State writes kept for undo
+
+
+        /*
+         *  Description: Advances the scheduler by the whole seconds of wall time
+         *               elapsed since the previous call, firing due tasks.
+         *               Runs on _clock's thread, under _stateMutex.
+         */
+        void advanceScheduler();
+
+        /*
+         *  Description: Arms _clock to call advanceScheduler() a second from
+         *               now and re-arm itself.
+         */
+        void armClock();
 
         /*
          *  Description: Displays and handles the main menu options.
@@ -81,6 +113,12 @@ namespace SmartHome
          */
         void addDevice();
 
+        /*
+         *  Description: Prompts for a manifest file and registers the devices
+         *               and groups it describes in one go.
+         */
+        void importManifest();
+
         /*
          *  Description: Lists all registered devices with their statuses.
          */
@@ -130,6 +168,55 @@ namespace SmartHome
          *  Description: Activates energy-saving mode automation.
          */
         void activateEnergySavingMode();
+
+        /*
+         *  Description: Activates comfort mode thermostat control.
+         */
+        void activateComfortMode();
+
+        /*
+         *  Description: Prompts for a rules file and loads it, replacing the
+         *               current rules. Rules refer to devices and groups by ID.
+         */
+        void loadRules();
+
+        /*
+         *  Description: Recompiles the rules if a group they expand changed.
+         *               Call after every change to _groups or a membership.
+         */
+        void refreshRules();
+
+        /*
+         *  Description: Looks up a registered device, then a group, by ID.
+         *               Returns nullptr if neither exists.
+         */
+        std::shared_ptr<Core::IDevice> findTarget(std::string_view id) const;
+
+        /*
+         *  Description: Executes a user command through the journal and
+         *               records it for undo.
+         */
+        void executeJournaled(std::shared_ptr<Core::ICommand> command);
+
+        /*
+         *  Description: Undoes the last user command, or redoes the last
+         *               undone one, and journals the writes.
+         */
+        void undoCommand();
+        void redoCommand();
+
+        /*
+         *  Description: Restores devices and groups from the snapshot file, if
+         *               one exists, replays the journal on top and opens it
+         *               for new commands. Called once at startup.
+         */
+        void restoreState();
+
+        /*
+         *  Description: Writes every device and group to the snapshot file and
+         *               empties the journal it now covers.
+         */
+        void saveSnapshot();
     };
 }
 
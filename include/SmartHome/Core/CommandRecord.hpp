@@ -0,0 +1,54 @@
+/******************************************************************************
+ *  MODULE NAME  : Smart Home - Core - Command Record
+ *  FILE         : CommandRecord.hpp
+ *  DESCRIPTION  : Defines the plain record a command uses to describe the
+ *                 state write it made: which property of which device, and
+ *                 its value before and after. Journals and history keep
+ *                 these instead of the command objects.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace SmartHome::Core
+{
+    class IDevice;
+
+    /*
+     *  Description : Device properties a command can write. Values are
+     *                carried as floats: 0/1 for switches, the enum value
+     *                for modes, the number itself otherwise.
+     */
+    enum class CommandCode : std::uint8_t
+    {
+        POWER,                  // IDevice on/off, groups included
+        BRIGHTNESS,             // DimmableLight brightness, 0..100
+        TARGET_TEMPERATURE,     // Thermostat target in Celsius
+        THERMOSTAT_MODE,        // Thermostat ThermostatMode
+        LOCK,                   // DoorLock locked
+        RECORDING,              // Camera recording
+        NIGHT_VISION,           // Camera night vision
+        THERMOSTAT_LAST_MODE,   // ThermostatMode turnOn() returns to
+        COUNT
+    };
+
+    /******************************************************************************
+     *  STRUCT NAME  : CommandRecord
+     *  DESCRIPTION  : Trivially copyable description of one state write.
+     *                 Applying 'newValue' redoes it, 'oldValue' undoes it.
+     ******************************************************************************/
+    struct CommandRecord
+    {
+        CommandCode code;
+        IDevice* target;
+        float oldValue;
+        float newValue;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,59 @@
+/******************************************************************************
+ *  MODULE NAME  : Smart Home - Core - Device Event
+ *  FILE         : DeviceEvent.hpp
+ *  DESCRIPTION  : Defines the typed, fixed-size events that sensors publish
+ *                 on the EventBus and observers receive.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace SmartHome::Core
+{
+    class IDevice;
+
+    /*
+     *  Description : Kinds of events a sensor can publish.
+     */
+    enum class EventType : std::uint8_t
+    {
+        MOTION,         // state = motion detected
+        LOCK,           // state = door locked
+        TEMPERATURE,    // value = measured temperature in Celsius
+        COUNT
+    };
+
+    /*
+     *  Description : Bitmask of EventTypes used when subscribing.
+     */
+    using EventMask = std::uint32_t;
+
+    constexpr EventMask eventMask(EventType type)
+    {
+        return EventMask{1} << static_cast<unsigned>(type);
+    }
+
+    constexpr EventMask ALL_EVENTS = (EventMask{1} << static_cast<unsigned>(EventType::COUNT)) - 1;
+
+    /******************************************************************************
+     *  STRUCT NAME  : DeviceEvent
+     *  DESCRIPTION  : Trivially copyable event record. 'source' identifies the
+     *                 publishing device; it is only safe to dereference while
+     *                 that device is known to be alive (e.g. still in a group).
+     ******************************************************************************/
+    struct DeviceEvent
+    {
+        EventType type;
+        bool state;                 // Boolean payload (MOTION, LOCK)
+        float value;                // Numeric payload (TEMPERATURE)
+        const IDevice* source;      // Publishing device
+        std::int64_t timestampNs;   // steady_clock time of the change
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include <vector>
+
+#include "SmartHome/Core/CommandRecord.hpp"
+
 namespace SmartHome::Core
 {
 
@@ -30,6 +34,14 @@ public:
      */
     virtual void undo(void) = 0;
 
+    /*
+     *  Description: Appends the state writes made by the last execute(), in
+     *               order. Commands that append nothing are not journaled.
+     *               Targets, codes and new values are valid before the
+     *               first execute() too; old values are not.
+     */
+    virtual void describe(std::vector<CommandRecord>& records) const { (void)records; }
+
     /*
      *  Description: Virtual destructor.
      */
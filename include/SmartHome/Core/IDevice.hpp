@@ -11,9 +11,34 @@
 
 #pragma once
 #include <iostream>
+#include <cstdint>
+
+namespace SmartHome::Persistence
+{
+    class SnapshotCodec;    // Granted access to device state for snapshots
+}
 
 namespace SmartHome::Core
 {
+    /*
+     *  Description : Compact type tag carried by every device. A device tagged
+     *                CAMERA, MOTION_SENSOR, DOOR_LOCK, LIGHT or THERMOSTAT
+     *                derives from BaseCamera, MotionSensor, DoorLock,
+     *                BaseLight or BaseThermostat respectively, so code that
+     *                checked the tag may static_cast instead of using RTTI.
+     */
+    enum class DeviceType : std::uint8_t
+    {
+        LIGHT,
+        THERMOSTAT,
+        DOOR_LOCK,
+        CAMERA,
+        MOTION_SENSOR,
+        GROUP,
+        OTHER,
+        COUNT
+    };
+
     /******************************************************************************
      *  CLASS NAME   : IDevice
      *  DESCRIPTION  : Interface representing a generic smart device. All devices
@@ -47,10 +72,24 @@ namespace SmartHome::Core
              */
             virtual std::string getStatus(void) const = 0;
 
+            /*
+             *  Description : Returns the device's type tag (no virtual call, no RTTI).
+             */
+            DeviceType getType(void) const { return _deviceType; }
+
             /*
              *  Description : Virtual destructor for safe polymorphic destruction.
              */
             virtual ~IDevice(void) = default;
+
+        protected:
+            /*
+             *  Description : Tags the device; untagged devices are OTHER.
+             */
+            explicit IDevice(DeviceType deviceType = DeviceType::OTHER) : _deviceType(deviceType) {}
+
+        private:
+            DeviceType _deviceType;
     };
 }
 
@@ -0,0 +1,40 @@
+/******************************************************************************
+ *  MODULE NAME  : Smart Home - Core - IObserver
+ *  FILE         : IObserver.hpp
+ *  DESCRIPTION  : Defines the interface implemented by anything that wants to
+ *                 receive device events from the EventBus, typically an
+ *                 automation mode.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include "SmartHome/Core/DeviceEvent.hpp"
+
+namespace SmartHome::Core
+{
+    /******************************************************************************
+     *  CLASS NAME   : IObserver
+     *  DESCRIPTION  : Receives events on the EventBus dispatch thread, one at a
+     *                 time and in publish order per producer.
+     ******************************************************************************/
+    class IObserver
+    {
+        public:
+            /*
+             *  Description : Handles one event. Must not subscribe or unsubscribe
+             *                from inside the callback.
+             */
+            virtual void onEvent(const DeviceEvent& event) = 0;
+
+            /*
+             *  Description : Virtual destructor for safe polymorphic destruction.
+             */
+            virtual ~IObserver(void) = default;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
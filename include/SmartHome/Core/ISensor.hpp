@@ -0,0 +1,38 @@
+/******************************************************************************
+ *  MODULE NAME  : Smart Home - Core - ISensor
+ *  FILE         : ISensor.hpp
+ *  DESCRIPTION  : Defines the interface of devices that publish state changes
+ *                 as DeviceEvents instead of waiting to be polled.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include "SmartHome/Core/DeviceEvent.hpp"
+
+namespace SmartHome::Core
+{
+    /******************************************************************************
+     *  CLASS NAME   : ISensor
+     *  DESCRIPTION  : A device that publishes events on the EventBus whenever
+     *                 the state it senses changes.
+     ******************************************************************************/
+    class ISensor
+    {
+        public:
+            /*
+             *  Description : Returns the event types this sensor publishes.
+             */
+            virtual EventMask publishedEvents(void) const = 0;
+
+            /*
+             *  Description : Virtual destructor for safe polymorphic destruction.
+             */
+            virtual ~ISensor(void) = default;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
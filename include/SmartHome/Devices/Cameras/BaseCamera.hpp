@@ -10,6 +10,7 @@
 #pragma once
 
 #include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Utils/DeviceStoreManager.hpp"
 
 namespace SmartHome::Devices::Cameras
 {
@@ -86,20 +87,11 @@ namespace SmartHome::Devices::Cameras
             virtual bool isNightVisionEnabled(void) final;
 
         protected:
-            /*
-             *  Description : Enum representing Camera levels (either OFF or ON).
-             */
-            enum class CameraState
-            {
-                ON,
-                OFF
-            };
+            friend class SmartHome::Persistence::SnapshotCodec;   // Saves and restores the state below
 
             std::string _id;                // Unique identifier for the camera
             std::string _type;              // Type/model of the camera
-            bool _isRecording;              // Recording status flag
-            bool _nightVisionEnabled;       // Night vision status flag
-            CameraState _state;             // Current state of the camera
+            Utils::DeviceStoreManager::Row _store; // Power, recording and night vision live in the state store
     };
 }
 
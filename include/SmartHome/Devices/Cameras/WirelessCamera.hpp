@@ -49,6 +49,8 @@ namespace SmartHome::Devices::Cameras
             void setCharging(bool isConnected);
 
         protected:
+            friend class SmartHome::Persistence::SnapshotCodec;   // Saves and restores the state below
+
             bool _isCharging;          // Flag indicating if camera is charging
             int _batteryPercentage;    // Current battery level (0-100%)
     };
@@ -10,7 +10,15 @@
 #pragma once
 
 #include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Executors/ThreadPool.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <unordered_map>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace SmartHome::Devices
 {
@@ -29,9 +37,14 @@ namespace SmartHome::Devices
             DeviceGroup(std::string groupName);
 
             /*
-            *  Description: Adds a device to the group.
+            *  Description: Adds a device to the group; the group shares ownership.
             */
-            bool addDevice(IDevice* device);
+            bool addDevice(std::shared_ptr<IDevice> device);
+
+            /*
+            *  Description: Makes room for 'count' members, for bulk adds.
+            */
+            void reserve(std::size_t count);
 
             /*
             *  Description: removes a device from the group by ID.
@@ -43,6 +56,13 @@ namespace SmartHome::Devices
             */
             std::string getID(void) const override;
 
+            /*
+            *  Description: Lets turnOn()/turnOff()/isOn() fan out over 'pool'
+            *               once the group has at least 'threshold' devices.
+            *               Pass nullptr to go back to serial iteration.
+            */
+            void setExecutor(Executors::ThreadPool* pool, std::size_t threshold = 256);
+
             /*
             *  Description: Turns on all devices in the group.
             */
@@ -68,11 +88,56 @@ namespace SmartHome::Devices
              */
             const std::unordered_map<std::string, std::shared_ptr<IDevice>>& getDevices() const;
 
+            /*
+             *  Description: Returns the members carrying 'type', kept up to date
+             *               on add and remove, so no scan or cast is needed.
+             */
+            const std::vector<std::shared_ptr<IDevice>>& devicesOfType(Core::DeviceType type) const;
+
+            /*
+             *  Description: Returns one member carrying 'type' in O(1), or
+             *               nullptr if the group has none.
+             */
+            IDevice* firstOfType(Core::DeviceType type) const;
+
+            /*
+             *  Description: Membership revision, bumped on every add and remove,
+             *               so callers can tell whether a cached view is stale.
+             */
+            std::uint64_t revision() const { return _revision; }
+
         
         private:
+            /*
+            *  Description: Applies 'action' to every device, in parallel chunks
+            *               when an executor is set and the group is large enough.
+            */
+            void forEachDevice(void (IDevice::*action)(void));
+
+            /*
+            *  Description: True when calls should fan out over the executor.
+            */
+            bool useFanout(void) const;
+
+            /*
+            *  Description: Runs 'body(begin, end)' over chunks of the dense
+            *               member list on the executor and waits for all.
+            */
+            void forEachChunk(const std::function<void(std::size_t, std::size_t)>& body);
+
             std::unordered_map<std::string, std::shared_ptr<IDevice>> _devices;    // Collection of device pointers in the group
             std::string _groupName;            // Optional: name for the group (unused yet)
 
+            Executors::ThreadPool* _pool = nullptr;   // Fan-out executor, if any
+            std::size_t _parallelThreshold = 256;     // Minimum size for fan-out
+            std::vector<IDevice*> _fanout;            // Dense member list for chunking
+            bool _fanoutDirty = true;                 // Rebuild _fanout after membership changes
+            std::uint64_t _revision = 0;              // Bumped on membership changes
+
+            // Members indexed by type tag
+            std::array<std::vector<std::shared_ptr<IDevice>>,
+                       static_cast<std::size_t>(Core::DeviceType::COUNT)> _byType;
+
     };
 
 } // namespace SmartHome::Devices
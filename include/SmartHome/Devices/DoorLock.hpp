@@ -11,6 +11,8 @@
 #pragma once
 
 #include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Core/ISensor.hpp"
+#include "SmartHome/Utils/DeviceStoreManager.hpp"
 #include <unordered_set>
 #include <string>
 #include <algorithm>
@@ -22,7 +24,7 @@ namespace SmartHome::Devices
      *  DESCRIPTION  : Represents a smart door lock that supports multiple
      *                 authentication methods and integrates into the SmartHome system.
      ******************************************************************************/
-    class DoorLock : public SmartHome::Core::IDevice
+    class DoorLock : public SmartHome::Core::IDevice, public SmartHome::Core::ISensor
     {
     public:
         /*
@@ -40,6 +42,11 @@ namespace SmartHome::Devices
          */
         std::string getStatus(void) const override;
 
+        /*
+         *  Description: Publishes LOCK events.
+         */
+        SmartHome::Core::EventMask publishedEvents(void) const override;
+
         /*
          *  Description: Unlocks the door.
          */
@@ -68,7 +75,7 @@ namespace SmartHome::Devices
         /*
          * Returns true if the door is currently locked.
          */
-        bool isDoorLocked(void);
+        bool isDoorLocked(void) const;
 
         /*
          *  Description: Allows user to change the keypad PIN code.
@@ -111,9 +118,17 @@ namespace SmartHome::Devices
         bool removePhoneToken(const std::string& token);
 
     private:
+        friend class SmartHome::Persistence::SnapshotCodec;   // Saves and restores the state below
+
+        /*
+         *  Description: Writes the lock state to the state store and publishes
+         *               a LOCK event when it changes.
+         */
+        void setLocked(bool locked);
+
         std::string _id;                             // Unique device ID
         std::string _type;                           // Device type
-        bool _isLocked;                              // Lock status
+        Utils::DeviceStoreManager::Row _store;       // Lock status lives in the state store
 
         std::string _pinCode;               // Default keypad PIN
         std::unordered_set<std::string> _authorizedCards;   // Set of valid card IDs
@@ -16,6 +16,7 @@
  *  INCLUDES
  ******************************************************************************/
 #include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Utils/DeviceStoreManager.hpp"
 
 namespace SmartHome::Devices::Lights
 {
@@ -63,20 +64,13 @@ namespace SmartHome::Devices::Lights
             std::string getStatus(void) const override;
 
         protected:
-            /*
-             *  Description : Enum representing light levels (either OFF or ON).
-             */
-            enum class LightState
-            {
-                OFF, 
-                ON
-            };
+            friend class SmartHome::Persistence::SnapshotCodec;   // Saves and restores the state below
 
             std::string _id;  // Unique identifier for the light device
 
             std::string _type; // identifies the lights model type
 
-            LightState _state; // identify the current state of the light
+            Utils::DeviceStoreManager::Row _store; // On/off and brightness live in the state store
     };
 }
 
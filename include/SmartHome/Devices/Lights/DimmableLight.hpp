@@ -48,6 +48,7 @@ namespace SmartHome::Devices::Lights
 
             /*
              *  Description : Returns the current status of the dimmable light as a string.
+             *                Brightness 1-99 reads as DIMMED, 100 as ON, 0 as OFF.
              */
             std::string getStatus(void) const override;
 
@@ -62,22 +63,6 @@ namespace SmartHome::Devices::Lights
              *                Expected range: [0-100]
              */
             int getBrightness(void) const;
-
-        protected:
-            /*
-             *  Description : Enum representing light state (ON, DIMMED, OFF).
-             */
-            enum class LightState
-            {
-                ON,
-                DIMMED_LOW,
-                DIMMED_HIGH,
-                OFF
-            };
-
-            int _brightness;  // Brightness level (0-100)
-
-            LightState _state; // Identify the current state of the light
     };
 }
 
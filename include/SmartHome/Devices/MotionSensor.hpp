@@ -10,10 +10,12 @@
 #pragma once
 
 #include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Core/ISensor.hpp"
+#include "SmartHome/Utils/DeviceStoreManager.hpp"
 
 namespace SmartHome::Devices::Sensors
 {
-    class MotionSensor : public Core::IDevice
+    class MotionSensor : public Core::IDevice, public Core::ISensor
     {
     public:
         /*
@@ -46,20 +48,27 @@ namespace SmartHome::Devices::Sensors
          */
         std::string getStatus(void) const override;
 
+        /*
+         *  Description: Publishes MOTION events.
+         */
+        Core::EventMask publishedEvents(void) const override;
+
         /*
          *  Description: Returns true if motion is currently detected.
          */
         bool isMotionDetected(void) const;
 
         /*
-         *  Description: Sets whether the sensor is detecting motion.
+         *  Description: Sets whether the sensor is detecting motion and
+         *               publishes a MOTION event when the state changes.
          */
         void setMotionDetected(bool detected);
 
     private:
+        friend class SmartHome::Persistence::SnapshotCodec;   // Saves and restores the state below
+
         std::string _id;          // Unique identifier of the sensor
-        bool _isOn = false;       // Power state
-        bool _motionDetected = false;  // Motion detection state
+        Utils::DeviceStoreManager::Row _store;  // Power and motion flags live in the state store
     };
 }
 
@@ -9,6 +9,8 @@
 #pragma once
 
 #include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Core/ISensor.hpp"
+#include "SmartHome/Utils/DeviceStoreManager.hpp"
 
 namespace SmartHome::Devices::Thermostats
 {
@@ -17,7 +19,7 @@ namespace SmartHome::Devices::Thermostats
      *  DESCRIPTION  : Represents a basic smart thermostat with temperature control
      *                 capabilities. Implements the IDevice interface.
      ******************************************************************************/
-    class BaseThermostat : public SmartHome::Core::IDevice
+    class BaseThermostat : public SmartHome::Core::IDevice, public SmartHome::Core::ISensor
     {
         public:
             /*
@@ -64,6 +66,11 @@ namespace SmartHome::Devices::Thermostats
             */
             std::string getStatus(void) const override;
 
+            /*
+            *  Description : Publishes TEMPERATURE events.
+            */
+            SmartHome::Core::EventMask publishedEvents(void) const override;
+
             /*
             *  Description : Sets the target temperature.
             *  Parameters  : 
@@ -103,12 +110,34 @@ namespace SmartHome::Devices::Thermostats
             */
             virtual ThermostatMode getMode(void) const;
 
+            /*
+            *  Description : Gets / sets the mode turnOn() returns to. Set
+            *                as is, without converting; used to restore a
+            *                captured state, since turnOff() overwrites it.
+            */
+            ThermostatMode getLastMode(void) const;
+            void setLastMode(ThermostatMode mode);
+
+            /*
+            *  Description : Tells whether the device can run in 'mode' as
+            *                requested rather than converting it.
+            *  Returns     : true for every mode on a base thermostat (bool)
+            */
+            virtual bool supportsMode(ThermostatMode mode) const;
+
         protected:
+            friend class SmartHome::Persistence::SnapshotCodec;   // Saves and restores the state below
+
+            /*
+            *  Description : Stores the operation mode and mirrors its on/off
+            *                state into the state store.
+            */
+            void applyMode(ThermostatMode mode);
+
             std::string _id;                // Unique identifier
             std::string _type;              // Thermostat model/type
-            float _targetTemperature;       // Desired temperature setting
-            float _currentTemperature;      // Current ambient temperature
-            ThermostatMode _mode;           // Current operation mode
+            Utils::DeviceStoreManager::Row _store; // On/off and temperatures live in the state store
+            ThermostatMode _mode = ThermostatMode::OFF;  // Current operation mode
             ThermostatMode _lastModeUsed;   // Latest operation mode made by User
 
         private:
@@ -46,6 +46,12 @@ namespace SmartHome::Devices::Thermostats
          *  Returns     : Current mode (ThermostatMode)
          */
         ThermostatMode getMode(void) const override;
+
+        /*
+         *  Description : A cooler cannot run in HEATING mode.
+         *  Returns     : false for HEATING, true otherwise (bool)
+         */
+        bool supportsMode(ThermostatMode mode) const override;
     };
 }
 
@@ -42,6 +42,12 @@ namespace SmartHome::Devices::Thermostats
          *  Returns     : Current mode (ThermostatMode)
          */
         ThermostatMode getMode(void) const override;
+
+        /*
+         *  Description : A heater cannot run in COOLING mode.
+         *  Returns     : false for COOLING, true otherwise (bool)
+         */
+        bool supportsMode(ThermostatMode mode) const override;
     };
 }
 
@@ -0,0 +1,125 @@
+/******************************************************************************
+ *  MODULE NAME  : Event Bus
+ *  FILE         : EventBus.hpp
+ *  DESCRIPTION  : Declares the EventBus, the publish/subscribe hub between
+ *                 sensors and automation modes. Sensors publish DeviceEvents
+ *                 into a lock-free MPSC queue; a dispatch thread delivers
+ *                 them to the observers subscribed to their type.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include "SmartHome/Core/DeviceEvent.hpp"
+#include "SmartHome/Core/IObserver.hpp"
+#include "SmartHome/Events/EventQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace SmartHome::Events
+{
+    /******************************************************************************
+     *  CLASS NAME   : EventBus
+     *  DESCRIPTION  : Process-wide event hub. publish() never blocks and never
+     *                 allocates; it is skipped entirely for event types nobody
+     *                 subscribed to. Delivery happens on the dispatch thread
+     *                 (start()) or on whoever calls dispatchPending().
+     ******************************************************************************/
+    class EventBus
+    {
+    public:
+        static constexpr std::size_t QUEUE_CAPACITY = 4096;
+
+        /*
+         * Description : Returns the singleton instance of EventBus.
+         */
+        static EventBus& getInstance();
+
+        ~EventBus();
+
+        EventBus(const EventBus&) = delete;
+        EventBus& operator=(const EventBus&) = delete;
+
+        /*
+         * Description : Delivers events whose type is in 'mask' to 'observer'.
+         *               Subscribing again replaces the mask.
+         */
+        void subscribe(Core::IObserver* observer, Core::EventMask mask);
+
+        /*
+         * Description : Stops delivery to 'observer'. Once this returns the
+         *               observer is not running and will not be called again,
+         *               so it may be destroyed.
+         */
+        void unsubscribe(Core::IObserver* observer);
+
+        /*
+         * Description : Queues an event for delivery. Lock-free and safe from
+         *               any thread. Returns false if nobody listens to its
+         *               type or the queue is full.
+         */
+        bool publish(const Core::DeviceEvent& event);
+
+        /*
+         * Description : Starts / stops the dispatch thread. stop() delivers
+         *               whatever is still queued before returning.
+         */
+        void start();
+        void stop();
+        bool isRunning() const;
+
+        /*
+         * Description : Delivers queued events on the calling thread and
+         *               returns how many were delivered. For use without the
+         *               dispatch thread.
+         */
+        std::size_t dispatchPending();
+
+        /*
+         * Description : Number of events lost to a full queue.
+         */
+        std::uint64_t droppedCount() const;
+
+        /*
+         * Description : steady_clock timestamp used for DeviceEvent::timestampNs.
+         */
+        static std::int64_t nowNs();
+
+    private:
+        EventBus();
+
+        /*
+         * Description : Dispatch thread body: drain, then sleep until a
+         *               producer signals new work.
+         */
+        void dispatchLoop();
+
+        std::size_t drain();
+
+        EventQueue _queue;
+        std::atomic<Core::EventMask> _listening{0};   // Union of subscriber masks
+
+        std::mutex _subscribersMutex;                 // Held while delivering
+        std::vector<std::pair<Core::IObserver*, Core::EventMask>> _subscribers;
+        std::mutex _consumerMutex;                    // Keeps the queue single-consumer
+
+        std::thread _dispatcher;
+        std::atomic<bool> _running{false};
+        std::atomic<bool> _sleeping{false};           // Dispatcher is (about to be) waiting
+        std::mutex _wakeMutex;
+        std::condition_variable _wake;
+        bool _stopRequested = false;                  // Guarded by _wakeMutex
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
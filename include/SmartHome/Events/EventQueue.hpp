@@ -0,0 +1,133 @@
+/******************************************************************************
+ *  MODULE NAME  : Event Queue
+ *  FILE         : EventQueue.hpp
+ *  DESCRIPTION  : Declares the bounded lock-free multi-producer/single-
+ *                 consumer queue that carries DeviceEvents from publishing
+ *                 sensors to the EventBus dispatch thread.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include "SmartHome/Core/DeviceEvent.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace SmartHome::Events
+{
+    /******************************************************************************
+     *  CLASS NAME   : EventQueue
+     *  DESCRIPTION  : Array of cells, each stamped with a sequence number.
+     *                 Producers claim a cell with one CAS on the tail and
+     *                 publish it by bumping the cell's sequence, so producers
+     *                 never block each other or the consumer. A full queue
+     *                 rejects the event instead of waiting.
+     ******************************************************************************/
+    class EventQueue
+    {
+    public:
+        /*
+         * Description : Creates a queue holding 'capacity' events; rounded up
+         *               to the next power of two.
+         */
+        explicit EventQueue(std::size_t capacity)
+        {
+            std::size_t rounded = 1;
+            while (rounded < capacity)
+                rounded <<= 1;
+
+            _mask = rounded - 1;
+            _cells = std::make_unique<Cell[]>(rounded);
+            for (std::size_t i = 0; i < rounded; ++i)
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        /*
+         * Description : Producer side, any thread. Returns false if full.
+         */
+        bool push(const Core::DeviceEvent& event)
+        {
+            std::size_t position = _tail.load(std::memory_order_relaxed);
+            Cell* cell;
+
+            for (;;)
+            {
+                cell = &_cells[position & _mask];
+                const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const std::intptr_t lag = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+                if (lag == 0)
+                {
+                    if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (lag < 0)
+                {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    position = _tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->event = event;
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /*
+         * Description : Consumer side, one thread only. Returns false if empty.
+         */
+        bool pop(Core::DeviceEvent& event)
+        {
+            Cell& cell = _cells[_head & _mask];
+            if (cell.sequence.load(std::memory_order_acquire) != _head + 1)
+                return false;
+
+            event = cell.event;
+            cell.sequence.store(_head + _mask + 1, std::memory_order_release);
+            ++_head;
+            return true;
+        }
+
+        /*
+         * Description : Consumer side. True if there is nothing to pop.
+         */
+        bool empty() const
+        {
+            return _cells[_head & _mask].sequence.load(std::memory_order_acquire) != _head + 1;
+        }
+
+        /*
+         * Description : Number of events rejected because the queue was full.
+         */
+        std::uint64_t droppedCount() const
+        {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence{0};
+            Core::DeviceEvent event{};
+        };
+
+        std::unique_ptr<Cell[]> _cells;
+        std::size_t _mask = 0;
+
+        alignas(64) std::atomic<std::size_t> _tail{0};   // Shared by producers
+        alignas(64) std::size_t _head = 0;               // Consumer only
+        alignas(64) std::atomic<std::uint64_t> _dropped{0};
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,155 @@
+/******************************************************************************
+ *  MODULE NAME  : Thread Pool Executor
+ *  FILE         : ThreadPool.hpp
+ *  DESCRIPTION  : Declares the ThreadPool class, a fixed-size work-stealing
+ *                 executor with one task deque per worker, and TaskGroup for
+ *                 joining on a batch of submitted tasks.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SmartHome::Executors
+{
+    /******************************************************************************
+     *  CLASS NAME   : ThreadPool
+     *  DESCRIPTION  : Tasks submitted from a worker go to the bottom of that
+     *                 worker's deque and are popped LIFO (cache-warm); tasks
+     *                 submitted from other threads are spread round-robin.
+     *                 Idle workers steal from the top of other deques before
+     *                 sleeping.
+     ******************************************************************************/
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        /*
+         * Description : Starts 'threadCount' workers (hardware concurrency if 0).
+         */
+        explicit ThreadPool(std::size_t threadCount = 0);
+
+        /*
+         * Description : Runs every queued task, then joins the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /*
+         * Description : Queues a task for execution on a worker.
+         */
+        void submit(Task task);
+
+        /*
+         * Description : Runs one queued task on the calling thread, if any.
+         *               Used by waiters so that joining never idles a thread.
+         * Returns     : true if a task was run.
+         */
+        bool runPendingTask();
+
+        /*
+         * Description : Blocks until every submitted task has finished.
+         */
+        void waitIdle();
+
+        /*
+         * Description : Number of worker threads.
+         */
+        std::size_t size() const;
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        /*
+         * Description : Worker main loop.
+         */
+        void workerLoop(std::size_t index);
+
+        /*
+         * Description : Pops from the bottom of the own deque, else steals from
+         *               the top of the others. 'self' is npos for non-workers.
+         */
+        bool takeTask(std::size_t self, Task& task);
+
+        /*
+         * Description : Runs a task and updates the in-flight bookkeeping.
+         *               Exceptions escaping a plain submit() are discarded.
+         */
+        void runTask(Task& task);
+
+        static constexpr std::size_t NOT_A_WORKER = static_cast<std::size_t>(-1);
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+        std::vector<std::thread> _threads;
+        std::atomic<std::size_t> _nextWorker{0};   // Round-robin target for external submits
+        std::atomic<std::size_t> _queued{0};       // Tasks sitting in deques
+        std::atomic<std::size_t> _inFlight{0};     // Tasks submitted and not yet finished
+
+        std::mutex _sleepMutex;
+        std::condition_variable _workAvailable;    // Wakes sleeping workers
+        std::condition_variable _idle;             // Signals waitIdle()
+        bool _stopping = false;
+    };
+
+    /******************************************************************************
+     *  CLASS NAME   : TaskGroup
+     *  DESCRIPTION  : Tracks a batch of tasks submitted to a pool so the caller
+     *                 can wait for exactly those. wait() helps run queued tasks,
+     *                 so it is safe to call from inside a pool task, and
+     *                 rethrows the first exception thrown by a group task.
+     ******************************************************************************/
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(ThreadPool& pool);
+
+        /*
+         * Description : Waits for the outstanding tasks before destruction.
+         */
+        ~TaskGroup();
+
+        /*
+         * Description : Submits a task that belongs to this group.
+         */
+        void run(ThreadPool::Task task);
+
+        /*
+         * Description : Returns once every task of the group has finished.
+         */
+        void wait();
+
+    private:
+        struct State
+        {
+            std::atomic<std::size_t> outstanding{0};
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr error;           // First exception thrown by a task
+        };
+
+        ThreadPool& _pool;
+        std::shared_ptr<State> _state;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
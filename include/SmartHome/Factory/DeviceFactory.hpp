@@ -2,23 +2,33 @@
  *  MODULE NAME  : Device Factory
  *  FILE         : DeviceFactory.hpp
  *  DESCRIPTION  : Implements a Singleton-based factory to create device instances
- *                 dynamically using registered creator functions.
+ *                 from "TYPE::VARIANT" keys. Built-in models are registered at
+ *                 compile time (see DeviceRegistration.hpp); other creators
+ *                 can be registered at run time.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : July 2025
  ******************************************************************************/
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <functional>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 #include "SmartHome/Core/IDevice.hpp"
 
 namespace SmartHome::Factory
 {
+    /*
+     * Description : Keys are compared after normalization: letters are upper
+     *               cased and white space is ignored, so "light :: dimmable"
+     *               finds "LIGHT::DIMMABLE". Built-in keys are found through
+     *               a perfect hash computed at compile time; no lookup
+     *               allocates.
+     */
     class DeviceFactory
     {
     public:
@@ -33,37 +43,60 @@ namespace SmartHome::Factory
         /*
          * Description: Registers a device creator function with a string key.
          * Example key format: "LIGHT::LED"
+         * Throws std::invalid_argument if the key is empty or names a built-in
+         * model; registering a custom key again replaces its creator.
          */
-        void registerCreator(const std::string& key, CreatorFunc creator);
+        void registerCreator(std::string_view key, CreatorFunc creator);
 
         /*
          * Description: Creates a new device instance from the registered key.
          * Throws std::invalid_argument if key is not registered.
          */
         std::shared_ptr<Core::IDevice> createDevice(
-            const std::string& key,
+            std::string_view key,
             const std::string& id,
             const std::string& type
         ) const;
 
         /*
-         * Description: Returns a list of all registered device keys.
+         * Description: Creates one device per id, all of the same model and
+         * type, resolving the key once.
+         * Throws std::invalid_argument if key is not registered.
+         */
+        std::vector<std::shared_ptr<Core::IDevice>> createDevices(
+            std::string_view key,
+            const std::vector<std::string>& ids,
+            const std::string& type
+        ) const;
+
+        /*
+         * Description: Returns a list of all registered device keys, built-in
+         * models first.
          */
         std::vector<std::string> listSupportedDevices() const;
 
         /*
-         * Description: Normalizes the key for registration and lookup.
-         * Input example: "light::led" → "LIGHT::LED"
+         * Description: Normalizes the key for display and registration.
+         * Input example: "light :: led" → "LIGHT::LED"
          */
-        std::string makeKey(const std::string& raw) const;
+        static std::string makeKey(std::string_view raw);
 
         /*
          * Description: Checks whether a creator for the given key is registered.
          */
-        bool isRegistered(const std::string& key) const;
+        bool isRegistered(std::string_view key) const;
 
     private:
-        std::unordered_map<std::string, CreatorFunc> _creators;
+        struct CustomCreator
+        {
+            std::uint32_t hash;     // Of the normalized key
+            std::string key;        // Normalized
+            CreatorFunc creator;
+        };
+
+        const CustomCreator* findCustom(std::string_view key) const;
+
+        std::vector<CustomCreator> _custom;
 
         // Private constructor for Singleton
         DeviceFactory() = default;
@@ -0,0 +1,133 @@
+/******************************************************************************
+ *  MODULE NAME  : Device Registration
+ *  FILE         : DeviceRegistration.hpp
+ *  DESCRIPTION  : Central registration point of the built-in device models.
+ *                 Each model gets a DeviceTraits specialization giving its
+ *                 factory key and how to construct it, and is listed once in
+ *                 BuiltInDevices; the DeviceFactory builds its lookup table
+ *                 from that list at compile time.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+
+namespace SmartHome::Factory
+{
+    /*
+     * Description : Specialize for a device class to make it a built-in
+     *               model. KEY must already be normalized ("TYPE::VARIANT",
+     *               upper case, no spaces); create() takes (id, type).
+     */
+    template <typename Device>
+    struct DeviceTraits;
+
+    /*
+     * Description : Construction shared by models whose constructor is
+     *               (id, type).
+     */
+    template <typename Device>
+    struct DefaultConstruct
+    {
+        static std::shared_ptr<Core::IDevice> create(const std::string& id, const std::string& type)
+        {
+            return std::make_shared<Device>(id, type);
+        }
+    };
+
+    // Lights
+    template <>
+    struct DeviceTraits<Devices::Lights::BaseLight> : DefaultConstruct<Devices::Lights::BaseLight>
+    {
+        static constexpr std::string_view KEY = "LIGHT::BASIC";
+    };
+
+    template <>
+    struct DeviceTraits<Devices::Lights::DimmableLight> : DefaultConstruct<Devices::Lights::DimmableLight>
+    {
+        static constexpr std::string_view KEY = "LIGHT::DIMMABLE";
+    };
+
+    // Cameras
+    template <>
+    struct DeviceTraits<Devices::Cameras::BaseCamera> : DefaultConstruct<Devices::Cameras::BaseCamera>
+    {
+        static constexpr std::string_view KEY = "CAMERA::BASIC";
+    };
+
+    template <>
+    struct DeviceTraits<Devices::Cameras::WirelessCamera>
+    {
+        static constexpr std::string_view KEY = "CAMERA::WIRELESS";
+
+        // New wireless cameras ship fully charged and unplugged
+        static std::shared_ptr<Core::IDevice> create(const std::string& id, const std::string& type)
+        {
+            return std::make_shared<Devices::Cameras::WirelessCamera>(id, type, 100, false);
+        }
+    };
+
+    // Thermostats
+    template <>
+    struct DeviceTraits<Devices::Thermostats::BaseThermostat> : DefaultConstruct<Devices::Thermostats::BaseThermostat>
+    {
+        static constexpr std::string_view KEY = "THERMOSTAT::BASIC";
+    };
+
+    template <>
+    struct DeviceTraits<Devices::Thermostats::CoolerThermostat> : DefaultConstruct<Devices::Thermostats::CoolerThermostat>
+    {
+        static constexpr std::string_view KEY = "THERMOSTAT::COOLER";
+    };
+
+    template <>
+    struct DeviceTraits<Devices::Thermostats::HeaterThermostat> : DefaultConstruct<Devices::Thermostats::HeaterThermostat>
+    {
+        static constexpr std::string_view KEY = "THERMOSTAT::HEATER";
+    };
+
+    // Other devices
+    template <>
+    struct DeviceTraits<Devices::DoorLock> : DefaultConstruct<Devices::DoorLock>
+    {
+        static constexpr std::string_view KEY = "LOCK::DOOR";
+    };
+
+    template <>
+    struct DeviceTraits<Devices::Sensors::MotionSensor>
+    {
+        static constexpr std::string_view KEY = "SENSOR::MOTION";
+
+        // A motion sensor has no subtype
+        static std::shared_ptr<Core::IDevice> create(const std::string& id, const std::string&)
+        {
+            return std::make_shared<Devices::Sensors::MotionSensor>(id);
+        }
+    };
+
+    /*
+     * Description : Every built-in model, in the order they are listed.
+     */
+    using BuiltInDevices = std::tuple<
+        Devices::Lights::BaseLight,
+        Devices::Lights::DimmableLight,
+        Devices::Cameras::BaseCamera,
+        Devices::Cameras::WirelessCamera,
+        Devices::Thermostats::BaseThermostat,
+        Devices::Thermostats::CoolerThermostat,
+        Devices::Thermostats::HeaterThermostat,
+        Devices::DoorLock,
+        Devices::Sensors::MotionSensor>;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,184 @@
+/******************************************************************************
+ *  MODULE NAME  : Persistence
+ *  FILE         : CommandJournal.hpp
+ *  DESCRIPTION  : Declares the CommandJournal, an append-only write-ahead log
+ *                 of the state writes made by executed commands. Records are
+ *                 CRC-protected and made durable in groups by a background
+ *                 committer; on startup the journal is replayed on top of
+ *                 the last snapshot.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "SmartHome/Core/CommandRecord.hpp"
+#include "SmartHome/Core/IDevice.hpp"
+
+namespace SmartHome::Persistence
+{
+    /*
+     *  Description : How appended records reach the disk.
+     */
+    enum class SyncPolicy
+    {
+        EVERY_RECORD,   // append() writes and fsyncs before returning
+        GROUP_COMMIT    // a committer thread writes and fsyncs batches
+    };
+
+    /*
+     *  Description : Tuning of a journal. With GROUP_COMMIT a record is on
+     *                disk at most 'maxDelay' (plus one fsync) after append(),
+     *                sooner if someone waits for it or the batch fills up.
+     */
+    struct JournalOptions
+    {
+        SyncPolicy policy = SyncPolicy::GROUP_COMMIT;
+        std::chrono::microseconds maxDelay{2000};
+        std::size_t maxBatchBytes = 64 * 1024;
+    };
+
+    /******************************************************************************
+     *  CLASS NAME   : CommandJournal
+     *  DESCRIPTION  : Each record is [crc32c | length | lsn | code | target id
+     *                 length | old value | new value | target id]. Records get
+     *                 increasing log sequence numbers (LSNs); durableLsn() is
+     *                 the last one known to be on disk. A torn or corrupt
+     *                 tail is cut off when the journal is opened.
+     *                 append() and waitDurable() are thread-safe.
+     ******************************************************************************/
+    class CommandJournal
+    {
+    public:
+        /*
+         *  Description : Finds the device or group a replayed record targets
+         *                by ID; nullptr skips the record.
+         */
+        using Resolver = std::function<std::shared_ptr<Core::IDevice>(std::string_view)>;
+
+        /*
+         *  Description : Outcome of a replay.
+         */
+        struct ReplayResult
+        {
+            std::size_t applied = 0;        // Records written to their device
+            std::size_t skipped = 0;        // Unknown target or mismatched property
+            std::uint64_t lastLsn = 0;      // LSN of the last valid record
+            std::uint64_t tornBytes = 0;    // Invalid bytes after the last valid record
+        };
+
+        explicit CommandJournal(JournalOptions options = {});
+
+        /*
+         *  Description : Commits everything appended, then closes.
+         */
+        ~CommandJournal();
+
+        CommandJournal(const CommandJournal&) = delete;
+        CommandJournal& operator=(const CommandJournal&) = delete;
+
+        /*
+         *  Description : Applies every valid record in 'path' in order, via
+         *                Commands::applyValue. A missing file replays nothing.
+         */
+        static ReplayResult replay(const std::string& path, const Resolver& resolve);
+
+        /*
+         *  Description : Opens 'path' for appending, creating it if needed.
+         *                An invalid tail is truncated and LSNs continue after
+         *                the last valid record. Throws std::runtime_error.
+         */
+        void open(const std::string& path);
+
+        /*
+         *  Description : Commits pending records and closes the file.
+         */
+        void close();
+
+        bool isOpen() const;
+
+        /*
+         *  Description : Queues one record and returns its LSN, or 0 if the
+         *                journal is not open. Does not wait for the disk
+         *                unless the policy is EVERY_RECORD.
+         */
+        std::uint64_t append(const Core::CommandRecord& record, std::string_view targetId);
+
+        /*
+         *  Description : Blocks until the record with 'lsn' is on disk.
+         *                Throws std::runtime_error if a write failed.
+         */
+        void waitDurable(std::uint64_t lsn);
+
+        /*
+         *  Description : Blocks until everything appended so far is on disk.
+         */
+        void flush();
+
+        /*
+         *  Description : Drops the records up to 'coveredLsn' once a snapshot
+         *                covers them. Read lastLsn() before taking the
+         *                snapshot: records appended meanwhile (e.g. by
+         *                automation on another thread) may be missing from it
+         *                and are kept. LSNs keep increasing. Throws
+         *                std::runtime_error.
+         */
+        void reset(std::uint64_t coveredLsn);
+
+        /*
+         *  Description : LSN of the last record appended, 0 if none.
+         */
+        std::uint64_t lastLsn() const;
+
+        std::uint64_t durableLsn() const;
+
+        /*
+         *  Description : Number of fsync calls made, for measuring batching.
+         */
+        std::uint64_t syncCount() const;
+
+    private:
+        /*
+         *  Description : Writes 'bytes' and fsyncs. Returns false on failure.
+         */
+        bool writeAndSync(const std::string& bytes);
+
+        /*
+         *  Description : Committer thread: swaps the pending batch out under
+         *                the lock and writes it without holding it.
+         */
+        void commitLoop();
+
+        JournalOptions _options;
+        std::string _path;
+        std::FILE* _file = nullptr;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _wake;          // Committer: work or stop
+        std::condition_variable _committed;     // Waiters: durableLsn advanced
+        std::string _pending;                   // Encoded records not yet written
+        std::uint64_t _lastLsn = 0;             // Last LSN handed out
+        std::uint64_t _durableLsn = 0;
+        std::uint64_t _syncs = 0;
+        std::size_t _waiters = 0;               // Threads blocked in waitDurable()
+        bool _committing = false;               // A batch is being written
+        bool _failed = false;                   // A write or fsync failed
+        bool _stop = false;
+        std::thread _committer;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,90 @@
+/******************************************************************************
+ *  MODULE NAME  : Persistence
+ *  FILE         : Manifest.hpp
+ *  DESCRIPTION  : Declares the Manifest class, which bulk-provisions devices,
+ *                 groups and initial device state from a text manifest
+ *                 (CSV or JSON lines) in a single streaming pass.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Devices/DeviceGroup.hpp"
+
+namespace SmartHome::Persistence
+{
+    /******************************************************************************
+     *  CLASS NAME   : Manifest
+     *  DESCRIPTION  : One record per line; blank lines and lines starting with
+     *                 '#' are skipped. A line starting with '{' is a JSON
+     *                 object, anything else is CSV, so both may be mixed.
+     *
+     *                   device,<id>,<model>,<type>,<group;group>,<key=value;...>
+     *                   group,<name>,<parent group>
+     *
+     *                   {"device":"hall-1","model":"LIGHT::DIMMABLE","type":"Ceiling",
+     *                    "groups":["Hall"],"state":{"power":true,"brightness":40}}
+     *                   {"group":"Hall","parent":"Ground floor"}
+     *
+     *                 Trailing CSV fields may be left out and CSV fields cannot
+     *                 contain commas; a first line starting with "kind," is a
+     *                 header. <model> is a DeviceFactory key. State keys are
+     *                 power, brightness, target, mode (heating, cooling, off),
+     *                 locked, recording and nightvision; power is applied
+     *                 first. Groups named by a device or as a parent but not
+     *                 declared are created.
+     ******************************************************************************/
+    class Manifest
+    {
+    public:
+        /*
+         *  Description : What a load did and how long it took.
+         */
+        struct Stats
+        {
+            std::size_t lines = 0;
+            std::size_t devices = 0;
+            std::size_t groups = 0;
+            std::size_t memberships = 0;    // Devices and groups added to groups
+            std::size_t stateWrites = 0;
+            double seconds = 0.0;
+
+            double devicesPerSecond() const { return seconds > 0.0 ? static_cast<double>(devices) / seconds : 0.0; }
+        };
+
+        /*
+         *  Description : The devices in manifest order, every group, and
+         *                the stats of the load.
+         */
+        struct Contents
+        {
+            std::vector<std::shared_ptr<Core::IDevice>> devices;
+            std::vector<std::shared_ptr<Devices::DeviceGroup>> groups;
+            Stats stats;
+        };
+
+        /*
+         *  Description : Maps 'path' and builds what it describes. Throws
+         *                std::runtime_error naming the line of the first
+         *                error; nothing is returned in that case.
+         */
+        static Contents load(const std::string& path);
+
+        /*
+         *  Description : Same as load() for a manifest already in memory.
+         */
+        static Contents parse(std::string_view text);
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
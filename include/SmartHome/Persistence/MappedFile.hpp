@@ -0,0 +1,52 @@
+/******************************************************************************
+ *  MODULE NAME  : Persistence
+ *  FILE         : MappedFile.hpp
+ *  DESCRIPTION  : Declares the MappedFile class, a read-only view of a whole
+ *                 file used by the snapshot and manifest readers.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SmartHome::Persistence
+{
+    /******************************************************************************
+     *  CLASS NAME   : MappedFile
+     *  DESCRIPTION  : Mapped where the platform allows it, read into memory
+     *                 otherwise. The data stays valid for the lifetime of
+     *                 the object.
+     ******************************************************************************/
+    class MappedFile
+    {
+    public:
+        /*
+         *  Description : Opens and maps 'path'. Throws std::runtime_error,
+         *                prefixed with 'reader', if it cannot be read.
+         */
+        MappedFile(const std::string& path, std::string_view reader);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* data() const { return _data; }
+        std::size_t size() const { return _size; }
+
+    private:
+        const char* _data = nullptr;
+        std::size_t _size = 0;
+#if defined(_WIN32)
+        std::vector<char> _buffer;
+#endif
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,74 @@
+/******************************************************************************
+ *  MODULE NAME  : Persistence
+ *  FILE         : Snapshot.hpp
+ *  DESCRIPTION  : Declares the Snapshot class, which saves the registered
+ *                 devices, the groups and every device's state to a compact
+ *                 binary file and restores them at startup. The file is
+ *                 memory-mapped and read in place: fixed-size records plus
+ *                 one string pool, no text parsing.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SmartHome/Core/IDevice.hpp"
+#include "SmartHome/Devices/DeviceGroup.hpp"
+
+namespace SmartHome::Persistence
+{
+    /******************************************************************************
+     *  CLASS NAME   : Snapshot
+     *  DESCRIPTION  : File layout (native byte order, checked on load):
+     *
+     *                   Header | DeviceRecord[] | GroupRecord[] | member[] |
+     *                   secret[] | string pool
+     *
+     *                 Every string is an (offset, length) pair into the pool.
+     *                 Group members are device indices, or group indices with
+     *                 the top bit set. Lock cards and phone tokens are ranges
+     *                 of the secret array. Bump VERSION on any layout change.
+     ******************************************************************************/
+    class Snapshot
+    {
+    public:
+        static constexpr std::uint32_t VERSION = 1;
+
+        /*
+         *  Description : What a snapshot restores. 'devices' are the devices
+         *                that were registered; group members that were not
+         *                are reachable through their groups only.
+         */
+        struct Contents
+        {
+            std::vector<std::shared_ptr<Core::IDevice>> devices;
+            std::vector<std::shared_ptr<Devices::DeviceGroup>> groups;
+        };
+
+        /*
+         *  Description : Writes the snapshot to a temporary file and renames it
+         *                over 'path', so a crash never leaves a torn snapshot.
+         *                Throws std::runtime_error on I/O failure and
+         *                std::invalid_argument for a device it cannot store.
+         */
+        static void save(const std::string& path,
+                         const std::vector<std::shared_ptr<Core::IDevice>>& devices,
+                         const std::vector<std::shared_ptr<Devices::DeviceGroup>>& groups);
+
+        /*
+         *  Description : Maps 'path' and rebuilds its devices and groups.
+         *                Throws std::runtime_error if the file cannot be read
+         *                or fails validation.
+         */
+        static Contents load(const std::string& path);
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
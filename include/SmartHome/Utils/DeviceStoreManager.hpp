@@ -0,0 +1,235 @@
+/******************************************************************************
+ *  MODULE NAME  : Device State Store
+ *  FILE         : DeviceStoreManager.hpp
+ *  DESCRIPTION  : Declares the DeviceStoreManager, the central structure-of-
+ *                 arrays store holding the hot state of every device: on/off,
+ *                 lock, motion and camera bits, light brightness and
+ *                 thermostat temperatures. Device objects keep a Row into it, so
+ *                 whole-house questions become scans over packed columns.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include "SmartHome/Core/IDevice.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace SmartHome::Utils
+{
+    /******************************************************************************
+     *  CLASS NAME   : DeviceStoreManager
+     *  DESCRIPTION  : Rows are grouped in fixed pages that never move, so a Row
+     *                 caches its page pointer and reads a column with one
+     *                 indirection. Every cell is a relaxed atomic: devices may
+     *                 be driven from ThreadPool workers while a scan runs.
+     ******************************************************************************/
+    class DeviceStoreManager
+    {
+    public:
+        /*
+         * Description : Device families are the devices' type tags; each has a
+         *               membership bitmap so scans can be restricted to one kind.
+         */
+        using DeviceKind = Core::DeviceType;
+
+        /*
+         * Description : Bit columns that can be counted or scanned.
+         */
+        enum class Flag : std::uint8_t
+        {
+            ON,
+            LOCKED,
+            MOTION,
+            RECORDING,
+            NIGHT_VISION,
+            COUNT
+        };
+
+    private:
+        static constexpr std::size_t PAGE_BITS = 12;
+        static constexpr std::size_t PAGE_ROWS = std::size_t{1} << PAGE_BITS;
+        static constexpr std::size_t PAGE_WORDS = PAGE_ROWS / 64;
+        static constexpr std::size_t MAX_PAGES = 1024;     // 4M rows
+
+        static constexpr std::size_t KIND_COUNT = static_cast<std::size_t>(DeviceKind::COUNT);
+        static constexpr std::size_t FLAG_COUNT = static_cast<std::size_t>(Flag::COUNT);
+
+        /*
+         * Description : One page of PAGE_ROWS rows, one array per column.
+         */
+        struct Page
+        {
+            std::atomic<std::uint64_t> kinds[KIND_COUNT][PAGE_WORDS];
+            std::atomic<std::uint64_t> flags[FLAG_COUNT][PAGE_WORDS];
+            std::atomic<std::uint8_t> brightness[PAGE_ROWS];
+            std::atomic<float> targetTemperature[PAGE_ROWS];
+            std::atomic<float> currentTemperature[PAGE_ROWS];
+            std::atomic<Core::IDevice*> owner[PAGE_ROWS];
+        };
+
+    public:
+        /******************************************************************************
+         *  CLASS NAME   : Row
+         *  DESCRIPTION  : A device's slot in the store, filed under the owner's
+         *                 type tag. Allocated on construction, released on
+         *                 destruction; not copyable.
+         ******************************************************************************/
+        class Row
+        {
+        public:
+            explicit Row(Core::IDevice* owner);
+            ~Row();
+
+            Row(const Row&) = delete;
+            Row& operator=(const Row&) = delete;
+
+            bool isOn() const { return test(Flag::ON); }
+            void setOn(bool on) { assign(Flag::ON, on); }
+
+            bool isLocked() const { return test(Flag::LOCKED); }
+            void setLocked(bool locked) { assign(Flag::LOCKED, locked); }
+
+            bool isMotionDetected() const { return test(Flag::MOTION); }
+            void setMotionDetected(bool detected) { assign(Flag::MOTION, detected); }
+
+            bool isRecording() const { return test(Flag::RECORDING); }
+            void setRecording(bool recording) { assign(Flag::RECORDING, recording); }
+
+            bool isNightVision() const { return test(Flag::NIGHT_VISION); }
+            void setNightVision(bool enabled) { assign(Flag::NIGHT_VISION, enabled); }
+
+            int brightness() const { return _page->brightness[_slot].load(std::memory_order_relaxed); }
+            void setBrightness(int level) { _page->brightness[_slot].store(static_cast<std::uint8_t>(level), std::memory_order_relaxed); }
+
+            float targetTemperature() const { return _page->targetTemperature[_slot].load(std::memory_order_relaxed); }
+            void setTargetTemperature(float t) { _page->targetTemperature[_slot].store(t, std::memory_order_relaxed); }
+
+            float currentTemperature() const { return _page->currentTemperature[_slot].load(std::memory_order_relaxed); }
+            void setCurrentTemperature(float t) { _page->currentTemperature[_slot].store(t, std::memory_order_relaxed); }
+
+            std::uint32_t index() const { return _index; }
+
+        private:
+            bool test(Flag flag) const
+            {
+                const std::uint64_t word = _page->flags[static_cast<std::size_t>(flag)][_slot >> 6]
+                                               .load(std::memory_order_relaxed);
+                return (word >> (_slot & 63)) & 1u;
+            }
+
+            void assign(Flag flag, bool value)
+            {
+                auto& word = _page->flags[static_cast<std::size_t>(flag)][_slot >> 6];
+                const std::uint64_t bit = std::uint64_t{1} << (_slot & 63);
+                if (value)
+                    word.fetch_or(bit, std::memory_order_relaxed);
+                else
+                    word.fetch_and(~bit, std::memory_order_relaxed);
+            }
+
+            Page* _page;
+            std::uint32_t _slot;     // Row within the page
+            std::uint32_t _index;    // Row within the store
+        };
+
+        /*
+         * Description : Returns the process-wide store.
+         */
+        static DeviceStoreManager& getInstance();
+
+        ~DeviceStoreManager();
+
+        DeviceStoreManager(const DeviceStoreManager&) = delete;
+        DeviceStoreManager& operator=(const DeviceStoreManager&) = delete;
+
+        /*
+         * Description : Number of devices of 'kind' whose 'flag' equals 'value',
+         *               e.g. count(LIGHT, ON, true) for lights that are on.
+         */
+        std::size_t count(DeviceKind kind, Flag flag, bool value) const;
+
+        /*
+         * Description : Calls 'visit(Core::IDevice&)' for every device of 'kind'
+         *               whose 'flag' equals 'value', e.g. all unlocked doors.
+         */
+        template <typename Visitor>
+        void forEach(DeviceKind kind, Flag flag, bool value, Visitor&& visit) const
+        {
+            scan(kind, flag, value, [&visit](const Page& page, std::size_t slot)
+            {
+                if (Core::IDevice* device = page.owner[slot].load(std::memory_order_relaxed))
+                    visit(*device);
+            });
+        }
+
+        /*
+         * Description : Mean brightness of the lights that are on (0 if none).
+         */
+        double averageBrightnessOn() const;
+
+        /*
+         * Description : Number of rows currently held by devices.
+         */
+        std::size_t liveCount() const;
+
+    private:
+        DeviceStoreManager() = default;
+
+        /*
+         * Description : Claims a row for a new device and clears its cells.
+         */
+        Page* allocate(DeviceKind kind, Core::IDevice* owner, std::uint32_t& index);
+
+        /*
+         * Description : Clears a row and returns it to the free list.
+         */
+        void release(std::uint32_t index);
+
+        /*
+         * Description : Walks the matching bits word by word and calls
+         *               'onMatch(page, slot)' for each set bit.
+         */
+        template <typename OnMatch>
+        void scan(DeviceKind kind, Flag flag, bool value, OnMatch&& onMatch) const
+        {
+            const std::size_t pages = _pageCount.load(std::memory_order_acquire);
+            const std::size_t k = static_cast<std::size_t>(kind);
+            const std::size_t f = static_cast<std::size_t>(flag);
+
+            for (std::size_t p = 0; p < pages; ++p)
+            {
+                const Page& page = *_pages[p].load(std::memory_order_acquire);
+                for (std::size_t w = 0; w < PAGE_WORDS; ++w)
+                {
+                    const std::uint64_t bits = page.flags[f][w].load(std::memory_order_relaxed);
+                    std::uint64_t match = page.kinds[k][w].load(std::memory_order_relaxed)
+                                        & (value ? bits : ~bits);
+                    while (match)
+                    {
+                        onMatch(page, w * 64 + static_cast<std::size_t>(__builtin_ctzll(match)));
+                        match &= match - 1;
+                    }
+                }
+            }
+        }
+
+        std::array<std::atomic<Page*>, MAX_PAGES> _pages{};
+        std::atomic<std::size_t> _pageCount{0};
+
+        mutable std::mutex _allocMutex;            // Guards allocation and the free list
+        std::uint32_t _nextIndex = 0;              // First never-used row
+        std::vector<std::uint32_t> _freeRows;      // Released rows, reused first
+        std::size_t _liveRows = 0;
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,85 @@
+/******************************************************************************
+ *  MODULE NAME  : Log File Sink
+ *  FILE         : LogFileSink.hpp
+ *  DESCRIPTION  : Declares the LogFileSink class, an append-only writer of
+ *                 newline-delimited JSON log entries with size- and
+ *                 time-based rotation.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace SmartHome::Utils
+{
+    /******************************************************************************
+     *  STRUCT NAME  : LogStreamConfig
+     *  DESCRIPTION  : Settings of a streaming log file.
+     ******************************************************************************/
+    struct LogStreamConfig
+    {
+        std::string filePath = "logs.ndjson";                  // Active file; rotated copies get ".1", ".2", ...
+        std::size_t maxFileBytes = 10 * 1024 * 1024;           // Rotate once the active file reaches this size
+        std::chrono::seconds maxFileAge = std::chrono::hours(24); // Rotate once the active file is this old
+        std::size_t maxRotatedFiles = 5;                       // Oldest rotated file beyond this is deleted
+        std::size_t maxBufferedEntries = 256;                  // Entries appended before the file is flushed
+    };
+
+    /******************************************************************************
+     *  CLASS NAME   : LogFileSink
+     *  DESCRIPTION  : Appends one JSON object per line to the active file and
+     *                 rotates it when it grows too large or too old. Not
+     *                 thread-safe; the Logger serializes access.
+     ******************************************************************************/
+    class LogFileSink
+    {
+    public:
+        /*
+         * Description : Opens (or continues) the active file described by config.
+         */
+        explicit LogFileSink(LogStreamConfig config);
+
+        /*
+         * Description : Appends one entry followed by a newline, rotating first
+         *               if the size or age limit has been reached.
+         */
+        void append(std::string_view entry);
+
+        /*
+         * Description : Pushes buffered bytes to the operating system.
+         */
+        void flush();
+
+        /*
+         * Description : Returns the configuration the sink was opened with.
+         */
+        const LogStreamConfig& config() const;
+
+    private:
+        /*
+         * Description : Shifts "file.N" to "file.N+1", moves the active file
+         *               to "file.1" and starts a fresh active file.
+         */
+        void rotate();
+
+        /*
+         * Description : Opens the active file in append mode.
+         */
+        void open();
+
+        LogStreamConfig _config;
+        std::ofstream _out;
+        std::size_t _bytesWritten = 0;                      // Size of the active file
+        std::chrono::system_clock::time_point _openedAt;   // Start of the active file's age window
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,73 @@
+/******************************************************************************
+ *  MODULE NAME  : Log Formatter
+ *  FILE         : LogFormatter.hpp
+ *  DESCRIPTION  : Declares the LogFormatter class which renders log entries
+ *                 as JSON objects into a reusable buffer, caching the
+ *                 formatted timestamp for the current second.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace SmartHome::Utils
+{
+    /******************************************************************************
+     *  CLASS NAME   : LogFormatter
+     *  DESCRIPTION  : Formats entries without per-call allocation once the
+     *                 buffer has grown to the largest entry seen. Calls within
+     *                 the same second reuse the cached "YYYY-MM-DD HH:MM:SS"
+     *                 text instead of calling localtime. Not thread-safe.
+     ******************************************************************************/
+    class LogFormatter
+    {
+    public:
+        /*
+         * Description : Reserves the output buffer up front.
+         */
+        LogFormatter();
+
+        /*
+         * Description : Formats one entry. Fields are JSON-escaped, so any
+         *               text (quotes, newlines, IDs read from files) gives
+         *               one valid NDJSON line. The returned view points into
+         *               the formatter's buffer and is valid until the next call.
+         * Parameters  :
+         *   - timestampNs : system_clock time since epoch, in nanoseconds.
+         *   - source, action, target, result : Entry fields; empty target and
+         *                                      result are omitted.
+         */
+        std::string_view format(std::int64_t timestampNs,
+                                std::string_view source,
+                                std::string_view action,
+                                std::string_view target,
+                                std::string_view result);
+
+    private:
+        /*
+         * Description : Re-renders the cached timestamp for a new second.
+         */
+        void refreshTimestamp(std::int64_t epochSecond);
+
+        /*
+         * Description : Appends 'text' as the inside of a JSON string.
+         */
+        void appendEscaped(std::string_view text);
+
+        static constexpr std::size_t TIMESTAMP_LENGTH = 19;    // "YYYY-MM-DD HH:MM:SS"
+        static constexpr std::size_t INITIAL_CAPACITY = 512;
+
+        std::int64_t _cachedSecond = std::numeric_limits<std::int64_t>::min();
+        char _timestamp[TIMESTAMP_LENGTH + 1] = {};
+        std::string _buffer;                                   // Reused output buffer
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
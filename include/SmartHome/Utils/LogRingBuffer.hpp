@@ -0,0 +1,166 @@
+/******************************************************************************
+ *  MODULE NAME  : Log Ring Buffer
+ *  FILE         : LogRingBuffer.hpp
+ *  DESCRIPTION  : Declares the fixed-size binary LogRecord and the lock-free
+ *                 single-producer/single-consumer ring used by the Logger's
+ *                 asynchronous mode. Each producer thread owns one ring and
+ *                 the drain thread is its only consumer.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace SmartHome::Utils
+{
+    /******************************************************************************
+     *  STRUCT NAME  : LogRecord
+     *  DESCRIPTION  : Fixed-size, trivially copyable log event. Strings are
+     *                 truncated to their field capacity so that producing a
+     *                 record never allocates.
+     ******************************************************************************/
+    struct LogRecord
+    {
+        static constexpr std::size_t SOURCE_CAPACITY = 40;
+        static constexpr std::size_t ACTION_CAPACITY = 136;
+        static constexpr std::size_t TARGET_CAPACITY = 40;
+        static constexpr std::size_t RESULT_CAPACITY = 24;
+
+        std::int64_t timestampNs;            // system_clock time since epoch
+        std::uint8_t sourceLength;
+        std::uint8_t actionLength;
+        std::uint8_t targetLength;
+        std::uint8_t resultLength;
+        char source[SOURCE_CAPACITY];
+        char action[ACTION_CAPACITY];
+        char target[TARGET_CAPACITY];
+        char result[RESULT_CAPACITY];
+
+        /*
+         * Description : Copies at most 'capacity' bytes of 'text' into 'field'
+         *               and returns the stored length.
+         */
+        static std::uint8_t store(char* field, std::size_t capacity, const char* text, std::size_t length)
+        {
+            if (length > capacity)
+                length = capacity;
+            std::memcpy(field, text, length);
+            return static_cast<std::uint8_t>(length);
+        }
+    };
+
+    /******************************************************************************
+     *  CLASS NAME   : LogRingBuffer
+     *  DESCRIPTION  : Bounded SPSC queue of LogRecords. A full ring drops the
+     *                 record instead of blocking so the producer never waits
+     *                 on the consumer.
+     ******************************************************************************/
+    class LogRingBuffer
+    {
+    public:
+        /*
+         * Description : Creates a ring holding 'capacity' records; rounded up
+         *               to the next power of two.
+         */
+        explicit LogRingBuffer(std::size_t capacity)
+        {
+            std::size_t rounded = 1;
+            while (rounded < capacity)
+                rounded <<= 1;
+
+            _mask = rounded - 1;
+            _slots = std::make_unique<LogRecord[]>(rounded);
+        }
+
+        /*
+         * Description : Producer side. Returns a slot to fill, or nullptr if
+         *               the ring is full. Must be followed by commit().
+         */
+        LogRecord* reserve()
+        {
+            const std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+            if (tail - _cachedHead > _mask)
+            {
+                _cachedHead = _head.load(std::memory_order_acquire);
+                if (tail - _cachedHead > _mask)
+                {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+            }
+            return &_slots[tail & _mask];
+        }
+
+        /*
+         * Description : Producer side. Publishes the slot returned by reserve().
+         */
+        void commit()
+        {
+            _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /*
+         * Description : Consumer side. Invokes 'consume' on every published
+         *               record and returns how many were consumed.
+         */
+        template <typename Consumer>
+        std::size_t drain(Consumer&& consume)
+        {
+            const std::size_t head = _head.load(std::memory_order_relaxed);
+            const std::size_t tail = _tail.load(std::memory_order_acquire);
+
+            for (std::size_t i = head; i != tail; ++i)
+                consume(_slots[i & _mask]);
+
+            _head.store(tail, std::memory_order_release);
+            return tail - head;
+        }
+
+        /*
+         * Description : Tries to take ownership of the ring for the calling thread.
+         */
+        bool claim()
+        {
+            bool expected = false;
+            return _claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel);
+        }
+
+        /*
+         * Description : Returns the ring to the pool when its thread exits.
+         */
+        void release()
+        {
+            _claimed.store(false, std::memory_order_release);
+        }
+
+        /*
+         * Description : Number of records dropped because the ring was full.
+         */
+        std::uint64_t droppedCount() const
+        {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::unique_ptr<LogRecord[]> _slots;
+        std::size_t _mask = 0;
+
+        alignas(64) std::atomic<std::size_t> _tail{0};   // Written by the producer
+        std::size_t _cachedHead = 0;                     // Producer's view of _head
+        alignas(64) std::atomic<std::size_t> _head{0};   // Written by the consumer
+        alignas(64) std::atomic<std::uint64_t> _dropped{0};
+        std::atomic<bool> _claimed{false};
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
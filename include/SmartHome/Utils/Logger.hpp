@@ -10,9 +10,19 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include <mutex>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <cstdint>
+
+#include "SmartHome/Utils/LogRingBuffer.hpp"
+#include "SmartHome/Utils/LogFileSink.hpp"
+#include "SmartHome/Utils/LogFormatter.hpp"
 
 namespace SmartHome::Utils
 {
@@ -26,30 +36,124 @@ namespace SmartHome::Utils
         static Logger& getInstance();
 
         /*
-         * Description : Records a structured log entry.
+         * Description : Records a structured log entry. Arguments are views so
+         *               string literals are passed without allocating.
          * Parameters  :
          *   - source : Source of the log (e.g., class or method name).
          *   - action : Description of the event or operation.
          *   - target : (Optional) Affected device or group ID.
          *   - result : (Optional) Outcome of the action (e.g., "OK", "FAILED").
          */
-        void log(const std::string& source,
-                 const std::string& action,
-                 const std::string& target = "",
-                 const std::string& result = "");
+        void log(std::string_view source,
+                 std::string_view action,
+                 std::string_view target = {},
+                 std::string_view result = {});
 
         /*
-         * Description : Writes all stored log entries to a specified file.
+         * Description : Writes the stored log entries (the last MEMORY_ENTRIES)
+         *               to a specified file. While a stream is open the stream
+         *               is flushed instead and filePath is ignored.
          * Parameters  :
          *   - filePath : Destination file (default is "logs.json").
          */
         void flush(const std::string& filePath = "logs.json");
 
+        /*
+         * Description : Starts streaming entries as newline-delimited JSON.
+         *               Entries go straight from the formatter to the file,
+         *               which is flushed every config.maxBufferedEntries
+         *               entries and rotates by size and age.
+         * Parameters  :
+         *   - config : Stream file, rotation limits and buffer cap.
+         */
+        void openStream(const LogStreamConfig& config);
+
+        /*
+         * Description : Writes out pending entries and closes the stream.
+         */
+        void closeStream();
+
+        /*
+         * Description : Switches to asynchronous mode. Each producer thread gets
+         *               its own lock-free ring of fixed-size records and a
+         *               background thread formats them into entries.
+         * Parameters  :
+         *   - ringCapacity : Records per producer ring (rounded to a power of two).
+         */
+        void startAsync(std::size_t ringCapacity = 1024);
+
+        /*
+         * Description : Drains all pending records, stops the background thread
+         *               and returns to synchronous mode.
+         */
+        void stopAsync();
+
+        /*
+         * Description : Returns true while the asynchronous backend is running.
+         */
+        bool isAsync() const;
+
+        /*
+         * Description : Number of records dropped because a producer ring was full.
+         */
+        std::uint64_t droppedCount() const;
+
+        ~Logger();
+
+        /*
+         * Description : Entries kept in memory while no stream is open; older
+         *               ones are overwritten.
+         */
+        static constexpr std::size_t MEMORY_ENTRIES = 4096;
+
     private:
         Logger() = default;
 
-        std::vector<std::string> _entries;  // Stores log entries in memory
+        /*
+         * Description : Returns the calling thread's ring, claiming or creating one.
+         */
+        LogRingBuffer* localRing();
+
+        /*
+         * Description : Formats every published record into the stream or
+         *               _entries. Returns the number of records drained.
+         */
+        std::size_t drainRings();
+
+        /*
+         * Description : Background loop of the drain thread.
+         */
+        void drainLoop();
+
+        /*
+         * Description : Writes one formatted entry to the stream, or copies it
+         *               into the in-memory ring. Caller holds _mutex.
+         */
+        void appendEntry(std::string_view entry);
+
+        /*
+         * Description : Moves the in-memory entries to the stream. Caller holds _mutex.
+         */
+        void spillEntries();
+
+        std::vector<std::string> _entries;  // Ring of MEMORY_ENTRIES reused buffers, allocated on first use
+        std::size_t _entriesHead = 0;      // Oldest entry in the ring
+        std::size_t _entriesCount = 0;     // Entries in the ring
+        std::size_t _unflushed = 0;        // Entries appended to the stream since its last flush
         std::mutex _mutex;                 // Ensures thread-safe logging
+        LogFormatter _formatter;           // Reused JSON buffer and timestamp cache, guarded by _mutex
+        std::unique_ptr<LogFileSink> _stream;  // Streaming destination, if open
+
+        // Asynchronous backend
+        std::atomic<bool> _async{false};                      // Producers use rings when set
+        std::size_t _ringCapacity = 1024;                     // Capacity of newly created rings
+        std::vector<std::unique_ptr<LogRingBuffer>> _rings;   // One ring per producer thread
+        mutable std::mutex _ringsMutex;                       // Guards _rings registration
+        std::mutex _drainMutex;                               // Serializes consumers of the rings
+        std::thread _drainThread;                             // Formats records off the hot path
+        std::condition_variable _drainSignal;                 // Wakes the drain thread early
+        std::mutex _drainSignalMutex;
+        bool _stopDrain = false;
     };
 }
 
@@ -0,0 +1,213 @@
+/******************************************************************************
+ *  MODULE NAME  : Comfort Mode Implementation
+ *  FILE         : ComfortMode.cpp
+ *  DESCRIPTION  : Implements the ComfortMode control loop: a periodic
+ *                 hysteresis pass over the controlled thermostats with
+ *                 deadband skipping and batched mode changes.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Automation/ComfortMode.hpp"
+#include "SmartHome/Utils/Logger.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+using namespace SmartHome::Automation;
+using namespace SmartHome::Devices;
+using namespace SmartHome::Devices::Thermostats;
+using namespace SmartHome::Controller;
+using SmartHome::Core::CommandCode;
+using SmartHome::Core::DeviceType;
+using SmartHome::Utils::Logger;
+
+ComfortMode::ComfortMode(Scheduler& scheduler, SmartHome::Persistence::CommandJournal* journal)
+    : _scheduler(scheduler), _journal(journal)
+{
+}
+
+ComfortMode::ComfortMode(Scheduler& scheduler, const ComfortPolicy& policy,
+                         SmartHome::Persistence::CommandJournal* journal)
+    : _scheduler(scheduler), _journal(journal), _policy(validated(policy))
+{
+}
+
+ComfortMode::~ComfortMode()
+{
+    deactivate();
+}
+
+/*
+ *  Description : Collects the thermostats of all groups once (a thermostat in
+ *                several groups is controlled once) and caches which mode
+ *                answers each direction of error, so the pass needs no
+ *                per-device type checks.
+ */
+void ComfortMode::activate(const std::vector<std::shared_ptr<DeviceGroup>>& groups)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    stop();
+
+    std::unordered_set<const Core::IDevice*> seen;
+    for (const auto& group : groups)
+    {
+        for (const auto& device : group->devicesOfType(DeviceType::THERMOSTAT))
+        {
+            if (!seen.insert(device.get()).second)
+                continue;
+
+            auto thermostat = std::static_pointer_cast<BaseThermostat>(device);
+            _whenTooWarm.push_back(thermostat->supportsMode(ThermostatMode::COOLING)
+                                   ? ThermostatMode::COOLING : ThermostatMode::OFF);
+            _whenTooCold.push_back(thermostat->supportsMode(ThermostatMode::HEATING)
+                                   ? ThermostatMode::HEATING : ThermostatMode::OFF);
+            _thermostats.push_back(std::move(thermostat));
+        }
+    }
+
+    _changes.reserve(_thermostats.size());
+    runPass();
+    armTimer();
+}
+
+void ComfortMode::deactivate()
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    stop();
+}
+
+/*
+ *  Description : Cancels the pending pass, starts a new epoch so a pass
+ *                already handed to an executor does nothing, and releases
+ *                the thermostats.
+ */
+void ComfortMode::stop()
+{
+    _scheduler.cancel(_timer);
+    _timer = {};
+    ++_epoch;
+
+    _thermostats.clear();
+    _whenTooWarm.clear();
+    _whenTooCold.clear();
+    _changes.clear();
+}
+
+/*
+ *  Description : Decides first, applies second. A thermostat that is heating
+ *                or cooling runs until its reading crosses the target, then
+ *                goes OFF; an idle one is skipped while inside the deadband
+ *                and started in the direction of the error outside it. So a
+ *                device that can do both never flips straight from one
+ *                edge of the band to the other. The apply loop then issues
+ *                every change of this pass in one go.
+ */
+ComfortMode::TickStats ComfortMode::controlPass()
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return runPass();
+}
+
+ComfortMode::TickStats ComfortMode::runPass()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    TickStats stats;
+    stats.evaluated = _thermostats.size();
+    _changes.clear();
+
+    const float deadband = _policy.deadbandCelsius;
+    for (std::size_t i = 0; i < _thermostats.size(); ++i)
+    {
+        const BaseThermostat& thermostat = *_thermostats[i];
+        const float error = thermostat.getCurrentTemperature() - thermostat.getTargetTemperature();
+        const bool outsideBand = std::fabs(error) > deadband;
+        const ThermostatMode mode = thermostat.getMode();
+
+        ThermostatMode wanted = mode;
+        const bool crossed = (mode == ThermostatMode::HEATING && error >= 0)
+                          || (mode == ThermostatMode::COOLING && error <= 0);
+        if (crossed || (mode == ThermostatMode::OFF && outsideBand))
+        {
+            // Past the far edge already (e.g. a long period): correct the other way
+            wanted = !outsideBand ? ThermostatMode::OFF
+                   : (error > 0) ? _whenTooWarm[i] : _whenTooCold[i];
+        }
+
+        if (wanted != mode)
+            _changes.push_back({ static_cast<std::uint32_t>(i), wanted });
+        else if (!outsideBand && mode == ThermostatMode::OFF)
+            ++stats.skipped;
+    }
+
+    for (const ModeChange& change : _changes)
+    {
+        BaseThermostat& thermostat = *_thermostats[change.index];
+        const ThermostatMode from = thermostat.getMode();
+        thermostat.setMode(change.mode);
+        if (_journal)
+        {
+            _journal->append({ CommandCode::THERMOSTAT_MODE, &thermostat,
+                               static_cast<float>(from), static_cast<float>(change.mode) }, thermostat.getID());
+        }
+    }
+    stats.changed = _changes.size();
+
+    stats.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    if (stats.changed > 0)
+        Logger::getInstance().log("ComfortMode", "Thermostat modes updated", {}, std::to_string(stats.changed));
+    if (stats.durationNs > TICK_BUDGET_NS)
+        Logger::getInstance().log("ComfortMode", "Control pass over budget", {}, std::to_string(stats.durationNs) + " ns");
+
+    _lastTick = stats;
+    return stats;
+}
+
+void ComfortMode::setPolicy(const ComfortPolicy& policy)
+{
+    const ComfortPolicy& checked = validated(policy);
+    std::lock_guard<std::mutex> guard(_mutex);
+    _policy = checked;
+}
+
+ComfortMode::TickStats ComfortMode::lastTick() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _lastTick;
+}
+
+const ComfortMode::ComfortPolicy& ComfortMode::validated(const ComfortPolicy& policy)
+{
+    if (policy.periodSeconds < 1)
+        throw std::invalid_argument("ComfortMode: control period must be at least 1 second");
+    if (!(policy.deadbandCelsius >= 0.0f))
+        throw std::invalid_argument("ComfortMode: deadband must not be negative");
+    return policy;
+}
+
+/*
+ *  Description : One timer for the whole loop; each pass schedules the next.
+ *                The task carries the epoch it was armed in and does nothing
+ *                once activate() or deactivate() has moved on.
+ */
+void ComfortMode::armTimer()
+{
+    _timer = _scheduler.scheduleAfter(_policy.periodSeconds, [this, epoch = _epoch]()
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        if (epoch != _epoch)
+            return;
+        runPass();
+        armTimer();
+    });
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -1,70 +1,255 @@
 /******************************************************************************
  *  MODULE NAME  : Energy Saving Mode Implementation
  *  FILE         : EnergySavingMode.cpp
- *  DESCRIPTION  : Implements the logic for EnergySavingMode, which schedules 
- *                 device group shutdown if no motion is detected.
+ *  DESCRIPTION  : Implements the logic for EnergySavingMode, which turns a
+ *                 device group off after it has been vacant for its idle
+ *                 timeout, using one self-rearming timer per group.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : July 2025
  ******************************************************************************/
 
 #include "SmartHome/Automation/EnergySavingMode.hpp"
+#include "SmartHome/Commands/JournaledCommand.hpp"
+#include "SmartHome/Events/EventBus.hpp"
+#include "SmartHome/Utils/Logger.hpp"
+
+#include <algorithm>
 
 using namespace SmartHome::Automation;
 using namespace SmartHome::Devices;
 using namespace SmartHome::Devices::Sensors;
 using namespace SmartHome::Commands;
 using namespace SmartHome::Controller;
+using namespace SmartHome::Core;
+
+using SmartHome::Utils::Logger;
+
+namespace
+{
+    constexpr std::int64_t NS_PER_SECOND = 1000000000;
+
+    std::int64_t toNs(int seconds)
+    {
+        return static_cast<std::int64_t>(seconds) * NS_PER_SECOND;
+    }
+}
 
-EnergySavingMode::EnergySavingMode(Scheduler& scheduler)
-    : _scheduler(scheduler)
+EnergySavingMode::EnergySavingMode(Scheduler& scheduler, SmartHome::Persistence::CommandJournal* journal)
+    : _scheduler(scheduler), _journal(journal), _clock(&Events::EventBus::nowNs)
 {
 }
 
+EnergySavingMode::~EnergySavingMode()
+{
+    deactivate();
+}
+
 /*
- *  Description : Activates energy-saving logic for each device group.
- *                If no motion is detected in a group, it schedules a turn-off
- *                command after 10 minutes (600 seconds).
+ *  Description : Starts monitoring every group that has a motion sensor. The
+ *                group counts as present now, so with no motion it is turned
+ *                off one idle timeout from now (600 s by default). Existing
+ *                timers are cancelled first, so activating again never adds
+ *                timers: there is at most one per group.
  */
 void EnergySavingMode::activate(const std::vector<std::shared_ptr<DeviceGroup>>& groups)
 {
-    for (const auto& group : groups)
     {
-        handleMotionState(group);
+        std::lock_guard<std::mutex> guard(_mutex);
+        cancelTimers();
+        _groups.clear();
+        _sensors.clear();
+
+        const std::int64_t now = _clock();
+        for (const auto& group : groups)
+        {
+            const auto& sensors = group->devicesOfType(DeviceType::MOTION_SENSOR);
+            if (sensors.empty())
+                continue; // No way to tell whether the room is empty
+
+            const std::size_t index = _groups.size();
+            GroupState& state = _groups.emplace_back();
+            state.group = group;
+            state.groupId = group->getID();
+            state.lastPresenceNs = now;
+
+            auto policy = _policies.find(state.groupId);
+            state.policy = (policy != _policies.end()) ? policy->second : _defaultPolicy;
+
+            for (const auto& sensor : sensors)
+            {
+                const bool motion = static_cast<MotionSensor*>(sensor.get())->isMotionDetected();
+
+                SensorFact& fact = _sensors[sensor.get()];
+                fact.motion = motion;
+                fact.groups.push_back(index);
+
+                if (motion && state.motionCount++ == 0)
+                    state.motionSinceNs = now;
+            }
+        }
+
+        for (std::size_t i = 0; i < _groups.size(); ++i)
+            armTimer(i, toNs(_groups[i].policy.idleTimeoutSeconds));
     }
+
+    // Outside _mutex: delivery holds the bus lock and then takes _mutex
+    Events::EventBus::getInstance().subscribe(this, eventMask(EventType::MOTION));
 }
 
 /*
- *  Description : Handles motion detection state for a single group.
- *                If no motion is detected, it schedules an off command.
+ *  Description : Deactivates energy-saving mode by cancelling every pending
+ *                turn-off timer so none of them fires afterwards.
  */
-void EnergySavingMode::handleMotionState(const std::shared_ptr<DeviceGroup>& group)
+void EnergySavingMode::deactivate()
 {
-    for (const auto& [id, device] : group->getDevices())
+    Events::EventBus::getInstance().unsubscribe(this);
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    cancelTimers();
+    _groups.clear();
+    _sensors.clear();
+}
+
+/*
+ *  Description : Counts sensors reporting motion per group. Motion ending
+ *                is where a pulse is judged: long enough, and it moves the
+ *                group's deadline. Only group state changes here; the
+ *                scheduler is left to the thread that ticks it.
+ */
+void EnergySavingMode::onEvent(const DeviceEvent& event)
+{
+    if (event.type != EventType::MOTION)
+        return;
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    auto it = _sensors.find(event.source);
+    if (it == _sensors.end() || it->second.motion == event.state)
+        return;
+
+    SensorFact& fact = it->second;
+    fact.motion = event.state;
+
+    for (std::size_t index : fact.groups)
     {
-        auto motionSensor = std::dynamic_pointer_cast<MotionSensor>(device);
-        if (motionSensor)
+        GroupState& state = _groups[index];
+        if (event.state)
         {
-            if (!motionSensor->isMotionDetected())
-            {
-                auto offCmd = std::make_shared<GroupOffCommand>(group);
-                _scheduledCommands[group->getID()] = offCmd;
+            if (state.motionCount++ == 0)
+                state.motionSinceNs = event.timestampNs;
+        }
+        else if (--state.motionCount == 0)
+        {
+            notePresence(state, state.motionSinceNs, event.timestampNs);
+        }
+    }
+}
 
-                _scheduler.scheduleAfter(600, [offCmd]() {
-                    offCmd->execute();
-                });
-            }
+void EnergySavingMode::setDefaultPolicy(const IdlePolicy& policy)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _defaultPolicy = policy;
+}
+
+/*
+ *  Description : Stores the override and, for a monitored group that is not
+ *                off, moves its pending timer to the new deadline.
+ */
+void EnergySavingMode::setIdlePolicy(const std::string& groupId, const IdlePolicy& policy)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _policies[groupId] = policy;
+
+    const std::int64_t now = _clock();
+    for (GroupState& state : _groups)
+    {
+        if (state.groupId != groupId)
+            continue;
 
-            break; // One motion sensor per group is sufficient
+        state.policy = policy;
+        if (!state.off)
+        {
+            const std::int64_t remaining = state.lastPresenceNs + toNs(policy.idleTimeoutSeconds) - now;
+            _scheduler.reschedule(state.timer,
+                static_cast<int>(std::max<std::int64_t>(1, (remaining + NS_PER_SECOND - 1) / NS_PER_SECOND)));
         }
     }
 }
 
+void EnergySavingMode::setClock(Clock clock)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    _clock = clock;
+}
+
+void EnergySavingMode::notePresence(GroupState& state, std::int64_t sinceNs, std::int64_t nowNs)
+{
+    const int window = state.off ? state.policy.hysteresisSeconds : state.policy.debounceSeconds;
+    if (nowNs - sinceNs < toNs(window))
+        return; // Glitch or chatter
+
+    state.lastPresenceNs = nowNs;
+    state.off = false;
+}
+
 /*
- *  Description : Deactivates energy-saving mode by clearing internal state.
+ *  Description : Ongoing motion counts as presence up to now. If motion moved
+ *                the deadline the timer simply follows it; otherwise the
+ *                group is turned off, once, and the timer checks back every
+ *                idle timeout for presence returning. A task from before
+ *                the last activate() or deactivate() may still run on an
+ *                executor; its index no longer means anything, so it stops.
  */
-void EnergySavingMode::deactivate()
+void EnergySavingMode::onIdleTimer(std::size_t index, std::uint64_t epoch)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    if (epoch != _epoch)
+        return;
+
+    GroupState& state = _groups[index];
+    const std::int64_t now = _clock();
+
+    if (state.motionCount > 0)
+        notePresence(state, state.motionSinceNs, now);
+
+    const std::int64_t deadline = state.lastPresenceNs + toNs(state.policy.idleTimeoutSeconds);
+    if (now < deadline)
+    {
+        armTimer(index, deadline - now);
+        return;
+    }
+
+    if (!state.off)
+    {
+        auto offCmd = std::make_shared<GroupOffCommand>(state.group);
+        if (_journal)
+            JournaledCommand(offCmd, *_journal).execute();
+        else
+            offCmd->execute();
+        state.off = true;
+
+        Logger::getInstance().log("EnergySavingMode", "No motion - group turned off", state.groupId);
+    }
+    armTimer(index, toNs(state.policy.idleTimeoutSeconds));
+}
+
+/*
+ *  Description : Schedules the group's single timer, rounding up to whole
+ *                scheduler seconds.
+ */
+void EnergySavingMode::armTimer(std::size_t index, std::int64_t delayNs)
+{
+    const int seconds = static_cast<int>(std::max<std::int64_t>(1, (delayNs + NS_PER_SECOND - 1) / NS_PER_SECOND));
+    _groups[index].timer = _scheduler.scheduleAfter(seconds, [this, index, epoch = _epoch]()
+    {
+        onIdleTimer(index, epoch);
+    });
+}
+
+void EnergySavingMode::cancelTimers()
 {
-    _scheduledCommands.clear();
+    for (const GroupState& state : _groups)
+        _scheduler.cancel(state.timer);
+    ++_epoch;   // Tasks already handed to an executor find it changed
 }
 
 /******************************************************************************
@@ -0,0 +1,521 @@
+/******************************************************************************
+ *  MODULE NAME  : Automation Rules Implementation
+ *  FILE         : RuleCompiler.cpp
+ *  DESCRIPTION  : Implements the RuleCompiler: a line tokenizer and a
+ *                 recursive-descent parser that emits postfix bytecode, plus
+ *                 resolution of device IDs, group expansion and the
+ *                 input-to-rule index.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Automation/RuleCompiler.hpp"
+#include "SmartHome/Commands/SupportedCommands.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+using namespace SmartHome::Automation;
+using namespace SmartHome::Devices;
+using namespace SmartHome::Commands;
+using SmartHome::Core::DeviceType;
+using SmartHome::Core::EventType;
+using SmartHome::Core::IDevice;
+using SmartHome::Core::ICommand;
+
+namespace
+{
+    enum class TokenKind { WORD, STRING, LPAREN, RPAREN, COMMA, COLON, GREATER, LESS, END };
+
+    struct Token
+    {
+        TokenKind kind;
+        std::string_view text;
+    };
+
+    /*
+     *  Description : Splits one line into tokens. A word runs until
+     *                whitespace or punctuation; quotes delimit IDs with spaces.
+     */
+    class Lexer
+    {
+    public:
+        explicit Lexer(std::string_view line) : _line(line) {}
+
+        Token next()
+        {
+            while (_pos < _line.size() && std::isspace(static_cast<unsigned char>(_line[_pos])))
+                ++_pos;
+            if (_pos == _line.size())
+                return { TokenKind::END, {} };
+
+            const char c = _line[_pos];
+            switch (c)
+            {
+                case '(': return single(TokenKind::LPAREN);
+                case ')': return single(TokenKind::RPAREN);
+                case ',': return single(TokenKind::COMMA);
+                case ':': return single(TokenKind::COLON);
+                case '>': return single(TokenKind::GREATER);
+                case '<': return single(TokenKind::LESS);
+                case '"':
+                {
+                    const std::size_t close = _line.find('"', _pos + 1);
+                    if (close == std::string_view::npos)
+                        throw std::invalid_argument("unterminated quote");
+                    Token token{ TokenKind::STRING, _line.substr(_pos + 1, close - _pos - 1) };
+                    _pos = close + 1;
+                    return token;
+                }
+                default:
+                    break;
+            }
+
+            const std::size_t start = _pos;
+            while (_pos < _line.size() && !std::isspace(static_cast<unsigned char>(_line[_pos]))
+                   && std::string_view("(),:<>\"").find(_line[_pos]) == std::string_view::npos)
+                ++_pos;
+            return { TokenKind::WORD, _line.substr(start, _pos - start) };
+        }
+
+    private:
+        Token single(TokenKind kind)
+        {
+            return { kind, _line.substr(_pos++, 1) };
+        }
+
+        std::string_view _line;
+        std::size_t _pos = 0;
+    };
+
+    /*
+     *  Description : What a predicate name reads and which devices provide it.
+     */
+    struct Predicate
+    {
+        std::string_view name;
+        DeviceType deviceType;
+        EventType eventType;
+        OpCode op;                  // GREATER / LESS are picked from the comparison
+    };
+
+    /*
+     *  Description : Deepest parentheses / 'not' nesting a condition may use,
+     *                so a hostile rules file cannot exhaust the parser's stack.
+     */
+    constexpr std::size_t MAX_NESTING = 64;
+
+    constexpr Predicate PREDICATES[] = {
+        { "motion",      DeviceType::MOTION_SENSOR, EventType::MOTION,      OpCode::IS_SET },
+        { "locked",      DeviceType::DOOR_LOCK,     EventType::LOCK,        OpCode::IS_SET },
+        { "unlocked",    DeviceType::DOOR_LOCK,     EventType::LOCK,        OpCode::IS_CLEAR },
+        { "temperature", DeviceType::THERMOSTAT,    EventType::TEMPERATURE, OpCode::GREATER },
+    };
+
+    /*
+     *  Description : Parses one rule line into the program being built.
+     */
+    class RuleParser
+    {
+    public:
+        RuleParser(std::string_view line, RuleProgram& program, const RuleCompiler::Resolver& resolve,
+                   std::vector<std::vector<std::uint32_t>>& dependents)
+            : _lexer(line), _program(program), _resolve(resolve), _dependents(dependents)
+        {
+            advance();
+        }
+
+        /*
+         *  Description : rule NAME : when EXPR then ACTION { , ACTION }
+         */
+        void parseRule()
+        {
+            expectWord("rule");
+            if (_token.kind != TokenKind::WORD && _token.kind != TokenKind::STRING)
+                throw std::invalid_argument("expected a rule name");
+
+            _ruleIndex = static_cast<std::uint32_t>(_program.rules.size());
+            Rule& rule = _program.rules.emplace_back();
+            rule.name = std::string(_token.text);
+            advance();
+            expect(TokenKind::COLON, "':' after the rule name");
+
+            expectWord("when");
+            rule.codeBegin = static_cast<std::uint32_t>(_program.code.size());
+            parseOr();
+            _program.rules[_ruleIndex].codeEnd = static_cast<std::uint32_t>(_program.code.size());
+
+            expectWord("then");
+            _program.rules[_ruleIndex].actionsBegin = static_cast<std::uint32_t>(_program.actions.size());
+            parseAction();
+            while (_token.kind == TokenKind::COMMA)
+            {
+                advance();
+                parseAction();
+            }
+            _program.rules[_ruleIndex].actionsEnd = static_cast<std::uint32_t>(_program.actions.size());
+
+            if (_token.kind != TokenKind::END)
+                throw std::invalid_argument("unexpected '" + std::string(_token.text) + "'");
+        }
+
+    private:
+        void advance() { _token = _lexer.next(); }
+
+        bool isWord(std::string_view word) const
+        {
+            return _token.kind == TokenKind::WORD && _token.text == word;
+        }
+
+        void expectWord(std::string_view word)
+        {
+            if (!isWord(word))
+                throw std::invalid_argument("expected '" + std::string(word) + "'");
+            advance();
+        }
+
+        void expect(TokenKind kind, const char* what)
+        {
+            if (_token.kind != kind)
+                throw std::invalid_argument(std::string("expected ") + what);
+            advance();
+        }
+
+        void emit(OpCode op, std::uint32_t input = 0, float operand = 0.0f)
+        {
+            _program.code.push_back({ op, input, operand });
+
+            if (op == OpCode::AND || op == OpCode::OR)
+                --_depth;
+            else if (op != OpCode::NOT && ++_depth > RULE_STACK_DEPTH)
+                throw std::invalid_argument("condition is nested too deeply");
+        }
+
+        // expr := term { or term }
+        void parseOr()
+        {
+            parseAnd();
+            while (isWord("or"))
+            {
+                advance();
+                parseAnd();
+                emit(OpCode::OR);
+            }
+        }
+
+        // term := factor { and factor }
+        void parseAnd()
+        {
+            parseFactor();
+            while (isWord("and"))
+            {
+                advance();
+                parseFactor();
+                emit(OpCode::AND);
+            }
+        }
+
+        // factor := not factor | ( expr ) | predicate ( ID ) [ > N | < N ]
+        void parseFactor()
+        {
+            if (isWord("not"))
+            {
+                advance();
+                enter();
+                parseFactor();
+                --_nesting;
+                emit(OpCode::NOT);
+                return;
+            }
+            if (_token.kind == TokenKind::LPAREN)
+            {
+                advance();
+                enter();
+                parseOr();
+                --_nesting;
+                expect(TokenKind::RPAREN, "')'");
+                return;
+            }
+
+            const Predicate* predicate = nullptr;
+            for (const Predicate& candidate : PREDICATES)
+            {
+                if (isWord(candidate.name))
+                    predicate = &candidate;
+            }
+            if (!predicate)
+                throw std::invalid_argument("unknown condition '" + std::string(_token.text) + "'");
+            advance();
+
+            const auto devices = parseTargets(predicate->deviceType, predicate->name);
+
+            OpCode op = predicate->op;
+            float threshold = 0.0f;
+            if (predicate->eventType == EventType::TEMPERATURE)
+            {
+                if (_token.kind != TokenKind::GREATER && _token.kind != TokenKind::LESS)
+                    throw std::invalid_argument("expected '>' or '<' after temperature()");
+                op = (_token.kind == TokenKind::GREATER) ? OpCode::GREATER : OpCode::LESS;
+                advance();
+                threshold = parseNumber();
+            }
+
+            // A group means any of its devices: a OR b OR c ...
+            for (std::size_t i = 0; i < devices.size(); ++i)
+            {
+                emit(op, inputFor(devices[i], predicate->eventType), threshold);
+                if (i > 0)
+                    emit(OpCode::OR);
+            }
+        }
+
+        void enter()
+        {
+            if (++_nesting > MAX_NESTING)
+                throw std::invalid_argument("condition is nested too deeply");
+        }
+
+        float parseNumber()
+        {
+            const std::string text(_token.text);
+            char* end = nullptr;
+            const float value = std::strtof(text.c_str(), &end);
+            if (_token.kind != TokenKind::WORD || text.empty() || *end != '\0')
+                throw std::invalid_argument("expected a number");
+            advance();
+            return value;
+        }
+
+        // action := verb ( ID )
+        void parseAction()
+        {
+            if (_token.kind != TokenKind::WORD)
+                throw std::invalid_argument("expected an action");
+            const std::string_view verb = _token.text;
+            advance();
+
+            auto& actions = _program.actions;
+            if (verb == "record" || verb == "stop_recording")
+            {
+                for (const auto& device : parseTargets(DeviceType::CAMERA, verb))
+                {
+                    auto camera = std::static_pointer_cast<Cameras::BaseCamera>(device);
+                    if (verb == "record")
+                        actions.push_back(std::make_shared<StartRecordingCommand>(camera));
+                    else
+                        actions.push_back(std::make_shared<StopRecordingCommand>(camera));
+                }
+            }
+            else if (verb == "lock" || verb == "unlock")
+            {
+                for (const auto& device : parseTargets(DeviceType::DOOR_LOCK, verb))
+                {
+                    auto lock = std::static_pointer_cast<DoorLock>(device);
+                    if (verb == "lock")
+                        actions.push_back(std::make_shared<LockCommand>(lock));
+                    else
+                        actions.push_back(std::make_shared<UnlockCommand>(lock));
+                }
+            }
+            else if (verb == "on" || verb == "off")
+            {
+                for (const auto& device : parseMembers())
+                {
+                    if (verb == "on")
+                        actions.push_back(std::make_shared<TurnOnCommand>(device));
+                    else
+                        actions.push_back(std::make_shared<TurnOffCommand>(device));
+                }
+            }
+            else
+            {
+                throw std::invalid_argument("unknown action '" + std::string(verb) + "'");
+            }
+        }
+
+        /*
+         *  Description : ( ID ) resolved to a device of 'type', or a group
+         *                expanded to its members of 'type'.
+         */
+        std::vector<std::shared_ptr<IDevice>> parseTargets(DeviceType type, std::string_view what)
+        {
+            auto device = parseId();
+            if (device->getType() == type)
+                return { device };
+
+            if (device->getType() == DeviceType::GROUP)
+            {
+                auto group = std::static_pointer_cast<DeviceGroup>(device);
+                const auto& members = group->devicesOfType(type);
+                noteGroup(group);
+                if (members.empty())
+                    throw std::invalid_argument("group '" + device->getID() + "' has no device for "
+                                                + std::string(what) + "()");
+                return members;
+            }
+
+            throw std::invalid_argument("'" + device->getID() + "' cannot be used with "
+                                        + std::string(what) + "()");
+        }
+
+        /*
+         *  Description : ( ID ) resolved to a device, or a group expanded to
+         *                all its members, so an action never walks a group's
+         *                member map while the controller changes it.
+         */
+        std::vector<std::shared_ptr<IDevice>> parseMembers()
+        {
+            std::vector<std::shared_ptr<IDevice>> devices;
+            expandMembers(parseId(), devices, 0);
+            return devices;
+        }
+
+        void expandMembers(const std::shared_ptr<IDevice>& device,
+                           std::vector<std::shared_ptr<IDevice>>& devices, std::size_t depth)
+        {
+            if (device->getType() != DeviceType::GROUP)
+            {
+                devices.push_back(device);
+                return;
+            }
+            if (depth == MAX_NESTING)
+                throw std::invalid_argument("groups nested too deeply");
+
+            auto group = std::static_pointer_cast<DeviceGroup>(device);
+            noteGroup(group);
+            for (const auto& member : group->getDevices())
+                expandMembers(member.second, devices, depth + 1);
+        }
+
+        /*
+         *  Description : Remembers a group's revision so a later membership
+         *                change can be detected.
+         */
+        void noteGroup(const std::shared_ptr<DeviceGroup>& group)
+        {
+            auto& groups = _program.groups;
+            const bool known = std::any_of(groups.begin(), groups.end(),
+                                           [&group](const RuleGroup& g) { return g.group == group; });
+            if (!known)
+                groups.push_back({ group, group->revision() });
+        }
+
+        std::shared_ptr<IDevice> parseId()
+        {
+            expect(TokenKind::LPAREN, "'('");
+            if (_token.kind != TokenKind::WORD && _token.kind != TokenKind::STRING)
+                throw std::invalid_argument("expected a device or group ID");
+
+            auto device = _resolve(_token.text);
+            if (!device)
+                throw std::invalid_argument("unknown device or group '" + std::string(_token.text) + "'");
+            advance();
+            expect(TokenKind::RPAREN, "')'");
+            return device;
+        }
+
+        /*
+         *  Description : Returns the device's input, registering it (and
+         *                reading its current state) on first use, and records
+         *                that the current rule depends on it.
+         */
+        std::uint32_t inputFor(const std::shared_ptr<IDevice>& device, EventType type)
+        {
+            auto [it, inserted] = _program.inputOf.emplace(device.get(),
+                                                           static_cast<std::uint32_t>(_program.inputs.size()));
+            if (inserted)
+            {
+                _program.inputs.push_back({ device, type });
+                _program.values.push_back(readState(*device, type));
+                _program.events |= SmartHome::Core::eventMask(type);
+                _dependents.emplace_back();
+            }
+
+            auto& dependents = _dependents[it->second];
+            if (dependents.empty() || dependents.back() != _ruleIndex)
+                dependents.push_back(_ruleIndex);
+            return it->second;
+        }
+
+        static float readState(IDevice& device, EventType type)
+        {
+            switch (type)
+            {
+                case EventType::MOTION:
+                    return static_cast<Sensors::MotionSensor&>(device).isMotionDetected() ? 1.0f : 0.0f;
+                case EventType::LOCK:
+                    return static_cast<DoorLock&>(device).isDoorLocked() ? 1.0f : 0.0f;
+                case EventType::TEMPERATURE:
+                    return static_cast<Thermostats::BaseThermostat&>(device).getCurrentTemperature();
+                default:
+                    return 0.0f;
+            }
+        }
+
+        Lexer _lexer;
+        Token _token{ TokenKind::END, {} };
+        RuleProgram& _program;
+        const RuleCompiler::Resolver& _resolve;
+        std::vector<std::vector<std::uint32_t>>& _dependents;
+        std::uint32_t _ruleIndex = 0;
+        std::size_t _depth = 0;         // Stack depth of the emitted code
+        std::size_t _nesting = 0;       // Open parentheses and 'not's
+    };
+}
+
+/*
+ *  Description : Compiles line by line, then flattens the per-input rule
+ *                lists into the CSR index the engine walks on each event.
+ */
+RuleProgram RuleCompiler::compile(std::string_view source, const Resolver& resolve)
+{
+    RuleProgram program;
+    std::vector<std::vector<std::uint32_t>> dependents;
+    std::unordered_set<std::string> names;
+
+    std::size_t lineNumber = 0;
+    while (!source.empty())
+    {
+        const std::size_t end = std::min(source.find('\n'), source.size());
+        std::string_view line = source.substr(0, end);
+        source.remove_prefix(std::min(end + 1, source.size()));
+        ++lineNumber;
+
+        const std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos || line[first] == '#')
+            continue;
+
+        try
+        {
+            RuleParser(line, program, resolve, dependents).parseRule();
+            if (!names.insert(program.rules.back().name).second)
+                throw std::invalid_argument("duplicate rule name '" + program.rules.back().name + "'");
+        }
+        catch (const std::invalid_argument& error)
+        {
+            throw std::invalid_argument("rules line " + std::to_string(lineNumber) + ": " + error.what());
+        }
+    }
+
+    program.dependentsBegin.reserve(dependents.size() + 1);
+    for (auto& rules : dependents)
+    {
+        std::sort(rules.begin(), rules.end());
+        rules.erase(std::unique(rules.begin(), rules.end()), rules.end());
+
+        program.dependentsBegin.push_back(static_cast<std::uint32_t>(program.dependents.size()));
+        program.dependents.insert(program.dependents.end(), rules.begin(), rules.end());
+    }
+    program.dependentsBegin.push_back(static_cast<std::uint32_t>(program.dependents.size()));
+
+    return program;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,207 @@
+/******************************************************************************
+ *  MODULE NAME  : Automation Rules Implementation
+ *  FILE         : RuleEngine.cpp
+ *  DESCRIPTION  : Implements the RuleEngine: program swapping, the indexed
+ *                 per-event re-evaluation and the bytecode interpreter.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Automation/RuleEngine.hpp"
+#include "SmartHome/Commands/JournaledCommand.hpp"
+#include "SmartHome/Devices/DeviceGroup.hpp"
+#include "SmartHome/Events/EventBus.hpp"
+#include "SmartHome/Utils/Logger.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace SmartHome::Automation;
+using SmartHome::Core::DeviceEvent;
+using SmartHome::Core::EventType;
+using SmartHome::Utils::Logger;
+
+RuleEngine::RuleEngine(SmartHome::Persistence::CommandJournal* journal)
+    : _journal(journal), _batch(journal != nullptr)
+{
+}
+
+RuleEngine::~RuleEngine()
+{
+    Events::EventBus::getInstance().unsubscribe(this);
+}
+
+/*
+ *  Description : Compiles outside the lock, seeds each rule's last result,
+ *                then swaps the program in. The subscription follows the
+ *                event types the new rules read.
+ */
+std::size_t RuleEngine::load(std::string_view source, const RuleCompiler::Resolver& resolve)
+{
+    RuleProgram program = RuleCompiler::compile(source, resolve);
+    const Core::EventMask events = program.events;
+    const std::size_t rules = program.rules.size();
+
+    Events::EventBus& bus = Events::EventBus::getInstance();
+    bus.unsubscribe(this);
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _program = std::move(program);
+        for (Rule& rule : _program.rules)
+            rule.active = evaluate(rule);
+        _source = std::string(source);
+        _resolve = resolve;
+    }
+
+    // Outside _mutex: delivery holds the bus lock and then takes _mutex
+    if (events != 0)
+        bus.subscribe(this, events);
+
+    return rules;
+}
+
+std::size_t RuleEngine::loadFile(const std::string& path, const RuleCompiler::Resolver& resolve)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("cannot open rules file '" + path + "'");
+
+    std::ostringstream text;
+    text << file.rdbuf();
+    return load(text.str(), resolve);
+}
+
+/*
+ *  Description : Compares each expanded group's revision with the one seen
+ *                at compile time, and checks its ID still names the same
+ *                group; any difference recompiles everything. The resolver
+ *                reads the caller's groups, so it runs outside the lock.
+ */
+bool RuleEngine::refresh()
+{
+    std::string source;
+    RuleCompiler::Resolver resolve;
+    std::vector<RuleGroup> groups;
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        if (!_resolve)
+            return false;
+
+        source = _source;
+        resolve = _resolve;
+        groups = _program.groups;
+    }
+
+    const bool stale = std::any_of(groups.begin(), groups.end(), [&resolve](const RuleGroup& g)
+    {
+        return g.group->revision() != g.revision || resolve(g.group->getID()) != g.group;
+    });
+    if (!stale)
+        return false;
+
+    load(source, resolve);
+    return true;
+}
+
+void RuleEngine::clear()
+{
+    Events::EventBus::getInstance().unsubscribe(this);
+
+    std::lock_guard<std::mutex> guard(_mutex);
+    _program = RuleProgram{};
+    _source.clear();
+    _resolve = nullptr;
+}
+
+/*
+ *  Description : One hash lookup finds the input; an unchanged value stops
+ *                there. Otherwise only the input's dependents run, so the
+ *                cost follows the rules that read the device, not the size
+ *                of the rule set.
+ */
+void RuleEngine::onEvent(const DeviceEvent& event)
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+
+    auto it = _program.inputOf.find(event.source);
+    if (it == _program.inputOf.end())
+        return;
+
+    const std::uint32_t input = it->second;
+    if (_program.inputs[input].type != event.type)
+        return;
+
+    const float value = (event.type == EventType::TEMPERATURE) ? event.value : (event.state ? 1.0f : 0.0f);
+    if (_program.values[input] == value)
+        return;
+    _program.values[input] = value;
+
+    for (std::uint32_t d = _program.dependentsBegin[input]; d < _program.dependentsBegin[input + 1]; ++d)
+    {
+        Rule& rule = _program.rules[_program.dependents[d]];
+        const bool active = evaluate(rule);
+        if (active && !rule.active)
+            fire(rule);
+        rule.active = active;
+    }
+
+    // Actions run after every dependent rule saw the new value
+    if (!_journal)
+        _batch.execute();
+    else if (!_batch.empty())
+        Commands::JournaledCommand(_batch.release(), *_journal).execute();
+}
+
+std::size_t RuleEngine::ruleCount() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _program.rules.size();
+}
+
+std::uint64_t RuleEngine::firedCount() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _fired;
+}
+
+/*
+ *  Description : Postfix evaluation on a fixed-size stack; the compiler
+ *                guarantees the depth bound and a single result.
+ */
+bool RuleEngine::evaluate(const Rule& rule) const
+{
+    bool stack[RULE_STACK_DEPTH];
+    std::size_t top = 0;
+
+    const float* values = _program.values.data();
+    for (std::uint32_t pc = rule.codeBegin; pc < rule.codeEnd; ++pc)
+    {
+        const Instruction& instruction = _program.code[pc];
+        switch (instruction.op)
+        {
+            case OpCode::IS_SET:   stack[top++] = values[instruction.input] != 0.0f; break;
+            case OpCode::IS_CLEAR: stack[top++] = values[instruction.input] == 0.0f; break;
+            case OpCode::GREATER:  stack[top++] = values[instruction.input] > instruction.operand; break;
+            case OpCode::LESS:     stack[top++] = values[instruction.input] < instruction.operand; break;
+            case OpCode::AND:      --top; stack[top - 1] = stack[top - 1] && stack[top]; break;
+            case OpCode::OR:       --top; stack[top - 1] = stack[top - 1] || stack[top]; break;
+            case OpCode::NOT:      stack[top - 1] = !stack[top - 1]; break;
+        }
+    }
+    return top == 1 && stack[0];
+}
+
+void RuleEngine::fire(const Rule& rule)
+{
+    for (std::uint32_t a = rule.actionsBegin; a < rule.actionsEnd; ++a)
+        _batch.add(_program.actions[a]);
+
+    ++_fired;
+    Logger::getInstance().log("RuleEngine", "Rule fired", rule.name);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
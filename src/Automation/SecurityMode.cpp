@@ -9,9 +9,11 @@
  ******************************************************************************/
 
 #include "SmartHome/Automation/SecurityMode.hpp"
+#include "SmartHome/Commands/JournaledCommand.hpp"
 #include "SmartHome/Devices/MotionSensor.hpp"
 #include "SmartHome/Devices/Cameras/BaseCamera.hpp"
 #include "SmartHome/Devices/DoorLock.hpp"
+#include "SmartHome/Events/EventBus.hpp"
 
 using namespace SmartHome::Automation;
 using namespace SmartHome::Devices;
@@ -25,71 +27,223 @@ using SmartHome::Utils::Logger;
 /*
  * Constructor: Initializes the SecurityMode with a reference to the system scheduler.
  */
-SecurityMode::SecurityMode(Scheduler& scheduler)
-    : _scheduler(scheduler)
+SecurityMode::SecurityMode(Scheduler& scheduler, SmartHome::Persistence::CommandJournal* journal)
+    : _scheduler(scheduler), _journal(journal)
 {
 }
 
 /*
- * Description : Activates security measures within each device group.
- *               If motion is detected or door is unlocked, camera recording starts.
+ * Destructor: Stops event delivery before the mode goes away.
+ */
+SecurityMode::~SecurityMode()
+{
+    deactivate();
+}
+
+/*
+ * Description : Arms every group that has a camera. Subscribes first, then
+ *               reads its motion sensors and locks once to seed the group's
+ *               facts (how many report motion, how many are unlocked), so a
+ *               change made in between is either read or delivered. Each
+ *               group is then evaluated. From here on only events change
+ *               the facts, so a repeated activate() with the same unchanged
+ *               groups returns without touching a device, unless the bus
+ *               has dropped events since; then the facts are re-read.
+ *               Devices are fetched from the group's type index; the tag
+ *               guarantees the class.
  */
 void SecurityMode::activate(const std::vector<std::shared_ptr<DeviceGroup>>& groups)
 {
-    for (const auto& group : groups)
-    {
-        std::shared_ptr<Cameras::BaseCamera> camera = nullptr;
-        std::shared_ptr<MotionSensor> motionSensor = nullptr;
-        std::shared_ptr<DoorLock> lock = nullptr;
+    // Outside _mutex: delivery holds the bus lock and then takes _mutex
+    Events::EventBus& bus = Events::EventBus::getInstance();
+    bus.subscribe(this, eventMask(EventType::MOTION) | eventMask(EventType::LOCK));
 
-        // Iterate over devices to find relevant ones
-        for (const auto& [id, device] : group->getDevices())
+    std::lock_guard<std::mutex> guard(_mutex);
+    const std::uint64_t dropped = bus.droppedCount();   // Before any device is read
+    if (_armed && isArmedWith(groups))
+    {
+        if (dropped != _droppedSeen)
         {
-            if (!camera)
-                camera = std::dynamic_pointer_cast<Cameras::BaseCamera>(device);
+            _droppedSeen = dropped;
+            resync();
+        }
+        return;
+    }
 
-            if (!motionSensor)
-                motionSensor = std::dynamic_pointer_cast<MotionSensor>(device);
+    _droppedSeen = dropped;
+    _armed = true;
+    _armedGroups.clear();
+    _sensors.clear();
+    _activatedWith.clear();
 
-            if (!lock)
-                lock = std::dynamic_pointer_cast<DoorLock>(device);
-        }
+    for (const auto& group : groups)
+    {
+        _activatedWith.emplace_back(group, group->revision());
 
-        // Condition: motion detected
-        if (motionSensor && motionSensor->isMotionDetected() && camera)
-        {
-            auto recordCmd = std::make_shared<StartRecordingCommand>(camera);
-            recordCmd->execute();
-
-            Logger::getInstance().log(
-                "SecurityMode",
-                "Motion detected - Camera started recording",
-                group->getID()
-            );
-        }
+        const auto& cameras = group->devicesOfType(DeviceType::CAMERA);
+        if (cameras.empty())
+            continue; // Nothing to record with
 
-        // Condition: door is unlocked
-        if (lock && !lock->isDoorLocked() && camera)
-        {
-            auto recordCmd = std::make_shared<StartRecordingCommand>(camera);
-            recordCmd->execute();
-
-            Logger::getInstance().log(
-                "SecurityMode",
-                "Door unlocked - Camera started recording",
-                group->getID()
-            );
-        }
+        const std::size_t index = _armedGroups.size();
+        ArmedGroup& armed = _armedGroups.emplace_back();
+        armed.camera = std::static_pointer_cast<Cameras::BaseCamera>(cameras.front());
+        armed.groupId = group->getID();
+
+        for (const auto& sensor : group->devicesOfType(DeviceType::MOTION_SENSOR))
+            watch(index, sensor.get(), EventType::MOTION);
+        for (const auto& doorLock : group->devicesOfType(DeviceType::DOOR_LOCK))
+            watch(index, doorLock.get(), EventType::LOCK);
     }
+
+    for (ArmedGroup& armed : _armedGroups)
+        evaluate(armed);
 }
 
 /*
- * Description : Handles deactivation of security mode.
- *               Currently placeholder – can be expanded to stop recording, lock doors, etc.
+ * Description : Handles deactivation of security mode. Unsubscribes first,
+ *               which waits for an in-flight event, then disarms all groups.
  */
 void SecurityMode::deactivate()
 {
-    // Optional cleanup: stop recordings, lock doors, etc.
+    Events::EventBus::getInstance().unsubscribe(this);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _armed = false;
+    _armedGroups.clear();
+    _sensors.clear();
+    _activatedWith.clear();
+}
+
+/*
+ * Description : Applies one sensor change. A repeated state is dropped;
+ *               otherwise the counters of the sensor's groups move by one
+ *               and only those groups are evaluated. O(groups of the sensor).
+ */
+void SecurityMode::onEvent(const DeviceEvent& event)
+{
+    if (event.type != EventType::MOTION && event.type != EventType::LOCK)
+        return;
+
+    // Motion present or door unlocked
+    const bool active = (event.type == EventType::MOTION) ? event.state : !event.state;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_armed)
+        return;
+
+    // A lost event leaves a fact stale; the devices themselves are current
+    const std::uint64_t dropped = Events::EventBus::getInstance().droppedCount();
+    if (dropped != _droppedSeen)
+    {
+        _droppedSeen = dropped;
+        resync();
+        return;
+    }
+
+    auto it = _sensors.find(event.source);
+    if (it == _sensors.end() || it->second.active == active)
+        return;
+
+    SensorFact& fact = it->second;
+    fact.active = active;
+
+    for (std::size_t index : fact.groups)
+    {
+        ArmedGroup& armed = _armedGroups[index];
+        std::uint32_t& count = (fact.type == EventType::MOTION) ? armed.motionCount : armed.unlockedCount;
+        count = active ? count + 1 : count - 1;
+
+        if (active)
+            evaluate(armed);
+    }
+}
+
+bool SecurityMode::isArmed() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _armed;
+}
+
+bool SecurityMode::isArmedWith(const std::vector<std::shared_ptr<DeviceGroup>>& groups) const
+{
+    if (groups.size() != _activatedWith.size())
+        return false;
+
+    for (std::size_t i = 0; i < groups.size(); ++i)
+    {
+        if (groups[i] != _activatedWith[i].first || groups[i]->revision() != _activatedWith[i].second)
+            return false;
+    }
+    return true;
+}
+
+bool SecurityMode::isActive(const IDevice* device, EventType type)
+{
+    if (type == EventType::MOTION)
+        return static_cast<const MotionSensor*>(device)->isMotionDetected();
+    return !static_cast<const DoorLock*>(device)->isDoorLocked();
+}
+
+void SecurityMode::watch(std::size_t index, const IDevice* device, EventType type)
+{
+    SensorFact& fact = _sensors[device];
+    fact.type = type;
+    fact.active = isActive(device, type);
+    fact.groups.push_back(index);
+
+    if (fact.active)
+        ++((type == EventType::MOTION) ? _armedGroups[index].motionCount : _armedGroups[index].unlockedCount);
+}
+
+/*
+ * Description : Re-reads every watched device and rebuilds the counters
+ *               from scratch, then evaluates every group. Touches only the
+ *               devices captured at activate(), never the groups, so it is
+ *               safe on the event thread. O(watched devices).
+ */
+void SecurityMode::resync()
+{
+    for (ArmedGroup& armed : _armedGroups)
+        armed.motionCount = armed.unlockedCount = 0;
+
+    for (auto& [device, fact] : _sensors)
+    {
+        fact.active = isActive(device, fact.type);
+        if (!fact.active)
+            continue;
+        for (std::size_t index : fact.groups)
+            ++((fact.type == EventType::MOTION) ? _armedGroups[index].motionCount : _armedGroups[index].unlockedCount);
+    }
+
+    for (ArmedGroup& armed : _armedGroups)
+        evaluate(armed);
+}
+
+/*
+ * Description : Starts recording when the group sees motion or an open door
+ *               and its camera is not already recording. The camera is asked
+ *               directly because it may have been stopped from the menu.
+ */
+void SecurityMode::evaluate(ArmedGroup& armed)
+{
+    if (armed.motionCount == 0 && armed.unlockedCount == 0)
+        return;
+
+    armed.recording = armed.camera->isRecording();
+    if (armed.recording)
+        return; // No redundant StartRecordingCommand
+
+    auto recordCmd = std::make_shared<StartRecordingCommand>(armed.camera);
+    if (_journal)
+        JournaledCommand(recordCmd, *_journal).execute();
+    else
+        recordCmd->execute();
+    armed.recording = true;
+
+    Logger::getInstance().log("SecurityMode",
+                              armed.motionCount ? "Motion detected - Camera started recording"
+                                                : "Door unlocked - Camera started recording",
+                              armed.groupId);
 }
 
 /******************************************************************************
@@ -0,0 +1,147 @@
+/******************************************************************************
+ *  MODULE NAME  : Command Records Implementation
+ *  FILE         : ApplyRecord.cpp
+ *  DESCRIPTION  : Implements applyValue(): dispatches on the record code and
+ *                 the device type tag to the matching device call, and
+ *                 captureValues(), its reading counterpart.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Commands/ApplyRecord.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+
+#include <stdexcept>
+
+using SmartHome::Core::CommandCode;
+using SmartHome::Core::DeviceType;
+using SmartHome::Core::IDevice;
+using namespace SmartHome::Devices;
+
+namespace
+{
+    /*
+     *  Description : Checks the type tag before a static downcast.
+     */
+    template <typename Device>
+    Device& as(IDevice& target, DeviceType type)
+    {
+        if (target.getType() != type)
+            throw std::invalid_argument("command record does not match device '" + target.getID() + "'");
+        return static_cast<Device&>(target);
+    }
+}
+
+void SmartHome::Commands::applyValue(IDevice& target, CommandCode code, float value)
+{
+    const bool on = value != 0.0f;
+
+    switch (code)
+    {
+        case CommandCode::POWER:
+            on ? target.turnOn() : target.turnOff();
+            return;
+
+        case CommandCode::BRIGHTNESS:
+        {
+            // Only the dimmable model has a brightness setter; not a hot path
+            auto* light = dynamic_cast<Lights::DimmableLight*>(&target);
+            if (!light)
+                throw std::invalid_argument("'" + target.getID() + "' is not dimmable");
+            light->setBrightness(static_cast<int>(value));
+            return;
+        }
+
+        case CommandCode::TARGET_TEMPERATURE:
+            as<Thermostats::BaseThermostat>(target, DeviceType::THERMOSTAT).setTargetTemperature(value);
+            return;
+
+        case CommandCode::THERMOSTAT_MODE:
+            as<Thermostats::BaseThermostat>(target, DeviceType::THERMOSTAT)
+                .setMode(static_cast<Thermostats::BaseThermostat::ThermostatMode>(static_cast<int>(value)));
+            return;
+
+        case CommandCode::THERMOSTAT_LAST_MODE:
+            as<Thermostats::BaseThermostat>(target, DeviceType::THERMOSTAT)
+                .setLastMode(static_cast<Thermostats::BaseThermostat::ThermostatMode>(static_cast<int>(value)));
+            return;
+
+        case CommandCode::LOCK:
+        {
+            auto& lock = as<DoorLock>(target, DeviceType::DOOR_LOCK);
+            on ? lock.lockDoor() : lock.unlockDoor();
+            return;
+        }
+
+        case CommandCode::RECORDING:
+        {
+            auto& camera = as<Cameras::BaseCamera>(target, DeviceType::CAMERA);
+            on ? camera.startRecording() : camera.stopRecording();
+            return;
+        }
+
+        case CommandCode::NIGHT_VISION:
+        {
+            auto& camera = as<Cameras::BaseCamera>(target, DeviceType::CAMERA);
+            on ? camera.enableNightVision() : camera.disableNightVision();
+            return;
+        }
+
+        default:
+            break;
+    }
+    throw std::invalid_argument("unknown command record code");
+}
+
+void SmartHome::Commands::captureValues(IDevice& target, std::vector<Core::CommandRecord>& values)
+{
+    auto capture = [&values, &target](CommandCode code, float value)
+    {
+        values.push_back({ code, &target, value, value });
+    };
+
+    switch (target.getType())
+    {
+        case DeviceType::GROUP:
+            for (const auto& member : static_cast<DeviceGroup&>(target).getDevices())
+                captureValues(*member.second, values);
+            return;
+
+        case DeviceType::LIGHT:
+            capture(CommandCode::POWER, target.isOn() ? 1.0f : 0.0f);
+            if (auto* light = dynamic_cast<Lights::DimmableLight*>(&target))
+                capture(CommandCode::BRIGHTNESS, static_cast<float>(light->getBrightness()));
+            return;
+
+        case DeviceType::THERMOSTAT:
+        {
+            auto& thermostat = static_cast<Thermostats::BaseThermostat&>(target);
+            capture(CommandCode::POWER, thermostat.isOn() ? 1.0f : 0.0f);
+            capture(CommandCode::THERMOSTAT_MODE, static_cast<float>(static_cast<int>(thermostat.getMode())));
+            capture(CommandCode::TARGET_TEMPERATURE, thermostat.getTargetTemperature());
+            capture(CommandCode::THERMOSTAT_LAST_MODE, static_cast<float>(static_cast<int>(thermostat.getLastMode())));
+            return;
+        }
+
+        case DeviceType::DOOR_LOCK:
+            capture(CommandCode::LOCK, static_cast<DoorLock&>(target).isDoorLocked() ? 1.0f : 0.0f);
+            return;
+
+        case DeviceType::CAMERA:
+        {
+            auto& camera = static_cast<Cameras::BaseCamera&>(target);
+            capture(CommandCode::POWER, camera.isOn() ? 1.0f : 0.0f);
+            capture(CommandCode::RECORDING, camera.isRecording() ? 1.0f : 0.0f);
+            capture(CommandCode::NIGHT_VISION, camera.isNightVisionEnabled() ? 1.0f : 0.0f);
+            return;
+        }
+
+        default:
+            capture(CommandCode::POWER, target.isOn() ? 1.0f : 0.0f);
+            return;
+    }
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
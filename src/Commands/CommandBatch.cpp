@@ -0,0 +1,195 @@
+/******************************************************************************
+ *  MODULE NAME  : Command Batch Implementation
+ *  FILE         : CommandBatch.cpp
+ *  DESCRIPTION  : Implements the coalescing pass of the CommandBatch and
+ *                 running or releasing the commands it keeps.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Commands/CommandBatch.hpp"
+
+#include <algorithm>
+
+using SmartHome::Commands::CommandBatch;
+using SmartHome::Commands::MacroCommand;
+
+/*
+ * Description : The writes are described right away: targets, codes and
+ *               new values are fixed when a command is constructed.
+ */
+void CommandBatch::add(std::shared_ptr<Core::ICommand> command)
+{
+    if (!command)
+        return;
+
+    if (_coalesce)
+    {
+        command->describe(_writes);
+        _writesEnd.push_back(_writes.size());
+    }
+    _commands.push_back(std::move(command));
+}
+
+/*
+ * Description : Only writes that set a property outright and that no command
+ *               reads back. Lights, cameras and locks qualify for every
+ *               property. A thermostat's power and mode do not: turnOff()
+ *               saves the mode for turnOn() and the target is clamped by the
+ *               mode, so an earlier write changes what a later one does.
+ *               Its target does: nothing reads it and the later write is
+ *               clamped the same either way. Groups fan out to thermostats,
+ *               and unknown devices are kept as well.
+ */
+bool CommandBatch::isCoalescable(Core::DeviceType type, Core::CommandCode code)
+{
+    using Core::CommandCode;
+    using Core::DeviceType;
+
+    switch (type)
+    {
+        case DeviceType::LIGHT:
+        case DeviceType::CAMERA:
+        case DeviceType::DOOR_LOCK:
+            return true;
+        case DeviceType::THERMOSTAT:
+            return code == CommandCode::TARGET_TEMPERATURE;
+        default:
+            return false;
+    }
+}
+
+std::size_t CommandBatch::execute(void)
+{
+    coalesce();
+
+    std::size_t run = 0;
+    try
+    {
+        for (std::size_t i = 0; i < _commands.size(); ++i)
+        {
+            if (_keep[i])
+            {
+                _commands[i]->execute();
+                ++run;
+            }
+        }
+    }
+    catch (...)
+    {
+        clear();    // The rest of the batch is abandoned, not left for the next tick
+        throw;
+    }
+    clear();
+    return run;
+}
+
+std::shared_ptr<MacroCommand> CommandBatch::release(void)
+{
+    coalesce();
+
+    auto macro = std::make_shared<MacroCommand>();
+    for (std::size_t i = 0; i < _commands.size(); ++i)
+    {
+        if (_keep[i])
+            macro->addCommand(std::move(_commands[i]));
+    }
+    clear();
+    return macro;
+}
+
+void CommandBatch::clear(void)
+{
+    _commands.clear();
+    _writes.clear();
+    _writesEnd.clear();
+}
+
+/*
+ * Description : Walks the batch backwards. A command survives if it writes
+ *               at least one key that no later command writes, or one that
+ *               is not coalescable; dropped commands add nothing new to the
+ *               table, since all their keys are in it already.
+ */
+void CommandBatch::coalesce(void)
+{
+    _keep.assign(_commands.size(), true);
+    if (!_coalesce)
+    {
+        _stats.commandsAdded += _commands.size();
+        _stats.commandsRun += _commands.size();
+        return;
+    }
+
+    // Keep the table at most half full
+    std::size_t capacity = 16;
+    while (capacity < 2 * _writes.size())
+        capacity *= 2;
+    if (_later.size() < capacity)
+    {
+        _later.assign(capacity, WriteSlot{});
+        _stamp = 0;
+    }
+    forgetLater();
+
+    for (std::size_t i = _commands.size(); i-- > 0;)
+    {
+        const std::size_t begin = (i == 0) ? 0 : _writesEnd[i - 1];
+        const std::size_t end = _writesEnd[i];
+
+        if (begin == end)
+        {
+            forgetLater();    // Barrier
+            continue;
+        }
+
+        bool superseded = true;
+        for (std::size_t w = begin; w < end; ++w)
+        {
+            const Core::CommandRecord& write = _writes[w];
+            if (markLater(write) || !isCoalescable(write.target->getType(), write.code))
+                superseded = false;
+        }
+        _keep[i] = !superseded;
+
+        _stats.writesAdded += end - begin;
+        if (!superseded)
+            _stats.writesRun += end - begin;
+    }
+
+    _stats.commandsAdded += _commands.size();
+    _stats.commandsRun += static_cast<std::uint64_t>(std::count(_keep.begin(), _keep.end(), true));
+}
+
+bool CommandBatch::markLater(const Core::CommandRecord& write)
+{
+    const std::size_t mask = _later.size() - 1;
+    std::size_t hash = (reinterpret_cast<std::uintptr_t>(write.target) >> 4) * 0x9E3779B97F4A7C15ull
+                       + static_cast<std::size_t>(write.code);
+    hash ^= hash >> 29;
+
+    for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+        WriteSlot& entry = _later[slot];
+        if (entry.stamp != _stamp)
+        {
+            entry = WriteSlot{ write.target, write.code, _stamp };
+            return true;
+        }
+        if (entry.target == write.target && entry.code == write.code)
+            return false;
+    }
+}
+
+void CommandBatch::forgetLater(void)
+{
+    if (++_stamp == 0)
+    {
+        std::fill(_later.begin(), _later.end(), WriteSlot{});
+        _stamp = 1;
+    }
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,84 @@
+/******************************************************************************
+ *  MODULE NAME  : Command Pool Implementation
+ *  FILE         : CommandPool.cpp
+ *  DESCRIPTION  : Implements the size-class free lists and slab growth of
+ *                 the CommandPool.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Commands/CommandPool.hpp"
+
+#include <stdexcept>
+
+using SmartHome::Commands::CommandPool;
+
+CommandPool::CommandPool(std::size_t blocksPerSlab)
+    : _blocksPerSlab(blocksPerSlab)
+{
+    if (blocksPerSlab == 0)
+        throw std::invalid_argument("CommandPool needs at least one block per slab");
+}
+
+std::size_t CommandPool::blocksInUse(void) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _inUse;
+}
+
+std::size_t CommandPool::slabCount(void) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _slabs.size();
+}
+
+void* CommandPool::allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (bytes == 0 || bytes > SIZE_CLASSES * GRANULE || alignment > GRANULE)
+        return ::operator new(bytes);
+
+    const std::size_t sizeClass = (bytes - 1) / GRANULE;
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_free[sizeClass])
+        grow(sizeClass);
+
+    FreeBlock* block = _free[sizeClass];
+    _free[sizeClass] = block->next;
+    ++_inUse;
+    return block;
+}
+
+void CommandPool::deallocate(void* block, std::size_t bytes, std::size_t alignment) noexcept
+{
+    if (bytes == 0 || bytes > SIZE_CLASSES * GRANULE || alignment > GRANULE)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    const std::size_t sizeClass = (bytes - 1) / GRANULE;
+    std::lock_guard<std::mutex> lock(_mutex);
+    FreeBlock* freed = ::new (block) FreeBlock{ _free[sizeClass] };
+    _free[sizeClass] = freed;
+    --_inUse;
+}
+
+/*
+ * Description : Blocks are threaded in address order so a fresh slab is
+ *               handed out front to back.
+ */
+void CommandPool::grow(std::size_t sizeClass)
+{
+    const std::size_t granules = sizeClass + 1;
+    _slabs.emplace_back(new std::max_align_t[granules * _blocksPerSlab]);
+    std::max_align_t* slab = _slabs.back().get();
+
+    FreeBlock* next = _free[sizeClass];
+    for (std::size_t i = _blocksPerSlab; i-- > 0;)
+        next = ::new (slab + i * granules) FreeBlock{ next };
+    _free[sizeClass] = next;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -48,6 +48,18 @@ void DisableNightVisionCommand::undo(void)
     }
 }
 
+/*
+ *  Description: One NIGHT_VISION record for the target, if there is one.
+ */
+void DisableNightVisionCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_camera)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::NIGHT_VISION, _camera.get(),
+                            _wasEnabledBefore ? 1.0f : 0.0f, 0.0f });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
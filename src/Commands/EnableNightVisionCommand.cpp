@@ -43,6 +43,18 @@ void EnableNightVisionCommand::undo(void)
     }
 }
 
+/*
+ *  Description: One NIGHT_VISION record for the target, if there is one.
+ */
+void EnableNightVisionCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_camera)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::NIGHT_VISION, _camera.get(),
+                            _wasEnabledBefore ? 1.0f : 0.0f, 1.0f });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
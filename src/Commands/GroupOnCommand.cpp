@@ -46,6 +46,18 @@ void GroupOnCommand::undo()
     }
 }
 
+/*
+ *  Description: One POWER record for the target, if there is one.
+ */
+void GroupOnCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_group)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::POWER, _group.get(),
+                            _wasOnBefore ? 1.0f : 0.0f, 1.0f });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
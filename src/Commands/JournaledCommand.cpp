@@ -0,0 +1,69 @@
+/******************************************************************************
+ *  MODULE NAME  : Journaled Command Implementation
+ *  FILE         : JournaledCommand.cpp
+ *  DESCRIPTION  : Defines the JournaledCommand decorator.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Commands/JournaledCommand.hpp"
+
+using namespace SmartHome::Commands;
+using SmartHome::Core::CommandRecord;
+using SmartHome::Core::ICommand;
+using SmartHome::Persistence::CommandJournal;
+
+JournaledCommand::JournaledCommand(std::shared_ptr<ICommand> command, CommandJournal& journal)
+    : _command(std::move(command)), _journal(journal)
+{
+}
+
+/*
+ *  Description: Runs the command, then appends one record per write.
+ */
+void JournaledCommand::execute(void)
+{
+    if (!_command)
+        return;
+
+    _command->execute();
+
+    _records.clear();
+    _command->describe(_records);
+    for (const CommandRecord& record : _records)
+    {
+        if (const std::uint64_t lsn = _journal.append(record, record.target->getID()))
+            _lastLsn = lsn;
+    }
+}
+
+/*
+ *  Description: Commands only restore values that changed, so writes
+ *               whose old and new values match are not journaled.
+ */
+void JournaledCommand::undo(void)
+{
+    if (!_command)
+        return;
+
+    _command->undo();
+
+    for (auto it = _records.rbegin(); it != _records.rend(); ++it)
+    {
+        if (it->oldValue == it->newValue)
+            continue;
+        const CommandRecord restore{ it->code, it->target, it->newValue, it->oldValue };
+        if (const std::uint64_t lsn = _journal.append(restore, restore.target->getID()))
+            _lastLsn = lsn;
+    }
+}
+
+void JournaledCommand::describe(std::vector<CommandRecord>& records) const
+{
+    if (_command)
+        _command->describe(records);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
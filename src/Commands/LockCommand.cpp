@@ -48,6 +48,18 @@ void LockCommand::undo(void)
     }
 }
 
+/*
+ *  Description: One LOCK record for the target, if there is one.
+ */
+void LockCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_lock)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::LOCK, _lock.get(),
+                            _wasLockedBefore ? 1.0f : 0.0f, 1.0f });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
@@ -8,8 +8,43 @@
  ******************************************************************************/
 
 #include "SmartHome/Commands/MacroCommand.hpp"
+#include "SmartHome/Commands/ApplyRecord.hpp"
+#include "SmartHome/Devices/DeviceGroup.hpp"
+
+#include <algorithm>
 
 using namespace SmartHome::Commands;
+using SmartHome::Executors::ThreadPool;
+using SmartHome::Executors::TaskGroup;
+using SmartHome::Core::IDevice;
+
+namespace
+{
+    /*
+     *  Description: Adds 'device' and, for a group, every member.
+     */
+    void addTouched(const IDevice* device, std::vector<const IDevice*>& touched)
+    {
+        if (!device)
+            return;
+
+        touched.push_back(device);
+        if (device->getType() == SmartHome::Core::DeviceType::GROUP)
+        {
+            const auto* group = static_cast<const SmartHome::Devices::DeviceGroup*>(device);
+            for (const auto& member : group->getDevices())
+                addTouched(member.second.get(), touched);
+        }
+    }
+}
+
+/*
+ *  Description: Creates a macro that executes its commands on a thread pool.
+ */
+MacroCommand::MacroCommand(ThreadPool& pool)
+    : _pool(&pool)
+{
+}
 
 /*
  *  Description: Adds a new command to the macro command list.
@@ -23,25 +58,66 @@ void MacroCommand::addCommand(std::shared_ptr<ICommand> command)
     }
 }
 
+void MacroCommand::addCommand(std::shared_ptr<ICommand> command, const std::vector<const IDevice*>& touches)
+{
+    if (!command)
+        return;
+
+    for (const IDevice* device : touches)
+    {
+        if (device)
+            _declared.emplace_back(_commands.size(), device);
+    }
+    _commands.push_back(std::move(command));
+}
+
 /*
  *  Description: Executes all stored commands in the order they were added.
+ *               With a pool, the independent sets of each stage run
+ *               concurrently and the call joins on every stage in turn.
  */
 void MacroCommand::execute()
 {
-    for (auto& cmd : _commands)
+    if (_transactional)
+        stagePreImages();
+
+    try
     {
-        if (cmd)
+        if (_pool)
         {
-            cmd->execute();
+            plan();
+            for (std::size_t stage = 0; stage < _stages.size(); ++stage)
+                runStage(stage, true);
+            return;
         }
+
+        for (std::size_t i = 0; i < _commands.size(); ++i)
+        {
+            runCommand(i);
+        }
+    }
+    catch (...)
+    {
+        if (_transactional)
+            rollback();
+        throw;
     }
 }
 
 /*
  *  Description: Undoes all stored commands in reverse order of execution.
+ *               A concurrent undo reuses the plan of the last execute(), so
+ *               the sets match what was executed even if a group changed.
  */
 void MacroCommand::undo()
 {
+    if (_pool && _order.size() == _commands.size())
+    {
+        for (std::size_t stage = _stages.size(); stage-- > 0;)
+            runStage(stage, false);
+        return;
+    }
+
     for (auto it = _commands.rbegin(); it != _commands.rend(); ++it)
     {
         if (*it)
@@ -51,6 +127,253 @@ void MacroCommand::undo()
     }
 }
 
+/*
+ *  Description: Commands are joined into sets with a union-find over the
+ *               devices they touch, found by sorting (device, command)
+ *               pairs; within a set they keep their order.
+ */
+void MacroCommand::plan(void)
+{
+    const std::size_t count = _commands.size();
+    _order.clear();
+    _setsEnd.clear();
+    _stages.clear();
+
+    std::vector<std::size_t> parent(count);
+    auto find = [&parent](std::size_t index)
+    {
+        while (parent[index] != index)
+            index = parent[index] = parent[parent[index]];
+        return index;
+    };
+
+    auto unite = [&find, &parent](std::size_t first, std::size_t second)
+    {
+        // Union by smaller root keeps every set's root its first command
+        const std::size_t a = find(first);
+        const std::size_t b = find(second);
+        if (a < b)
+            parent[b] = a;
+        else
+            parent[a] = b;
+    };
+
+    // (device, command) pairs of the open stage
+    std::vector<std::pair<const IDevice*, std::size_t>> touches;
+
+    // Closes the stage of commands [begin, end): joins commands that share a
+    // device, then counting-sorts them by set, stably
+    std::vector<std::size_t> setOf(count);
+    auto closeStage = [&](std::size_t begin, std::size_t end)
+    {
+        if (begin == end)
+            return;
+
+        std::sort(touches.begin(), touches.end());
+        for (std::size_t t = 1; t < touches.size(); ++t)
+        {
+            if (touches[t].first == touches[t - 1].first)
+                unite(touches[t].second, touches[t - 1].second);
+        }
+        touches.clear();
+
+        const std::size_t firstSet = _setsEnd.size();
+        std::vector<std::size_t> sizes;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const std::size_t root = find(i);
+            if (root == i)
+            {
+                setOf[i] = sizes.size();
+                sizes.push_back(0);
+            }
+            setOf[i] = setOf[root];    // Roots precede their members
+            ++sizes[setOf[i]];
+        }
+
+        std::vector<std::size_t> next(sizes.size());
+        std::size_t offset = _order.size();
+        for (std::size_t set = 0; set < sizes.size(); ++set)
+        {
+            next[set] = offset;
+            offset += sizes[set];
+            _setsEnd.push_back(offset);
+        }
+        _order.resize(offset);
+        for (std::size_t i = begin; i < end; ++i)
+            _order[next[setOf[i]]++] = i;
+
+        _stages.push_back(Stage{ firstSet, _setsEnd.size() });
+    };
+
+    std::vector<SmartHome::Core::CommandRecord> records;
+    std::vector<const IDevice*> touched;
+    std::size_t declared = 0;
+    std::size_t stageBegin = 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        records.clear();
+        touched.clear();
+        _commands[i]->describe(records);
+        for (const auto& record : records)
+            addTouched(record.target, touched);
+        for (; declared < _declared.size() && _declared[declared].first == i; ++declared)
+            addTouched(_declared[declared].second, touched);
+
+        parent[i] = i;
+        if (touched.empty())
+        {
+            // Unknown effects: runs alone, after everything before it
+            closeStage(stageBegin, i);
+            closeStage(i, i + 1);
+            stageBegin = i + 1;
+            continue;
+        }
+
+        for (const IDevice* device : touched)
+            touches.emplace_back(device, i);
+    }
+    closeStage(stageBegin, count);
+}
+
+/*
+ *  Description: Sets are dealt round-robin to at most one task per worker,
+ *               so small commands do not each pay for a task.
+ */
+void MacroCommand::runStage(std::size_t stage, bool forwards)
+{
+    const std::size_t begin = _stages[stage].setsBegin;
+    const std::size_t end = _stages[stage].setsEnd;
+    if (end - begin == 1)
+    {
+        runSet(begin, forwards);
+        return;
+    }
+
+    const std::size_t tasks = std::min(end - begin, _pool->size());
+    TaskGroup group(*_pool);
+    for (std::size_t task = 0; task < tasks; ++task)
+    {
+        group.run([this, begin, end, task, tasks, forwards]()
+        {
+            for (std::size_t set = begin + task; set < end; set += tasks)
+                runSet(set, forwards);
+        });
+    }
+    group.wait();
+}
+
+void MacroCommand::runSet(std::size_t set, bool forwards)
+{
+    const std::size_t begin = (set == 0) ? 0 : _setsEnd[set - 1];
+    const std::size_t end = _setsEnd[set];
+
+    if (forwards)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            runCommand(_order[i]);
+    }
+    else
+    {
+        for (std::size_t i = end; i-- > begin;)
+            _commands[_order[i]]->undo();
+    }
+}
+
+void MacroCommand::runCommand(std::size_t index)
+{
+    if (_transactional)
+        _progress[index] = STARTED;
+    _commands[index]->execute();
+    if (_transactional)
+        _progress[index] = FINISHED;
+}
+
+/*
+ *  Description: Values are read through captureValues(), a few floats per
+ *               device in buffers kept across runs; no undo objects.
+ */
+void MacroCommand::stagePreImages(void)
+{
+    _targets.clear();
+    _targetsEnd.clear();
+    for (const auto& cmd : _commands)
+    {
+        _images.clear();
+        cmd->describe(_images);    // Scratch: only the targets are used
+        for (const auto& record : _images)
+        {
+            if (record.target)
+                _targets.push_back(record.target);
+        }
+        _targetsEnd.push_back(_targets.size());
+    }
+
+    _staged.assign(_targets.begin(), _targets.end());
+    std::sort(_staged.begin(), _staged.end());
+    _staged.erase(std::unique(_staged.begin(), _staged.end()), _staged.end());
+
+    _images.clear();
+    _imagesEnd.clear();
+    for (IDevice* device : _staged)
+    {
+        captureValues(*device, _images);
+        _imagesEnd.push_back(_images.size());
+    }
+
+    _progress.assign(_commands.size(), NOT_STARTED);
+}
+
+/*
+ *  Description: A command that started may have written part of its
+ *               targets before failing, so its targets are restored too.
+ */
+void MacroCommand::rollback(void)
+{
+    _restore.assign(_staged.size(), 0);
+
+    for (std::size_t i = _commands.size(); i-- > 0;)
+    {
+        if (_progress[i] == NOT_STARTED)
+            continue;
+
+        const std::size_t begin = (i == 0) ? 0 : _targetsEnd[i - 1];
+        const std::size_t end = _targetsEnd[i];
+        if (begin == end)
+        {
+            if (_progress[i] == FINISHED)
+                _commands[i]->undo();    // Nothing to restore it from
+            continue;
+        }
+
+        for (std::size_t t = begin; t < end; ++t)
+        {
+            const auto it = std::lower_bound(_staged.begin(), _staged.end(), _targets[t]);
+            _restore[static_cast<std::size_t>(it - _staged.begin())] = 1;
+        }
+    }
+
+    for (std::size_t d = 0; d < _staged.size(); ++d)
+    {
+        if (!_restore[d])
+            continue;
+        for (std::size_t v = (d == 0) ? 0 : _imagesEnd[d - 1]; v < _imagesEnd[d]; ++v)
+            applyValue(*_images[v].target, _images[v].code, _images[v].oldValue);
+    }
+}
+
+void MacroCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    for (const auto& cmd : _commands)
+    {
+        if (cmd)
+        {
+            cmd->describe(records);
+        }
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
@@ -45,6 +45,18 @@ void SetBrightnessCommand::undo(void)
     }
 }
 
+/*
+ *  Description: One BRIGHTNESS record for the target, if there is one.
+ */
+void SetBrightnessCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_light)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::BRIGHTNESS, _light.get(),
+                            static_cast<float>(_oldBrightness), static_cast<float>(_newBrightness) });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
@@ -46,6 +46,18 @@ void SetTargetTemperatureCommand::undo(void)
     }
 }
 
+/*
+ *  Description: One TARGET_TEMPERATURE record for the target, if there is one.
+ */
+void SetTargetTemperatureCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_temperature)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::TARGET_TEMPERATURE, _temperature.get(),
+                            static_cast<float>(_oldTemperature), static_cast<float>(_newTargetTemperature) });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
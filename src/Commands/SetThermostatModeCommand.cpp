@@ -51,6 +51,18 @@ void SetThermostatModeCommand::undo(void)
     }
 }
 
+/*
+ *  Description: One THERMOSTAT_MODE record for the target, if there is one.
+ */
+void SetThermostatModeCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_thermostat)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::THERMOSTAT_MODE, _thermostat.get(),
+                            static_cast<float>(_oldMode), static_cast<float>(_newMode) });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
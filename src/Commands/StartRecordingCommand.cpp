@@ -45,6 +45,18 @@ void StartRecordingCommand::undo(void)
     }
 }
 
+/*
+ *  Description: One RECORDING record for the target, if there is one.
+ */
+void StartRecordingCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_camera)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::RECORDING, _camera.get(),
+                            _wasRecordingBefore ? 1.0f : 0.0f, 1.0f });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
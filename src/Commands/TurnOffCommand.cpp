@@ -46,6 +46,18 @@ void TurnOffCommand::undo(void)
     }
 }
 
+/*
+ *  Description: One POWER record for the target, if there is one.
+ */
+void TurnOffCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_device)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::POWER, _device.get(),
+                            _wasOnBefore ? 1.0f : 0.0f, 0.0f });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
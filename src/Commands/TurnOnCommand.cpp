@@ -46,6 +46,18 @@ void TurnOnCommand::undo(void)
     }
 }
 
+/*
+ *  Description: One POWER record for the target, if there is one.
+ */
+void TurnOnCommand::describe(std::vector<SmartHome::Core::CommandRecord>& records) const
+{
+    if (_device)
+    {
+        records.push_back({ SmartHome::Core::CommandCode::POWER, _device.get(),
+                            _wasOnBefore ? 1.0f : 0.0f, 1.0f });
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
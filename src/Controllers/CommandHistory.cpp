@@ -0,0 +1,218 @@
+/******************************************************************************
+ *  MODULE NAME  : Command History Implementation
+ *  FILE         : CommandHistory.cpp
+ *  DESCRIPTION  : Implements the CommandHistory ring: recording, dropping
+ *                 the oldest commands, undo / redo through
+ *                 Commands::applyValue and target table upkeep.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Controllers/CommandHistory.hpp"
+#include "SmartHome/Commands/ApplyRecord.hpp"
+
+#include <stdexcept>
+#include <type_traits>
+
+using SmartHome::Controller::CommandHistory;
+using SmartHome::Core::CommandRecord;
+using SmartHome::Core::IDevice;
+
+CommandHistory::CommandHistory(std::size_t capacity, Owner owner)
+    : _ring(capacity + 1), _owner(std::move(owner))
+{
+    static_assert(std::is_trivially_copyable<Entry>::value && sizeof(Entry) == 16,
+                  "history entries are meant to stay small and flat");
+
+    if (capacity == 0 || !_owner)
+        throw std::invalid_argument("CommandHistory needs a capacity and an owner lookup");
+}
+
+/*
+ * Description : Resolves every target first, so a command with a target the
+ *               owner does not know is not recorded at all rather than in part.
+ */
+void CommandHistory::push(const std::vector<CommandRecord>& writes)
+{
+    if (writes.empty())
+        return;
+
+    // A new command ends the redo branch
+    _end = _cursor;
+    _redoCommands = 0;
+
+    if (writes.size() > _ring.size() - 1)
+    {
+        clear();    // Cannot be undone as a whole; older commands would be unsafe to undo past it
+        return;
+    }
+
+    _slots.resize(writes.size());
+    for (std::size_t i = 0; i < writes.size(); ++i)
+    {
+        if (!writes[i].target || !slotOf(writes[i].target, _slots[i]))
+            return;
+    }
+
+    while (_ring.size() - 1 - used() < writes.size())
+        dropOldest();
+
+    for (std::size_t i = 0; i < writes.size(); ++i)
+    {
+        const CommandRecord& write = writes[i];
+        const std::uint8_t flags = (i + 1 == writes.size()) ? LAST_OF_COMMAND : 0;
+        _ring[_end] = Entry{ write.code, flags, 0, _slots[i], write.oldValue, write.newValue };
+        _end = next(_end);
+    }
+    _cursor = _end;
+    ++_undoCommands;
+
+    if (_targets.size() > 2 * _ring.size())
+        compactTargets();
+}
+
+/*
+ * Description : Mirrors the commands' own undo(): a value that did not
+ *               change is not written back.
+ */
+bool CommandHistory::undo(std::vector<CommandRecord>& applied)
+{
+    if (!canUndo())
+        return false;
+
+    std::size_t position = _cursor;
+    do
+    {
+        position = prev(position);
+        const Entry& entry = _ring[position];
+        if (entry.oldValue != entry.newValue)
+            apply(entry, entry.oldValue, applied);
+    } while (position != _begin && !(_ring[prev(position)].flags & LAST_OF_COMMAND));
+
+    _cursor = position;
+    --_undoCommands;
+    ++_redoCommands;
+    return true;
+}
+
+/*
+ * Description : Writes the new values again in their original order, like
+ *               a second execute().
+ */
+bool CommandHistory::redo(std::vector<CommandRecord>& applied)
+{
+    if (!canRedo())
+        return false;
+
+    std::size_t position = _cursor;
+    bool last = false;
+    while (!last)
+    {
+        const Entry& entry = _ring[position];
+        apply(entry, entry.newValue, applied);
+        last = (entry.flags & LAST_OF_COMMAND) != 0;
+        position = next(position);
+    }
+
+    _cursor = position;
+    ++_undoCommands;
+    --_redoCommands;
+    return true;
+}
+
+void CommandHistory::clear(void)
+{
+    _begin = _cursor = _end = 0;
+    _undoCommands = _redoCommands = 0;
+    _targets.clear();
+    _slotByDevice.clear();
+    _lastDevice = nullptr;
+}
+
+/*
+ * Description : A slot whose target died is never reused: records pointing
+ *               at it must keep resolving to nothing, even if a new device
+ *               is allocated at the same address.
+ */
+bool CommandHistory::slotOf(IDevice* device, std::uint32_t& slot)
+{
+    // Consecutive commands usually hit the same device
+    if (device == _lastDevice && !_targets[_lastSlot].expired())
+    {
+        slot = _lastSlot;
+        return true;
+    }
+
+    auto it = _slotByDevice.find(device);
+    if (it != _slotByDevice.end() && !_targets[it->second].expired())
+    {
+        slot = it->second;
+        _lastDevice = device;
+        _lastSlot = slot;
+        return true;
+    }
+
+    std::shared_ptr<IDevice> owned = _owner(*device);
+    if (!owned || owned.get() != device)
+        return false;
+
+    slot = static_cast<std::uint32_t>(_targets.size());
+    _targets.push_back(owned);
+    _slotByDevice[device] = slot;
+    _lastDevice = device;
+    _lastSlot = slot;
+    return true;
+}
+
+void CommandHistory::dropOldest(void)
+{
+    bool last = false;
+    while (!last && _begin != _cursor)
+    {
+        last = (_ring[_begin].flags & LAST_OF_COMMAND) != 0;
+        _begin = next(_begin);
+    }
+    --_undoCommands;
+}
+
+void CommandHistory::compactTargets(void)
+{
+    constexpr std::uint32_t UNMAPPED = 0xFFFFFFFFu;
+    std::vector<std::uint32_t> remap(_targets.size(), UNMAPPED);
+    std::vector<std::weak_ptr<IDevice>> targets;
+    _slotByDevice.clear();
+
+    for (std::size_t position = _begin; position != _end; position = next(position))
+    {
+        std::uint32_t& slot = remap[_ring[position].target];
+        if (slot == UNMAPPED)
+        {
+            slot = static_cast<std::uint32_t>(targets.size());
+            targets.push_back(_targets[_ring[position].target]);
+            if (std::shared_ptr<IDevice> live = targets.back().lock())
+                _slotByDevice[live.get()] = slot;
+        }
+        _ring[position].target = slot;
+    }
+    _targets.swap(targets);
+    _lastDevice = nullptr;
+}
+
+/*
+ * Description : Skips targets that no longer exist; reports the write made
+ *               as a record going from the other value to 'value'.
+ */
+void CommandHistory::apply(const Entry& entry, float value, std::vector<CommandRecord>& applied)
+{
+    const std::shared_ptr<IDevice> target = _targets[entry.target].lock();
+    if (!target)
+        return;
+
+    Commands::applyValue(*target, entry.code, value);
+    const float from = (value == entry.newValue) ? entry.oldValue : entry.newValue;
+    applied.push_back(CommandRecord{ entry.code, target.get(), from, value });
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
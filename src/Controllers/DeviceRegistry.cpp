@@ -0,0 +1,269 @@
+/******************************************************************************
+ *  MODULE NAME  : Device Registry Implementation
+ *  FILE         : DeviceRegistry.cpp
+ *  DESCRIPTION  : Implements the DeviceRegistry: dense device arrays, an
+ *                 interned-ID arena and a linear-probing hash index that
+ *                 uses backward-shift deletion, so no tombstones build up.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Controllers/DeviceRegistry.hpp"
+
+#include <cstring>
+#include <string>
+
+using SmartHome::Controller::DeviceRegistry;
+using SmartHome::Core::IDevice;
+
+/*
+ * Description : Starts with a small table; it doubles at 50% load.
+ */
+DeviceRegistry::DeviceRegistry()
+    : _buckets(16), _mask(15)
+{
+}
+
+/*
+ * Description : Mixes the ID eight bytes at a time; IDs are typically
+ *               longer than a few bytes, so a byte-wise hash costs more
+ *               than the probe itself.
+ */
+std::uint32_t DeviceRegistry::hashOf(std::string_view id)
+{
+    constexpr std::uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ull;
+
+    std::uint64_t hash = id.size() * MULTIPLIER;
+    std::size_t offset = 0;
+    for (; offset + 8 <= id.size(); offset += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, id.data() + offset, 8);
+        hash = (hash ^ word) * MULTIPLIER;
+        hash ^= hash >> 29;
+    }
+
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, id.data() + offset, id.size() - offset);
+    hash = (hash ^ tail) * MULTIPLIER;
+    hash ^= hash >> 32;
+    return static_cast<std::uint32_t>(hash);
+}
+
+/*
+ * Description : Copies an ID into the arena and returns a view that stays
+ *               valid for the registry's lifetime. Space of removed IDs is
+ *               not reclaimed.
+ */
+std::string_view DeviceRegistry::intern(std::string_view id)
+{
+    if (id.size() > ARENA_BLOCK)
+    {
+        // Oversized IDs get a block of their own; the current block stays open
+        auto block = std::make_unique<char[]>(id.size());
+        std::memcpy(block.get(), id.data(), id.size());
+
+        const char* stored = block.get();
+        _arena.insert(_arena.empty() ? _arena.end() : _arena.end() - 1, std::move(block));
+        return { stored, id.size() };
+    }
+
+    if (_arenaUsed + id.size() > ARENA_BLOCK)
+    {
+        _arena.push_back(std::make_unique<char[]>(ARENA_BLOCK));
+        _arenaUsed = 0;
+    }
+
+    char* dest = _arena.back().get() + _arenaUsed;
+    std::memcpy(dest, id.data(), id.size());
+    _arenaUsed += id.size();
+    return { dest, id.size() };
+}
+
+/*
+ * Description : Returns the bucket holding 'id', or the empty bucket where
+ *               it would be inserted.
+ */
+std::size_t DeviceRegistry::probe(std::string_view id, std::uint32_t hash) const
+{
+    std::size_t bucket = hash & _mask;
+    while (_buckets[bucket].handle != EMPTY)
+    {
+        const Bucket& candidate = _buckets[bucket];
+        if (candidate.hash == hash && candidate.id == id)
+            return bucket;
+        bucket = (bucket + 1) & _mask;
+    }
+    return bucket;
+}
+
+/*
+ * Description : Doubles the table and reinserts every entry.
+ */
+void DeviceRegistry::grow()
+{
+    std::vector<Bucket> old(_buckets.size() * 2);
+    old.swap(_buckets);
+    _mask = _buckets.size() - 1;
+
+    for (const Bucket& entry : old)
+    {
+        if (entry.handle == EMPTY)
+            continue;
+
+        std::size_t bucket = entry.hash & _mask;
+        while (_buckets[bucket].handle != EMPTY)
+            bucket = (bucket + 1) & _mask;
+        _buckets[bucket] = entry;
+    }
+}
+
+/*
+ * Description : Empties a bucket and shifts later members of its probe run
+ *               back so every lookup still finds them.
+ */
+void DeviceRegistry::eraseBucket(std::size_t hole)
+{
+    std::size_t next = (hole + 1) & _mask;
+    while (_buckets[next].handle != EMPTY)
+    {
+        const std::size_t home = _buckets[next].hash & _mask;
+
+        // Move the entry only if its home does not lie in (hole, next]
+        const bool homeBetween = (hole <= next) ? (hole < home && home <= next)
+                                                : (hole < home || home <= next);
+        if (!homeBetween)
+        {
+            _buckets[hole] = _buckets[next];
+            hole = next;
+        }
+        next = (next + 1) & _mask;
+    }
+    _buckets[hole] = Bucket{};
+}
+
+/*
+ * Description : True if the handle refers to a live device.
+ */
+bool DeviceRegistry::resolve(DeviceHandle handle) const
+{
+    return handle.index < _slots.size()
+        && _slots[handle.index].generation == handle.generation
+        && _slots[handle.index].dense != EMPTY;
+}
+
+/*
+ * Description : Registers a device and indexes its interned ID.
+ */
+DeviceRegistry::DeviceHandle DeviceRegistry::add(std::shared_ptr<IDevice> device)
+{
+    if (!device)
+        return {};
+
+    const std::string id = device->getID();
+    const std::uint32_t hash = hashOf(id);
+
+    std::size_t bucket = probe(id, hash);
+    if (_buckets[bucket].handle != EMPTY)
+        return {};
+
+    if ((_devices.size() + 1) * 2 > _buckets.size())
+    {
+        grow();
+        bucket = probe(id, hash);
+    }
+
+    std::uint32_t index;
+    if (!_freeSlots.empty())
+    {
+        index = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<std::uint32_t>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    const std::string_view interned = intern(id);
+
+    _slots[index].dense = static_cast<std::uint32_t>(_devices.size());
+    _devices.push_back(std::move(device));
+    _ids.push_back(interned);
+    _denseToHandle.push_back(index);
+
+    _buckets[bucket] = Bucket{ hash, index, _slots[index].generation, _slots[index].dense, interned };
+    return { index, _slots[index].generation };
+}
+
+/*
+ * Description : Unregisters a device; the last dense entry fills its place.
+ */
+bool DeviceRegistry::remove(DeviceHandle handle)
+{
+    if (!resolve(handle))
+        return false;
+
+    const std::uint32_t dense = _slots[handle.index].dense;
+    eraseBucket(probe(_ids[dense], hashOf(_ids[dense])));
+
+    const std::uint32_t last = static_cast<std::uint32_t>(_devices.size() - 1);
+    if (dense != last)
+    {
+        _buckets[probe(_ids[last], hashOf(_ids[last]))].dense = dense;
+        _devices[dense] = std::move(_devices[last]);
+        _ids[dense] = _ids[last];
+        _denseToHandle[dense] = _denseToHandle[last];
+        _slots[_denseToHandle[dense]].dense = dense;
+    }
+    _devices.pop_back();
+    _ids.pop_back();
+    _denseToHandle.pop_back();
+
+    _slots[handle.index].dense = EMPTY;
+    ++_slots[handle.index].generation;
+    _freeSlots.push_back(handle.index);
+    return true;
+}
+
+bool DeviceRegistry::remove(std::string_view id)
+{
+    return remove(find(id));
+}
+
+/*
+ * Description : O(1) expected lookup; hashes the view, never allocates.
+ */
+DeviceRegistry::DeviceHandle DeviceRegistry::find(std::string_view id) const
+{
+    const Bucket& bucket = _buckets[probe(id, hashOf(id))];
+    if (bucket.handle == EMPTY)
+        return {};
+    return { bucket.handle, bucket.generation };
+}
+
+const std::shared_ptr<IDevice>* DeviceRegistry::get(DeviceHandle handle) const
+{
+    if (!resolve(handle))
+        return nullptr;
+    return &_devices[_slots[handle.index].dense];
+}
+
+const std::shared_ptr<IDevice>* DeviceRegistry::get(std::string_view id) const
+{
+    const Bucket& bucket = _buckets[probe(id, hashOf(id))];
+    if (bucket.handle == EMPTY)
+        return nullptr;
+    return &_devices[bucket.dense];
+}
+
+std::string_view DeviceRegistry::idOf(DeviceHandle handle) const
+{
+    if (!resolve(handle))
+        return {};
+    return _ids[_slots[handle.index].dense];
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
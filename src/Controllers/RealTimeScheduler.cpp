@@ -0,0 +1,234 @@
+/******************************************************************************
+ *  MODULE NAME  : Real-Time Scheduler Implementation
+ *  FILE         : RealTimeScheduler.cpp
+ *  DESCRIPTION  : Implements the steady_clock-driven scheduler thread on top
+ *                 of the Scheduler timing wheel.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Controllers/RealTimeScheduler.hpp"
+#include <climits>
+#include <cstdint>
+
+using namespace SmartHome::Controller;
+
+RealTimeScheduler::RealTimeScheduler(Executor executor)
+    : _executor(std::move(executor)), _origin(Clock::now())
+{
+}
+
+RealTimeScheduler::~RealTimeScheduler()
+{
+    stop();
+}
+
+/*
+ *  Description: Starts the timer thread, plus the dispatch thread when no
+ *               external executor was supplied.
+ */
+void RealTimeScheduler::start()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_running)
+        return;
+
+    _running = true;
+
+    if (!_executor)
+    {
+        {
+            std::lock_guard<std::mutex> dispatchLock(_dispatchMutex);
+            _dispatchRunning = true;
+        }
+        _dispatchThread = std::thread(&RealTimeScheduler::dispatchLoop, this);
+    }
+
+    _timerThread = std::thread(&RealTimeScheduler::timerLoop, this);
+}
+
+/*
+ *  Description: Stops the timer thread first so nothing new is dispatched,
+ *               then lets the dispatcher finish its queue.
+ */
+void RealTimeScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_running)
+            return;
+        _running = false;
+    }
+    _wake.notify_all();
+    _timerThread.join();
+
+    if (_dispatchThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> dispatchLock(_dispatchMutex);
+            _dispatchRunning = false;
+        }
+        _dispatchReady.notify_all();
+        _dispatchThread.join();
+    }
+}
+
+/*
+ *  Description: Schedules a task 'delay' from now and wakes the timer thread
+ *               in case this is now the earliest deadline.
+ */
+RealTimeScheduler::TimerHandle RealTimeScheduler::scheduleAfter(std::chrono::microseconds delay, ScheduledTask task)
+{
+    if (!task)
+        return TimerHandle{};
+
+    TimerHandle handle;
+    {
+        // Under _mutex so the timer thread cannot miss the wake-up between
+        // reading the next due time and going to sleep
+        std::lock_guard<std::mutex> lock(_mutex);
+        handle = _wheel.scheduleAt(deadlineTick(delay), handOff(std::move(task)));
+    }
+    _wake.notify_one();
+    return handle;
+}
+
+/*
+ *  Description: Keyed variant; replaces the task pending under dedupKey.
+ */
+RealTimeScheduler::TimerHandle RealTimeScheduler::scheduleAfter(std::chrono::microseconds delay, ScheduledTask task,
+                                                                const std::string& dedupKey)
+{
+    if (!task)
+        return TimerHandle{};
+
+    TimerHandle handle;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        handle = _wheel.scheduleAt(deadlineTick(delay), handOff(std::move(task)), dedupKey);
+    }
+    _wake.notify_one();
+    return handle;
+}
+
+/*
+ *  Description: Cancels a pending task.
+ */
+bool RealTimeScheduler::cancel(TimerHandle handle)
+{
+    return _wheel.cancel(handle);
+}
+
+std::size_t RealTimeScheduler::pendingCount() const
+{
+    return _wheel.pendingCount();
+}
+
+/*
+ *  Description: Brings the wheel up to the current time (firing hand-offs),
+ *               then sleeps until the wheel's next due time or a new,
+ *               possibly earlier, timer is scheduled. The wheel locks
+ *               itself; _mutex is released while it ticks, so an executor
+ *               that runs tasks inline may schedule and cancel from them.
+ */
+void RealTimeScheduler::timerLoop()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (_running)
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - _origin);
+        const std::uint64_t nowTick = static_cast<std::uint64_t>(elapsed / TICK);
+
+        lock.unlock();
+        do
+        {
+            // tick() also runs tasks that became due "now" since the last pass
+            const std::uint64_t lag = nowTick - _wheel.now();
+            _wheel.tick(static_cast<int>(lag > INT_MAX ? INT_MAX : lag));
+        } while (_wheel.now() < nowTick);
+        lock.lock();
+
+        if (!_running)
+            break;
+
+        const std::uint64_t due = _wheel.nextDueTime();
+        if (due == UINT64_MAX)
+        {
+            _wake.wait(lock);
+        }
+        else if (due > _wheel.now())
+        {
+            _wake.wait_until(lock, _origin + TICK * static_cast<std::int64_t>(due));
+        }
+    }
+}
+
+/*
+ *  Description: Runs handed-off tasks one by one outside any scheduler lock.
+ */
+void RealTimeScheduler::dispatchLoop()
+{
+    std::unique_lock<std::mutex> lock(_dispatchMutex);
+
+    while (true)
+    {
+        _dispatchReady.wait(lock, [this] { return !_dispatchQueue.empty() || !_dispatchRunning; });
+        if (_dispatchQueue.empty())
+            break;
+
+        ScheduledTask task = std::move(_dispatchQueue.front());
+        _dispatchQueue.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+/*
+ *  Description: Rounds 'now + delay' up to a whole tick. Tick numbers stay
+ *               64-bit throughout and the wheel takes the absolute tick, so
+ *               no delay is narrowed and a deadline the wheel's clock has
+ *               already reached simply fires on its next pass.
+ */
+std::uint64_t RealTimeScheduler::deadlineTick(std::chrono::microseconds delay) const
+{
+    using std::chrono::microseconds;
+
+    if (delay.count() < 0)
+        delay = microseconds(0);
+
+    const auto elapsed = std::chrono::duration_cast<microseconds>(Clock::now() - _origin);
+    if (delay > microseconds::max() - elapsed - TICK)
+        return UINT64_MAX;      // Beyond any uptime; never fires
+
+    const auto deadline = elapsed + delay;
+    return static_cast<std::uint64_t>((deadline + TICK - microseconds(1)) / TICK);
+}
+
+/*
+ *  Description: Firing the returned wrapper only passes the real task to the
+ *               executor (or the internal dispatch queue).
+ */
+RealTimeScheduler::ScheduledTask RealTimeScheduler::handOff(ScheduledTask task)
+{
+    return [this, task = std::move(task)]() mutable
+    {
+        if (_executor)
+        {
+            _executor(std::move(task));
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> dispatchLock(_dispatchMutex);
+            _dispatchQueue.push_back(std::move(task));
+        }
+        _dispatchReady.notify_one();
+    };
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
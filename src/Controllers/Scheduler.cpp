@@ -2,57 +2,530 @@
  *  MODULE NAME  : Scheduler Implementation
  *  FILE         : Scheduler.cpp
  *  DESCRIPTION  : Implements the task scheduling system that allows delayed 
- *                 task execution based on simulated time progression.
+ *                 task execution based on simulated time progression, using
+ *                 a hierarchical timing wheel.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : July 2025
  ******************************************************************************/
 
 #include "SmartHome/Controllers/Scheduler.hpp"
+#include <cstdint>
 
 using namespace SmartHome::Controller;
 
+namespace
+{
+    /*
+     * Description: Index of the first set bit at or after 'from' in a 256-bit
+     *              map, or 256 if there is none.
+     */
+    unsigned findNextSet(const std::array<std::uint64_t, 4>& bits, unsigned from)
+    {
+        for (unsigned word = from / 64; word < 4; ++word)
+        {
+            std::uint64_t value = bits[word];
+            if (word == from / 64)
+                value &= ~std::uint64_t(0) << (from % 64);
+
+            if (value)
+                return word * 64 + static_cast<unsigned>(__builtin_ctzll(value));
+        }
+        return 256;
+    }
+}
+
 /*
  *  Description: Schedules a task to be executed after a specified delay.
  *  Parameters :
  *      - delaySeconds : Number of seconds to wait before executing the task.
  *      - task         : Callable to execute (must be non-null).
  */
-void Scheduler::scheduleAfter(int delaySeconds, ScheduledTask task)
+Scheduler::TimerHandle Scheduler::scheduleAfter(int delaySeconds, ScheduledTask task)
 {
-    if (delaySeconds < 0 || !task)
-        return;
+    if (delaySeconds < 0)
+        return TimerHandle{};
 
-    ScheduledEntry entry;
-    entry.executionTime = _currentTime + delaySeconds;
-    entry.task = std::move(task);
+    std::lock_guard<std::mutex> lock(_mutex);
+    return scheduleLocked(_currentTime + static_cast<TimePoint>(delaySeconds), std::move(task));
+}
+
+/*
+ *  Description: Schedules a task under a deduplication key, replacing the
+ *               task already pending under that key instead of adding one.
+ *  Parameters :
+ *      - delaySeconds : Number of seconds to wait before executing the task.
+ *      - task         : Callable to execute (must be non-null).
+ *      - dedupKey     : Key identifying interchangeable timers.
+ */
+Scheduler::TimerHandle Scheduler::scheduleAfter(int delaySeconds, ScheduledTask task, const std::string& dedupKey)
+{
+    if (delaySeconds < 0)
+        return TimerHandle{};
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    return scheduleKeyedLocked(_currentTime + static_cast<TimePoint>(delaySeconds), std::move(task), dedupKey);
+}
 
-    _taskQueue.push(std::move(entry));
+/*
+ *  Description: Schedules a task at an absolute time on the scheduler's
+ *               clock; a time already passed runs on the next tick.
+ */
+Scheduler::TimerHandle Scheduler::scheduleAt(std::uint64_t time, ScheduledTask task)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return scheduleLocked(time, std::move(task));
+}
+
+Scheduler::TimerHandle Scheduler::scheduleAt(std::uint64_t time, ScheduledTask task, const std::string& dedupKey)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return scheduleKeyedLocked(time, std::move(task), dedupKey);
+}
+
+/*
+ *  Description: Unlinks a pending task from its slot and recycles its entry.
+ */
+bool Scheduler::cancel(TimerHandle handle)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return cancelLocked(handle);
+}
+
+/*
+ *  Description: Cancels the task pending under a deduplication key.
+ */
+bool Scheduler::cancel(const std::string& dedupKey)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _byKey.find(dedupKey);
+    return it != _byKey.end() && cancelLocked(it->second);
+}
+
+/*
+ *  Description: Moves a pending task to a new due time without reallocating it.
+ */
+bool Scheduler::reschedule(TimerHandle handle, int delaySeconds)
+{
+    if (delaySeconds < 0)
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    return rescheduleLocked(handle, _currentTime + static_cast<TimePoint>(delaySeconds));
+}
+
+/*
+ *  Description: Returns true while the handle's task is waiting to run.
+ */
+bool Scheduler::isPending(TimerHandle handle) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return resolve(handle) != NIL;
 }
 
 /*
  *  Description: Advances the scheduler's internal clock and executes all 
- *               tasks whose scheduled time has been reached.
+ *               tasks whose scheduled time has been reached, in time order.
  *  Parameters :
  *      - secondsElapsed : Number of seconds to advance time.
  */
 void Scheduler::tick(int secondsElapsed)
 {
-    _currentTime += secondsElapsed;
+    if (secondsElapsed < 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    const TimePoint target = _currentTime + static_cast<TimePoint>(secondsElapsed);
+
+    // Tasks scheduled with no delay since the last tick are due now
+    runDueSlot(lock);
+
+    while (_currentTime < target)
+    {
+        if (_pending == 0)
+        {
+            _currentTime = target;
+            break;
+        }
+
+        const TimePoint next = nextEventTime();
+        if (next > target)
+        {
+            _currentTime = target;
+            break;
+        }
+
+        _currentTime = next;
+        if ((_currentTime & WHEEL_MASK) == 0)
+            cascade();
+        runDueSlot(lock);
+    }
+}
+
+/*
+ *  Description: Sets where due tasks run; empty means inline in tick().
+ */
+void Scheduler::setExecutor(Executor executor)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _executor = std::move(executor);
+}
 
-    while (!_taskQueue.empty())
+/*
+ *  Description: Returns the number of tasks waiting to run.
+ */
+std::size_t Scheduler::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending;
+}
+
+/*
+ *  Description: Returns the current time of the scheduler's clock.
+ */
+std::uint64_t Scheduler::now() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _currentTime;
+}
+
+/*
+ *  Description: Finds the finest wheel with an occupied slot ahead of the
+ *               current position. For the finest wheel that is the exact
+ *               due time; for coarser wheels it is the start of the slot,
+ *               when its entries get cascaded closer.
+ */
+std::uint64_t Scheduler::nextDueTime() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_pending == 0)
+        return UINT64_MAX;
+
+    const unsigned current = static_cast<unsigned>(_currentTime) & WHEEL_MASK;
+    if (_wheels[0].slots[current].head != NIL)
+        return _currentTime;
+
+    for (unsigned level = 0; level < WHEEL_LEVELS; ++level)
     {
-        const ScheduledEntry& next = _taskQueue.top();
+        const unsigned shift = WHEEL_BITS * level;
+        const unsigned digit = static_cast<unsigned>(_currentTime >> shift) & WHEEL_MASK;
 
-        if (next.executionTime <= _currentTime)
+        if (digit + 1 < WHEEL_SIZE)
         {
-            next.task();         // Execute scheduled task
-            _taskQueue.pop();    // Remove from queue
+            const unsigned slot = findNextSet(_wheels[level].occupied, digit + 1);
+            if (slot < WHEEL_SIZE)
+            {
+                const TimePoint above = _currentTime & ~((TimePoint(1) << (shift + WHEEL_BITS)) - 1);
+                return above | (TimePoint(slot) << shift);
+            }
         }
-        else
+    }
+
+    // Only entries in the overflow list remain; they are re-placed when the
+    // top wheel wraps.
+    return (_currentTime | ((TimePoint(1) << (WHEEL_BITS * WHEEL_LEVELS)) - 1)) + 1;
+}
+
+/*
+ *  Description: Adds a task 'delaySeconds' after the current time.
+ */
+Scheduler::TimerHandle Scheduler::scheduleLocked(TimePoint when, ScheduledTask task)
+{
+    if (!task)
+        return TimerHandle{};
+
+    const std::uint32_t index = allocateEntry();
+    ScheduledEntry& entry = _entries[index];
+    entry.executionTime = (when < _currentTime) ? _currentTime : when;
+    entry.task = std::move(task);
+    entry.pending = true;
+
+    place(index);
+    ++_pending;
+
+    return TimerHandle{ index, entry.generation };
+}
+
+/*
+ *  Description: Replaces the task pending under 'dedupKey', or schedules a
+ *               new one and registers it under the key.
+ */
+Scheduler::TimerHandle Scheduler::scheduleKeyedLocked(TimePoint when, ScheduledTask task, const std::string& dedupKey)
+{
+    if (!task)
+        return TimerHandle{};
+
+    auto it = _byKey.find(dedupKey);
+    if (it != _byKey.end())
+    {
+        const std::uint32_t index = resolve(it->second);
+        if (index != NIL)
+        {
+            _entries[index].task = std::move(task);
+            rescheduleLocked(it->second, when);
+            return it->second;
+        }
+    }
+
+    const TimerHandle handle = scheduleLocked(when, std::move(task));
+    auto inserted = _byKey.insert_or_assign(dedupKey, handle).first;
+    _entries[handle.index].dedupKey = &inserted->first;
+    return handle;
+}
+
+/*
+ *  Description: Unlinks a pending task and recycles its entry.
+ */
+bool Scheduler::cancelLocked(TimerHandle handle)
+{
+    const std::uint32_t index = resolve(handle);
+    if (index == NIL)
+        return false;
+
+    unlink(_entries[index].level, _entries[index].slot, index);
+    releaseEntry(index);
+    --_pending;
+    return true;
+}
+
+/*
+ *  Description: Moves a pending task to 'when' (now, if already passed).
+ */
+bool Scheduler::rescheduleLocked(TimerHandle handle, TimePoint when)
+{
+    const std::uint32_t index = resolve(handle);
+    if (index == NIL)
+        return false;
+
+    unlink(_entries[index].level, _entries[index].slot, index);
+    _entries[index].executionTime = (when < _currentTime) ? _currentTime : when;
+    place(index);
+    return true;
+}
+
+/*
+ *  Description: Picks the finest wheel in which the entry's execution time
+ *               shares all coarser digits with the current time, so the
+ *               entry is reached within the current rotation of that wheel.
+ *               Deadlines outside the top wheel's current rotation go to the
+ *               overflow list: parking them in a top-wheel slot would alias
+ *               the current slot, which is only cascaded a full rotation later.
+ */
+void Scheduler::place(std::uint32_t index)
+{
+    TimePoint when = _entries[index].executionTime;
+    if (when < _currentTime)
+        when = _currentTime;
+
+    const TimePoint diff = when ^ _currentTime;
+
+    if ((diff >> (WHEEL_BITS * WHEEL_LEVELS)) != 0)
+    {
+        link(OVERFLOW_LEVEL, 0, index);
+        return;
+    }
+
+    unsigned level = 0;
+    while (level < WHEEL_LEVELS - 1 && (diff >> (WHEEL_BITS * (level + 1))) != 0)
+        ++level;
+
+    const unsigned slot = static_cast<unsigned>(when >> (WHEEL_BITS * level)) & WHEEL_MASK;
+    link(level, slot, index);
+}
+
+/*
+ *  Description: Appends an entry at the tail of a slot list (FIFO order).
+ */
+void Scheduler::link(unsigned level, unsigned slot, std::uint32_t index)
+{
+    Slot& s = slotList(level, slot);
+    ScheduledEntry& entry = _entries[index];
+
+    entry.level = static_cast<std::uint8_t>(level);
+    entry.slot = static_cast<std::uint8_t>(slot);
+    entry.next = NIL;
+    entry.prev = s.tail;
+
+    if (s.tail != NIL)
+        _entries[s.tail].next = index;
+    else
+        s.head = index;
+    s.tail = index;
+
+    if (level != OVERFLOW_LEVEL)
+        _wheels[level].occupied[slot / 64] |= std::uint64_t(1) << (slot % 64);
+}
+
+/*
+ *  Description: Removes an entry from its slot list in O(1).
+ */
+void Scheduler::unlink(unsigned level, unsigned slot, std::uint32_t index)
+{
+    Slot& s = slotList(level, slot);
+    ScheduledEntry& entry = _entries[index];
+
+    if (entry.prev != NIL)
+        _entries[entry.prev].next = entry.next;
+    else
+        s.head = entry.next;
+
+    if (entry.next != NIL)
+        _entries[entry.next].prev = entry.prev;
+    else
+        s.tail = entry.prev;
+
+    entry.next = entry.prev = NIL;
+
+    if (s.head == NIL && level != OVERFLOW_LEVEL)
+        _wheels[level].occupied[slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+}
+
+/*
+ *  Description: Returns the overflow list or a wheel slot's list.
+ */
+Scheduler::Slot& Scheduler::slotList(unsigned level, unsigned slot)
+{
+    return level == OVERFLOW_LEVEL ? _overflow : _wheels[level].slots[slot];
+}
+
+/*
+ *  Description: At every wheel boundary the matching slot of each coarser
+ *               wheel is emptied and its entries are placed again relative
+ *               to the new time. Coarsest wheels go first, starting with the
+ *               overflow list whenever the top wheel wraps.
+ */
+void Scheduler::cascade()
+{
+    unsigned top = 1;
+    while (top < WHEEL_LEVELS - 1 && ((_currentTime >> (WHEEL_BITS * top)) & WHEEL_MASK) == 0)
+        ++top;
+
+    const TimePoint rangeMask = (TimePoint(1) << (WHEEL_BITS * WHEEL_LEVELS)) - 1;
+    if ((_currentTime & rangeMask) == 0)
+    {
+        // Entries due in this rotation move into the wheels; the rest are
+        // relinked at the tail, so stop after the ones present on entry.
+        const std::uint32_t last = _overflow.tail;
+        std::uint32_t index = _overflow.head;
+        while (index != NIL)
         {
-            break; // Stop if the next task is not due yet
+            const std::uint32_t next = _entries[index].next;
+            unlink(OVERFLOW_LEVEL, 0, index);
+            place(index);
+            if (index == last)
+                break;
+            index = next;
         }
     }
+
+    for (unsigned level = top; level >= 1; --level)
+    {
+        const unsigned slot = static_cast<unsigned>(_currentTime >> (WHEEL_BITS * level)) & WHEEL_MASK;
+
+        std::uint32_t index = _wheels[level].slots[slot].head;
+        while (index != NIL)
+        {
+            const std::uint32_t next = _entries[index].next;
+            unlink(level, slot, index);
+            place(index);
+            index = next;
+        }
+    }
+}
+
+/*
+ *  Description: Runs the finest wheel's current slot. The task is moved out
+ *               and its entry recycled before it runs, and the lock is
+ *               released meanwhile, so tasks may freely schedule new work
+ *               (which lands in this same slot if due now).
+ */
+void Scheduler::runDueSlot(std::unique_lock<std::mutex>& lock)
+{
+    const unsigned slot = static_cast<unsigned>(_currentTime) & WHEEL_MASK;
+
+    while (_wheels[0].slots[slot].head != NIL)
+    {
+        const std::uint32_t index = _wheels[0].slots[slot].head;
+        unlink(0, slot, index);
+
+        ScheduledTask task = std::move(_entries[index].task);
+        releaseEntry(index);
+        --_pending;
+
+        const bool handOff = static_cast<bool>(_executor);
+        lock.unlock();
+        if (handOff)
+            _executor(std::move(task));
+        else
+            task();  // Execute scheduled task
+        lock.lock();
+    }
+}
+
+/*
+ *  Description: The next occupied slot of the finest wheel in this rotation,
+ *               or the start of the next rotation where a cascade happens.
+ */
+Scheduler::TimePoint Scheduler::nextEventTime() const
+{
+    const unsigned from = (static_cast<unsigned>(_currentTime) & WHEEL_MASK) + 1;
+    const TimePoint rotationStart = _currentTime & ~TimePoint(WHEEL_MASK);
+
+    if (from < WHEEL_SIZE)
+    {
+        const unsigned slot = findNextSet(_wheels[0].occupied, from);
+        if (slot < WHEEL_SIZE)
+            return rotationStart + slot;
+    }
+    return rotationStart + WHEEL_SIZE;
+}
+
+/*
+ *  Description: Takes an entry from the free list, growing the pool if needed.
+ */
+std::uint32_t Scheduler::allocateEntry()
+{
+    if (_freeList != NIL)
+    {
+        const std::uint32_t index = _freeList;
+        _freeList = _entries[index].next;
+        return index;
+    }
+
+    _entries.emplace_back();
+    return static_cast<std::uint32_t>(_entries.size() - 1);
+}
+
+/*
+ *  Description: Returns an entry to the free list, dropping its dedup key
+ *               and invalidating every handle that refers to it.
+ */
+void Scheduler::releaseEntry(std::uint32_t index)
+{
+    ScheduledEntry& entry = _entries[index];
+
+    if (entry.dedupKey)
+    {
+        _byKey.erase(*entry.dedupKey);
+        entry.dedupKey = nullptr;
+    }
+
+    entry.task = nullptr;
+    entry.pending = false;
+    ++entry.generation;
+    entry.next = _freeList;
+    _freeList = index;
+}
+
+/*
+ *  Description: Maps a handle to its entry if the task is still pending.
+ */
+std::uint32_t Scheduler::resolve(TimerHandle handle) const
+{
+    if (handle.index >= _entries.size())
+        return NIL;
+
+    const ScheduledEntry& entry = _entries[handle.index];
+    return (entry.pending && entry.generation == handle.generation) ? handle.index : NIL;
 }
 
 /******************************************************************************
@@ -3,14 +3,18 @@
  *  FILE         : SmartHomeController.cpp
  *  DESCRIPTION  : Implements the SmartHomeController class, which provides
  *                 a CLI super‐loop for managing devices, groups, and automation
- *                 modes (Security, Energy Saving).
+ *                 modes (Security, Energy Saving, Comfort).
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : July 2025
  ******************************************************************************/
 
 #include "SmartHome/Controllers/SmartHomeController.hpp"
 #include <iostream>
-#include <algorithm>
+#include "SmartHome/Utils/Logger.hpp"
+#include "SmartHome/Events/EventBus.hpp"
+#include "SmartHome/Persistence/Manifest.hpp"
+#include "SmartHome/Persistence/Snapshot.hpp"
+#include <fstream>
 
 // Bring commonly used types into scope
 using namespace SmartHome;
@@ -27,10 +31,25 @@ using namespace SmartHome::Automation;
 // Constructor
 // ---------------------------------------------------------------------------
 SmartHomeController::SmartHomeController()
-  : _scheduler()
+  : _scheduler(), _lastTick(std::chrono::steady_clock::now()), _rules(&_journal),
+    _history(HISTORY_CAPACITY, [this](const IDevice& target) { return findTarget(target.getID()); })
 {
-    _modes.push_back(std::make_shared<SecurityMode>(_scheduler));
-    _modes.push_back(std::make_shared<EnergySavingMode>(_scheduler));
+    _modes.push_back(std::make_shared<SecurityMode>(_scheduler, &_journal));
+    _modes.push_back(std::make_shared<EnergySavingMode>(_scheduler, &_journal));
+    _modes.push_back(std::make_shared<ComfortMode>(_scheduler, &_journal));
+
+    // Keep log formatting and I/O off the command path, with flat memory use
+    Utils::Logger::getInstance().openStream(Utils::LogStreamConfig{});
+    Utils::Logger::getInstance().startAsync();
+
+    // Sensor events reach subscribed modes as they happen, not on the next menu pass
+    Events::EventBus::getInstance().start();
+
+    restoreState();
+
+    // Mode timers fire on time even while the menu waits for input
+    _clock.start();
+    armClock();
 }
 
 // ---------------------------------------------------------------------------
@@ -52,15 +71,57 @@ void SmartHomeController::run()
             case 2: groupMenu(); break;
             case 3: activateSecurityMode(); break;
             case 4: activateEnergySavingMode(); break;
-            case 5: running = false; break;
+            case 5: activateComfortMode(); break;
+            case 6: loadRules(); break;
+            case 7: undoCommand(); break;
+            case 8: redoCommand(); break;
+            case 9:
+            {
+                std::cout << "Save state before exit? (y/n): ";
+                std::string answer;
+                std::getline(std::cin, answer);
+                if (!answer.empty() && (answer[0] == 'y' || answer[0] == 'Y'))
+                    saveSnapshot();
+                running = false;
+                break;
+            }
             default:
                 std::cout << "Invalid selection, please try again.\n";
         }
     }
 
+    Utils::Logger::getInstance().flush();
     std::cout << "Exiting Smart Home System. Goodbye!\n";
 }
 
+// ---------------------------------------------------------------------------
+// Drive the scheduler from wall-clock time
+// ---------------------------------------------------------------------------
+void SmartHomeController::armClock()
+{
+    _clock.scheduleAfter(std::chrono::seconds(1), [this]()
+    {
+        {
+            // Mode tasks run inline and expect no menu action in between
+            std::lock_guard<std::mutex> guard(_stateMutex);
+            advanceScheduler();
+        }
+        armClock();
+    });
+}
+
+void SmartHomeController::advanceScheduler()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - _lastTick);
+
+    if (elapsed.count() > 0)
+    {
+        _lastTick += elapsed;   // Keep the sub-second remainder for the next call
+        _scheduler.tick(static_cast<int>(elapsed.count()));
+    }
+}
+
 // ---------------------------------------------------------------------------
 // Main menu
 // ---------------------------------------------------------------------------
@@ -71,7 +132,11 @@ void SmartHomeController::mainMenu()
               << "2. Group Management\n"
               << "3. Activate Security Mode\n"
               << "4. Activate Energy-Saving Mode\n"
-              << "5. Exit\n"
+              << "5. Activate Comfort Mode\n"
+              << "6. Load Automation Rules\n"
+              << "7. Undo Last Command\n"
+              << "8. Redo Command\n"
+              << "9. Exit\n"
               << "================================\n"
               << "Choose an option: ";
 }
@@ -87,7 +152,8 @@ void SmartHomeController::deviceMenu()
                   << "1. Add Device\n"
                   << "2. List All Devices & Status\n"
                   << "3. Control a Device\n"
-                  << "4. Back\n"
+                  << "4. Import Devices from Manifest\n"
+                  << "5. Back\n"
                   << "Select: ";
         int c; std::cin >> c; std::cin.ignore();
         switch (c)
@@ -95,7 +161,8 @@ void SmartHomeController::deviceMenu()
             case 1: addDevice();       break;
             case 2: listAllDevices();  break;
             case 3: controlDevice();   break;
-            case 4: return;
+            case 4: importManifest();  break;
+            case 5: return;
             default: std::cout << "Invalid choice.\n";
         }
     }
@@ -131,7 +198,11 @@ void SmartHomeController::addDevice()
     try
     {
         auto device = factory.createDevice(key, id, type);
-        _devices.push_back(device);
+        if (!_devices.add(device).isValid())
+        {
+            std::cout << "Device ID '" << id << "' is already registered.\n";
+            return;
+        }
         std::cout << "Device '" << id << "' added.\n";
     }
     catch (const std::exception& e)
@@ -140,6 +211,58 @@ void SmartHomeController::addDevice()
     }
 }
 
+// ---------------------------------------------------------------------------
+// Bulk import from a manifest; all or nothing
+// ---------------------------------------------------------------------------
+void SmartHomeController::importManifest()
+{
+    std::string path;
+    std::cout << "Manifest file (CSV or JSON lines): ";
+    std::getline(std::cin, path);
+
+    Persistence::Manifest::Contents contents;
+    try
+    {
+        contents = Persistence::Manifest::load(path);
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "Import failed: " << e.what() << "\n";
+        return;
+    }
+
+    for (const auto& device : contents.devices)
+    {
+        if (_devices.find(device->getID()).isValid())
+        {
+            std::cout << "Import failed: device ID '" << device->getID() << "' is already registered.\n";
+            return;
+        }
+    }
+    for (const auto& group : contents.groups)
+    {
+        if (_groups.count(group->getID()))
+        {
+            std::cout << "Import failed: group '" << group->getID() << "' already exists.\n";
+            return;
+        }
+    }
+
+    for (auto& device : contents.devices)
+        _devices.add(std::move(device));
+    for (auto& group : contents.groups)
+        _groups[group->getID()] = std::move(group);
+
+    const auto& stats = contents.stats;
+    std::cout << "Imported " << stats.devices << " device(s), " << stats.groups << " group(s), "
+              << stats.memberships << " membership(s) and " << stats.stateWrites << " state value(s) in "
+              << stats.seconds * 1000.0 << " ms (" << static_cast<long long>(stats.devicesPerSecond())
+              << " devices/s).\n";
+
+    refreshRules();
+    saveSnapshot();     // Imported state is not journaled
+}
+
 // ---------------------------------------------------------------------------
 // List all devices
 // ---------------------------------------------------------------------------
@@ -151,7 +274,7 @@ void SmartHomeController::listAllDevices() const
         return;
     }
     std::cout << "\nRegistered Devices:\n";
-    for (const auto& dev : _devices)
+    for (const auto& dev : _devices.devices())
     {
         std::cout << "ID: " << dev->getID()
                   << " | Status: " << dev->getStatus() << "\n";
@@ -165,31 +288,30 @@ void SmartHomeController::controlDevice()
 {
     std::cout << "Enter device ID: ";
     std::string id; std::cin >> id;
-    auto it = std::find_if(_devices.begin(), _devices.end(),
-        [&](auto& d){ return d->getID() == id; });
+    const auto* entry = _devices.get(id);
 
-    if (it == _devices.end())
+    if (!entry)
     {
         std::cout << "Device not found.\n";
         return;
     }
-    auto device = *it;
+    auto device = *entry;
 
     std::cout << "1. Turn ON\n2. Turn OFF\nChoose: ";
     int action; std::cin >> action;
     std::shared_ptr<ICommand> cmd;
 
     if (action == 1)
-        cmd = std::make_shared<TurnOnCommand>(device);
+        cmd = _commandPool.make<TurnOnCommand>(device);
     else if (action == 2)
-        cmd = std::make_shared<TurnOffCommand>(device);
+        cmd = _commandPool.make<TurnOffCommand>(device);
     else
     {
         std::cout << "Invalid action.\n";
         return;
     }
 
-    cmd->execute();
+    executeJournaled(cmd);
 }
 
 // ---------------------------------------------------------------------------
@@ -235,6 +357,7 @@ void SmartHomeController::createGroup()
     }
     _groups[name] = std::make_shared<DeviceGroup>(name);
     std::cout << "Group '" << name << "' created.\n";
+    refreshRules();
 }
 
 // ---------------------------------------------------------------------------
@@ -245,7 +368,10 @@ void SmartHomeController::deleteGroup()
     std::cout << "Enter group name to delete: ";
     std::string name; std::getline(std::cin, name);
     if (_groups.erase(name))
+    {
         std::cout << "Group '" << name << "' removed.\n";
+        refreshRules();
+    }
     else
         std::cout << "Group not found.\n";
 }
@@ -266,17 +392,20 @@ void SmartHomeController::addDeviceToGroup()
 
     std::cout << "Enter device ID to add: ";
     std::string id; std::getline(std::cin, id);
-    auto dit = std::find_if(_devices.begin(), _devices.end(),
-        [&](auto& d){ return d->getID() == id; });
+    const auto* entry = _devices.get(id);
 
-    if (dit == _devices.end())
+    if (!entry)
     {
         std::cout << "Device not found.\n";
         return;
     }
 
-    git->second->addDevice(dit->get());
+    {
+        std::lock_guard<std::mutex> guard(_stateMutex);
+        git->second->addDevice(*entry);
+    }
     std::cout << "Device '" << id << "' added to group '" << g << "'.\n";
+    refreshRules();
 }
 
 // ---------------------------------------------------------------------------
@@ -316,16 +445,16 @@ void SmartHomeController::controlGroup()
     std::shared_ptr<ICommand> cmd;
 
     if (action == 1)
-        cmd = std::make_shared<GroupOnCommand>(git->second);
+        cmd = _commandPool.make<GroupOnCommand>(git->second);
     else if (action == 2)
-        cmd = std::make_shared<GroupOffCommand>(git->second);
+        cmd = _commandPool.make<GroupOffCommand>(git->second);
     else
     {
         std::cout << "Invalid action.\n";
         return;
     }
 
-    cmd->execute();
+    executeJournaled(cmd);
 }
 
 // ---------------------------------------------------------------------------
@@ -337,7 +466,10 @@ void SmartHomeController::activateSecurityMode()
     for (auto& kv : _groups)
         groups.push_back(kv.second);
 
-    _modes[Modes::SECURITYMODE]->activate(groups);
+    {
+        std::lock_guard<std::mutex> guard(_stateMutex);
+        _modes[Modes::SECURITYMODE]->activate(groups);
+    }
     std::cout << "Security mode activated.\n";
 }
 
@@ -350,10 +482,186 @@ void SmartHomeController::activateEnergySavingMode()
     for (auto& kv : _groups)
         groups.push_back(kv.second);
 
-    _modes[Modes::ENERGYMODE]->activate(groups);
+    {
+        std::lock_guard<std::mutex> guard(_stateMutex);
+        _modes[Modes::ENERGYMODE]->activate(groups);
+    }
     std::cout << "Energy-saving mode activated.\n";
 }
 
+// ---------------------------------------------------------------------------
+// Activate Comfort Mode
+// ---------------------------------------------------------------------------
+void SmartHomeController::activateComfortMode()
+{
+    std::vector<std::shared_ptr<DeviceGroup>> groups;
+    for (auto& kv : _groups)
+        groups.push_back(kv.second);
+
+    {
+        std::lock_guard<std::mutex> guard(_stateMutex);
+        _modes[Modes::COMFORTMODE]->activate(groups);
+    }
+    std::cout << "Comfort mode activated.\n";
+}
+
+// ---------------------------------------------------------------------------
+// Load Automation Rules
+// ---------------------------------------------------------------------------
+void SmartHomeController::loadRules()
+{
+    std::string path;
+    std::cout << "Rules file: ";
+    std::getline(std::cin, path);
+
+    try
+    {
+        const std::size_t count = _rules.loadFile(path, [this](std::string_view id) { return findTarget(id); });
+        std::cout << count << " rule(s) loaded.\n";
+    }
+    catch (const std::exception& error)
+    {
+        std::cout << "Rules not loaded: " << error.what() << "\n";
+    }
+}
+
+void SmartHomeController::refreshRules()
+{
+    // Rules expand groups when compiled; pick up the change
+    try
+    {
+        _rules.refresh();
+    }
+    catch (const std::exception& error)
+    {
+        std::cout << "Rules not refreshed: " << error.what() << "\n";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Target lookup and journaled execution
+// ---------------------------------------------------------------------------
+std::shared_ptr<IDevice> SmartHomeController::findTarget(std::string_view id) const
+{
+    // IDs name a registered device first, then a group
+    if (const auto* device = _devices.get(id))
+        return *device;
+
+    auto it = _groups.find(std::string(id));
+    return (it != _groups.end()) ? it->second : nullptr;
+}
+
+void SmartHomeController::executeJournaled(std::shared_ptr<ICommand> command)
+{
+    std::lock_guard<std::mutex> guard(_stateMutex);
+    JournaledCommand journaled(std::move(command), _journal);
+    journaled.execute();
+
+    std::vector<Core::CommandRecord> writes;
+    journaled.describe(writes);
+    _history.push(writes);
+}
+
+void SmartHomeController::undoCommand()
+{
+    std::lock_guard<std::mutex> guard(_stateMutex);
+    std::vector<Core::CommandRecord> writes;
+    if (!_history.undo(writes))
+    {
+        std::cout << "Nothing to undo.\n";
+        return;
+    }
+
+    for (const auto& write : writes)
+        _journal.append(write, write.target->getID());
+    std::cout << "Undone (" << _history.undoDepth() << " more can be undone).\n";
+}
+
+void SmartHomeController::redoCommand()
+{
+    std::lock_guard<std::mutex> guard(_stateMutex);
+    std::vector<Core::CommandRecord> writes;
+    if (!_history.redo(writes))
+    {
+        std::cout << "Nothing to redo.\n";
+        return;
+    }
+
+    for (const auto& write : writes)
+        _journal.append(write, write.target->getID());
+    std::cout << "Redone (" << _history.redoDepth() << " more can be redone).\n";
+}
+
+// ---------------------------------------------------------------------------
+// State: snapshot and journal at startup, snapshot on exit
+// ---------------------------------------------------------------------------
+void SmartHomeController::restoreState()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    if (std::ifstream(SNAPSHOT_FILE))
+    {
+        try
+        {
+            Persistence::Snapshot::Contents contents = Persistence::Snapshot::load(SNAPSHOT_FILE);
+
+            for (auto& device : contents.devices)
+                _devices.add(std::move(device));
+            for (auto& group : contents.groups)
+                _groups[group->getID()] = std::move(group);
+        }
+        catch (const std::exception& error)
+        {
+            std::cout << "Saved state not restored: " << error.what() << "\n";
+        }
+        refreshRules();
+    }
+
+    // Commands made after the snapshot, in order; unknown targets are skipped
+    const auto replayed = Persistence::CommandJournal::replay(JOURNAL_FILE,
+        [this](std::string_view id) { return findTarget(id); });
+
+    if (!_devices.empty() || !_groups.empty() || replayed.applied || replayed.skipped)
+    {
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        std::cout << "Restored " << _devices.size() << " device(s), " << _groups.size() << " group(s) and "
+                  << replayed.applied << " journaled command(s) in " << elapsed.count() << " ms.\n";
+    }
+    if (replayed.skipped || replayed.tornBytes)
+        std::cout << "Journal: " << replayed.skipped << " command(s) skipped, "
+                  << replayed.tornBytes << " byte(s) of incomplete record dropped.\n";
+
+    try
+    {
+        _journal.open(JOURNAL_FILE);
+    }
+    catch (const std::exception& error)
+    {
+        std::cout << "Commands will not be journaled: " << error.what() << "\n";
+    }
+}
+
+void SmartHomeController::saveSnapshot()
+{
+    std::vector<std::shared_ptr<DeviceGroup>> groups;
+    groups.reserve(_groups.size());
+    for (const auto& kv : _groups)
+        groups.push_back(kv.second);
+
+    try
+    {
+        std::lock_guard<std::mutex> guard(_stateMutex);
+        const std::uint64_t covered = _journal.lastLsn();   // Automation keeps appending meanwhile
+        Persistence::Snapshot::save(SNAPSHOT_FILE, _devices.devices(), groups);
+        _journal.reset(covered);
+        std::cout << "State saved to " << SNAPSHOT_FILE << ".\n";
+    }
+    catch (const std::exception& error)
+    {
+        std::cout << "State not saved: " << error.what() << "\n";
+    }
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
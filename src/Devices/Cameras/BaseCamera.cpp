@@ -16,7 +16,8 @@
  *    - id   : Unique identifier for the camera (const std::string&)
  *    - type : Camera model/type (const std::string&)
  */
-SmartHome::Devices::Cameras::BaseCamera::BaseCamera(const std::string& id, const std::string& type) : _id(id), _type(type)
+SmartHome::Devices::Cameras::BaseCamera::BaseCamera(const std::string& id, const std::string& type)
+    : IDevice(SmartHome::Core::DeviceType::CAMERA), _id(id), _type(type), _store(this)
 {
     // already initialized
 }
@@ -34,7 +35,7 @@ std::string SmartHome::Devices::Cameras::BaseCamera::getID(void) const
  */
 void SmartHome::Devices::Cameras::BaseCamera::turnOn(void)
 {
-    _state = CameraState::ON;
+    _store.setOn(true);
 }
 
 /*
@@ -42,7 +43,7 @@ void SmartHome::Devices::Cameras::BaseCamera::turnOn(void)
  */
 void SmartHome::Devices::Cameras::BaseCamera::turnOff(void)
 {
-    _state = CameraState::OFF;
+    _store.setOn(false);
 }
 
 /*
@@ -51,14 +52,7 @@ void SmartHome::Devices::Cameras::BaseCamera::turnOff(void)
  */
 bool SmartHome::Devices::Cameras::BaseCamera::isOn(void)
 {
-    switch(_state)
-    {
-        case CameraState::ON:
-            return true;
-        case CameraState::OFF:
-            return false;
-    }
-    return false; // Defensive programming
+    return _store.isOn();
 }
 
 /*
@@ -71,19 +65,13 @@ bool SmartHome::Devices::Cameras::BaseCamera::isOn(void)
  */
 std::string SmartHome::Devices::Cameras::BaseCamera::getStatus(void) const
 {
-    std::string stateReturnal;
-    
-    switch(_state)
+    if (!_store.isOn())
     {
-        case CameraState::ON:
-            stateReturnal = "ON";
-            break;
-        case CameraState::OFF:
-            return _type + " | " + "OFF";
+        return _type + " | " + "OFF";
     }
-    return _type + " | " + stateReturnal + " | " + "Night Vision: " 
-           + SmartHome::Utils::boolToString(_nightVisionEnabled) + " | "
-           + "Recording: " + SmartHome::Utils::boolToString(_isRecording);
+    return _type + " | " + "ON" + " | " + "Night Vision: " 
+           + SmartHome::Utils::boolToString(_store.isNightVision()) + " | "
+           + "Recording: " + SmartHome::Utils::boolToString(_store.isRecording());
 }
 
 /*
@@ -91,7 +79,7 @@ std::string SmartHome::Devices::Cameras::BaseCamera::getStatus(void) const
  */
 void SmartHome::Devices::Cameras::BaseCamera::startRecording(void)
 {
-    _isRecording = true;
+    _store.setRecording(true);
 }
 
 /*
@@ -99,7 +87,7 @@ void SmartHome::Devices::Cameras::BaseCamera::startRecording(void)
  */
 void SmartHome::Devices::Cameras::BaseCamera::stopRecording(void)
 {
-    _isRecording = false;
+    _store.setRecording(false);
 }
 
 /*
@@ -108,7 +96,7 @@ void SmartHome::Devices::Cameras::BaseCamera::stopRecording(void)
  */
 bool SmartHome::Devices::Cameras::BaseCamera::isRecording(void)
 {
-    return _isRecording;
+    return _store.isRecording();
 }
 
 /*
@@ -116,7 +104,7 @@ bool SmartHome::Devices::Cameras::BaseCamera::isRecording(void)
  */
 void SmartHome::Devices::Cameras::BaseCamera::enableNightVision(void)
 {
-    _nightVisionEnabled = true;
+    _store.setNightVision(true);
 }
 
 /*
@@ -124,7 +112,7 @@ void SmartHome::Devices::Cameras::BaseCamera::enableNightVision(void)
  */
 void SmartHome::Devices::Cameras::BaseCamera::disableNightVision(void)
 {
-    _nightVisionEnabled = false;
+    _store.setNightVision(false);
 }
 
 /*
@@ -133,7 +121,7 @@ void SmartHome::Devices::Cameras::BaseCamera::disableNightVision(void)
  */
 bool SmartHome::Devices::Cameras::BaseCamera::isNightVisionEnabled(void)
 {
-    return _nightVisionEnabled;
+    return _store.isNightVision();
 }
 
 /******************************************************************************
@@ -41,20 +41,14 @@ SmartHome::Devices::Cameras::WirelessCamera::WirelessCamera(
  */
 std::string SmartHome::Devices::Cameras::WirelessCamera::getStatus(void) const
 {
-    std::string stateReturnal;
-
-    switch(_state)
+    if (!_store.isOn())
     {
-        case CameraState::ON:
-            stateReturnal = "ON";
-            break;
-        case CameraState::OFF:
-            return "OFF";
+        return "OFF";
     }
-    return _type + " | " + stateReturnal + " | " + "Battery Percentage: " + std::to_string(_batteryPercentage)
+    return _type + " | " + "ON" + " | " + "Battery Percentage: " + std::to_string(_batteryPercentage)
            + "% | " + "Charger: " + SmartHome::Utils::boolToString(_isCharging) + " | "
-           + "Night Vision: " + SmartHome::Utils::boolToString(_nightVisionEnabled) + " | "
-           + "Recording: " + SmartHome::Utils::boolToString(_isRecording);
+           + "Night Vision: " + SmartHome::Utils::boolToString(_store.isNightVision()) + " | "
+           + "Recording: " + SmartHome::Utils::boolToString(_store.isRecording());
 }
 
 /*
@@ -68,7 +62,7 @@ void SmartHome::Devices::Cameras::WirelessCamera::updateBattery(void)
     if(_isCharging)
     {
         _batteryPercentage += 5;
-        _state = CameraState::ON;  
+        _store.setOn(true);
     }
     else
     {
@@ -76,7 +70,7 @@ void SmartHome::Devices::Cameras::WirelessCamera::updateBattery(void)
         if (_batteryPercentage <= 0)
         {
             _batteryPercentage = 0;
-            _state = CameraState::OFF;
+            _store.setOn(false);
         }
     }
     _batteryPercentage = std::clamp(_batteryPercentage, 0, 100);
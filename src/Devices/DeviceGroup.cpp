@@ -10,11 +10,18 @@
 
 #include "SmartHome/Devices/DeviceGroup.hpp"
 #include "SmartHome/Core/IDevice.hpp"
+#include <algorithm>
+#include <atomic>
+
+using SmartHome::Core::IDevice;
+using SmartHome::Executors::ThreadPool;
+using SmartHome::Executors::TaskGroup;
 
 /*
  *  Constructor: Initializes the device group with a name identifier.
  */
-SmartHome::Devices::DeviceGroup::DeviceGroup(std::string groupName) : _groupName(groupName)
+SmartHome::Devices::DeviceGroup::DeviceGroup(std::string groupName)
+    : IDevice(SmartHome::Core::DeviceType::GROUP), _groupName(groupName)
 {
     // Already initialized
 }
@@ -23,9 +30,28 @@ SmartHome::Devices::DeviceGroup::DeviceGroup(std::string groupName) : _groupName
  *  Description: Adds a device to the group by its ID.
  *  Returns true if the insertion was successful, false if duplicate.
  */
-bool SmartHome::Devices::DeviceGroup::addDevice(IDevice* device)
+bool SmartHome::Devices::DeviceGroup::addDevice(std::shared_ptr<IDevice> device)
 {
-    return _devices.emplace(device->getID(), device).second;
+    if (!device)
+        return false;
+
+    auto [it, inserted] = _devices.emplace(device->getID(), device);
+    if (!inserted)
+        return false;
+
+    _byType[static_cast<std::size_t>(device->getType())].push_back(std::move(device));
+    _fanoutDirty = true;
+    ++_revision;
+    return true;
+}
+
+/*
+ *  Description: Sizes the member index once instead of rehashing while a
+ *  large group is filled.
+ */
+void SmartHome::Devices::DeviceGroup::reserve(std::size_t count)
+{
+    _devices.reserve(count);
 }
 
 /*
@@ -34,11 +60,19 @@ bool SmartHome::Devices::DeviceGroup::addDevice(IDevice* device)
  */
 bool SmartHome::Devices::DeviceGroup::removeDeviceByID(std::string& id)
 {
-    if (_devices.erase(id))
+    auto it = _devices.find(id);
+    if (it == _devices.end())
     {
-        return true;
+        return false;
     }
-    return false;
+
+    auto& members = _byType[static_cast<std::size_t>(it->second->getType())];
+    members.erase(std::find(members.begin(), members.end(), it->second));
+
+    _devices.erase(it);
+    _fanoutDirty = true;
+    ++_revision;
+    return true;
 }
 
 /*
@@ -49,15 +83,21 @@ std::string SmartHome::Devices::DeviceGroup::getID(void) const
     return _groupName;
 }
 
+/*
+ *  Description: Sets the executor used to fan out large groups.
+ */
+void SmartHome::Devices::DeviceGroup::setExecutor(ThreadPool* pool, std::size_t threshold)
+{
+    _pool = pool;
+    _parallelThreshold = threshold;
+}
+
 /*
  *  Description: Turns on all devices in the group.
  */
 void SmartHome::Devices::DeviceGroup::turnOn(void)
 {
-    for (auto device : _devices)
-    {
-        device.second->turnOn();
-    }
+    forEachDevice(&IDevice::turnOn);
 }
 
 /*
@@ -65,10 +105,69 @@ void SmartHome::Devices::DeviceGroup::turnOn(void)
  */
 void SmartHome::Devices::DeviceGroup::turnOff(void)
 {
-    for (auto device : _devices)
+    forEachDevice(&IDevice::turnOff);
+}
+
+/*
+ *  Description: Serial path iterates by reference (no pair copies); large
+ *               groups with an executor are fanned out in chunks.
+ */
+void SmartHome::Devices::DeviceGroup::forEachDevice(void (IDevice::*action)(void))
+{
+    if (!useFanout())
+    {
+        for (const auto& [id, device] : _devices)
+        {
+            (device.get()->*action)();
+        }
+        return;
+    }
+
+    forEachChunk([this, action](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            (_fanout[i]->*action)();
+    });
+}
+
+/*
+ *  Description: True when an executor is set and the group has reached the
+ *               fan-out threshold. An empty group never fans out, even with
+ *               a threshold of 0.
+ */
+bool SmartHome::Devices::DeviceGroup::useFanout(void) const
+{
+    return _pool && !_devices.empty() && _devices.size() >= _parallelThreshold;
+}
+
+/*
+ *  Description: Splits the dense member list into a few chunks per worker,
+ *               runs 'body' on each through a TaskGroup and joins them.
+ *               The member list is rebuilt only after membership changes.
+ */
+void SmartHome::Devices::DeviceGroup::forEachChunk(const std::function<void(std::size_t, std::size_t)>& body)
+{
+    if (_fanoutDirty)
+    {
+        _fanout.clear();
+        _fanout.reserve(_devices.size());
+        for (const auto& [id, device] : _devices)
+            _fanout.push_back(device.get());
+        _fanoutDirty = false;
+    }
+    if (_fanout.empty())
+        return;
+
+    const std::size_t chunks = std::min(_fanout.size(), _pool->size() * 4);
+    const std::size_t chunkSize = (_fanout.size() + chunks - 1) / chunks;
+
+    TaskGroup group(*_pool);
+    for (std::size_t begin = 0; begin < _fanout.size(); begin += chunkSize)
     {
-        device.second->turnOff();
+        const std::size_t end = std::min(begin + chunkSize, _fanout.size());
+        group.run([&body, begin, end]() { body(begin, end); });
     }
+    group.wait();
 }
 
 /*
@@ -76,7 +175,21 @@ void SmartHome::Devices::DeviceGroup::turnOff(void)
  */
 bool SmartHome::Devices::DeviceGroup::isOn(void)
 {
-    for (auto device : _devices)
+    if (useFanout())
+    {
+        std::atomic<bool> allOn{true};
+        forEachChunk([this, &allOn](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end && allOn.load(std::memory_order_relaxed); ++i)
+            {
+                if (!_fanout[i]->isOn())
+                    allOn.store(false, std::memory_order_relaxed);
+            }
+        });
+        return allOn.load();
+    }
+
+    for (const auto& device : _devices)
     {
         if (!device.second->isOn())
         {
@@ -94,7 +207,7 @@ std::string SmartHome::Devices::DeviceGroup::getStatus(void) const
 {
     std::string statusReturnal = "Group: " + _groupName + "\n";
 
-    for (auto device : _devices)
+    for (const auto& device : _devices)
     {
         statusReturnal += "Device ID: " + device.first + "\t"
                         + "Device Status: " + device.second->getStatus() + "\n";
@@ -110,6 +223,23 @@ const std::unordered_map<std::string, std::shared_ptr<SmartHome::Core::IDevice>>
     return _devices;
 }
 
+/*
+ *  Description: Returns the members carrying the given type tag.
+ */
+const std::vector<std::shared_ptr<IDevice>>& SmartHome::Devices::DeviceGroup::devicesOfType(SmartHome::Core::DeviceType type) const
+{
+    return _byType[static_cast<std::size_t>(type)];
+}
+
+/*
+ *  Description: Returns the first member carrying the type tag, or nullptr.
+ */
+IDevice* SmartHome::Devices::DeviceGroup::firstOfType(SmartHome::Core::DeviceType type) const
+{
+    const auto& members = _byType[static_cast<std::size_t>(type)];
+    return members.empty() ? nullptr : members.front().get();
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
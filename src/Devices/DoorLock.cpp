@@ -8,6 +8,7 @@
  ******************************************************************************/
 
 #include "SmartHome/Devices/DoorLock.hpp"
+#include "SmartHome/Events/EventBus.hpp"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
@@ -19,8 +20,12 @@ using namespace SmartHome::Devices;
  * Sets default pin and locked status.
  */
 DoorLock::DoorLock(const std::string& id, const std::string& type) 
-    : _id(id), _type(type), _pinCode("1234"), _isLocked(true), _lastAuthMethod(AuthMethod::NONE)
+    : IDevice(SmartHome::Core::DeviceType::DOOR_LOCK), _id(id), _type(type), _store(this),
+      _pinCode("1234"), _lastAuthMethod(AuthMethod::NONE)
 {
+    // Initial state, not a change: nothing to publish
+    _store.setLocked(true);
+    _store.setOn(false);
 }
 
 /*
@@ -36,7 +41,7 @@ std::string DoorLock::getID(void) const
  */
 void DoorLock::turnOn(void)
 {
-    _isLocked = false;
+    setLocked(false);
 }
 
 /*
@@ -44,7 +49,7 @@ void DoorLock::turnOn(void)
  */
 void DoorLock::turnOff(void)
 {
-    _isLocked = true;
+    setLocked(true);
 }
 
 /*
@@ -52,7 +57,7 @@ void DoorLock::turnOff(void)
  */
 bool DoorLock::isOn(void)
 {
-    return !_isLocked;
+    return !_store.isLocked();
 }
 
 /*
@@ -80,7 +85,7 @@ void DoorLock::changePinCode(void)
  */
 std::string DoorLock::getStatus(void) const
 {
-    std::string status = _isLocked ? "LOCKED" : "UNLOCKED";
+    std::string status = _store.isLocked() ? "LOCKED" : "UNLOCKED";
     std::string method;
 
     switch (_lastAuthMethod)
@@ -99,7 +104,7 @@ std::string DoorLock::getStatus(void) const
  */
 void DoorLock::lockDoor(void)
 {
-    _isLocked = true;
+    setLocked(true);
 }
 
 /*
@@ -107,15 +112,37 @@ void DoorLock::lockDoor(void)
  */
 void DoorLock::unlockDoor(void)
 {
-    _isLocked = false;
+    setLocked(false);
+}
+
+/*
+ * Records the lock state; an unlocked door also counts as "on".
+ */
+void DoorLock::setLocked(bool locked)
+{
+    if (_store.isLocked() == locked)
+        return;
+
+    _store.setLocked(locked);
+    _store.setOn(!locked);
+    SmartHome::Events::EventBus::getInstance().publish(
+        { SmartHome::Core::EventType::LOCK, locked, 0.0f, this, SmartHome::Events::EventBus::nowNs() });
+}
+
+/*
+ * The lock publishes lock/unlock changes.
+ */
+SmartHome::Core::EventMask DoorLock::publishedEvents(void) const
+{
+    return SmartHome::Core::eventMask(SmartHome::Core::EventType::LOCK);
 }
 
 /*
  * Returns true if the door is currently locked.
  */
-bool DoorLock::isDoorLocked(void)
+bool DoorLock::isDoorLocked(void) const
 {
-    return _isLocked;
+    return _store.isLocked();
 }
 
 /*
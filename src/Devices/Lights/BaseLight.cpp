@@ -15,7 +15,8 @@
 /*
 *  Description : BaseLight Constructor initializes the lights id and type 
 */
-SmartHome::Devices::Lights::BaseLight::BaseLight(const std::string& id, const std::string& type) : _id(id), _type(type) 
+SmartHome::Devices::Lights::BaseLight::BaseLight(const std::string& id, const std::string& type)
+    : IDevice(SmartHome::Core::DeviceType::LIGHT), _id(id), _type(type), _store(this)
 {
     // already initialized
 };
@@ -33,7 +34,8 @@ std::string SmartHome::Devices::Lights::BaseLight::getID(void) const
 */
 void SmartHome::Devices::Lights::BaseLight::turnOn(void)
 {
-    _state = LightState::ON;
+    _store.setOn(true);
+    _store.setBrightness(100);
 } 
 
 /*
@@ -41,7 +43,8 @@ void SmartHome::Devices::Lights::BaseLight::turnOn(void)
 */
 void SmartHome::Devices::Lights::BaseLight::turnOff(void)
 {
-    _state = LightState::OFF;
+    _store.setOn(false);
+    _store.setBrightness(0);
 }
 
 /*
@@ -49,14 +52,7 @@ void SmartHome::Devices::Lights::BaseLight::turnOff(void)
 */
 bool SmartHome::Devices::Lights::BaseLight::isOn(void)
 {
-    switch(_state)
-    {
-        case LightState::ON:
-            return true;
-        case LightState::OFF:
-            return false;
-    }
-    return false; // Defensive  
+    return _store.isOn();
 }
 
 /*
@@ -64,18 +60,7 @@ bool SmartHome::Devices::Lights::BaseLight::isOn(void)
 */
 std::string SmartHome::Devices::Lights::BaseLight::getStatus(void) const
 {
-    std::string stateReturnal;
-    
-    switch(_state)
-    {
-        case LightState::ON:
-            stateReturnal = "ON";
-            break;
-        case LightState::OFF:
-            stateReturnal = "OFF";
-            break;
-    }
-    return _type + " | " + stateReturnal;
+    return _type + " | " + (_store.isOn() ? "ON" : "OFF");
 }
 /******************************************************************************
  *  END OF FILE
@@ -26,8 +26,8 @@ SmartHome::Devices::Lights::DimmableLight::DimmableLight(const std::string& id,
  */
 void SmartHome::Devices::Lights::DimmableLight::turnOn(void) 
 {
-    _state = LightState::DIMMED_HIGH;
-    _brightness = 80;
+    _store.setOn(true);
+    _store.setBrightness(80);
 }
 
 /*
@@ -35,8 +35,8 @@ void SmartHome::Devices::Lights::DimmableLight::turnOn(void)
  */
 void SmartHome::Devices::Lights::DimmableLight::turnOff(void)
 {
-    _state = LightState::OFF;
-    _brightness = 0;
+    _store.setOn(false);
+    _store.setBrightness(0);
 }
 
 /*
@@ -44,23 +44,15 @@ void SmartHome::Devices::Lights::DimmableLight::turnOff(void)
  */
 std::string SmartHome::Devices::Lights::DimmableLight::getStatus(void) const
 {
-    std::string stateReturnal;
+    const int brightness = _store.brightness();
 
-    switch(_state)
+    if (brightness == 0)
     {
-        case LightState::OFF:
-            return "OFF";
-
-        case LightState::DIMMED_LOW:
-        case LightState::DIMMED_HIGH:
-            stateReturnal = "DIMMED";
-            break;
-
-        case LightState::ON:
-            stateReturnal = "ON";
-            break;
+        return "OFF";
     }
-    return _type + " | " + stateReturnal + "(" + std::to_string(_brightness) + "%)";
+
+    std::string stateReturnal = (brightness < 100) ? "DIMMED" : "ON";
+    return _type + " | " + stateReturnal + "(" + std::to_string(brightness) + "%)";
 }
 
 /*
@@ -71,23 +63,8 @@ void SmartHome::Devices::Lights::DimmableLight::setBrightness(int level)
 {
     level = std::clamp(level, 0, 100);
 
-    if(level >= 1 && level <= 50)
-    {
-        _state = LightState::DIMMED_LOW;
-    }
-    else if(level > 50 && level < 100)
-    {
-        _state = LightState::DIMMED_HIGH;
-    }
-    else if(level == 0)
-    {
-        _state = LightState::OFF;
-    }
-    else
-    {
-        _state = LightState::ON;
-    }
-    _brightness = level;
+    _store.setOn(level > 0);
+    _store.setBrightness(level);
 }
 
 /*
@@ -96,7 +73,7 @@ void SmartHome::Devices::Lights::DimmableLight::setBrightness(int level)
 */
 int SmartHome::Devices::Lights::DimmableLight::getBrightness(void) const
 {
-    return _brightness;
+    return _store.brightness();
 }
 
 /******************************************************************************
@@ -9,6 +9,7 @@
 
 #include "SmartHome/Devices/MotionSensor.hpp"
 #include "SmartHome/Utils/StringUtils.hpp"
+#include "SmartHome/Events/EventBus.hpp"
 
 using namespace SmartHome::Devices::Sensors;
 using namespace SmartHome::Utils;
@@ -16,7 +17,8 @@ using namespace SmartHome::Utils;
 /*
  *  Description: Constructs a MotionSensor with a specific identifier.
  */
-MotionSensor::MotionSensor(const std::string& id) : _id(id)
+MotionSensor::MotionSensor(const std::string& id)
+    : IDevice(SmartHome::Core::DeviceType::MOTION_SENSOR), _id(id), _store(this)
 {
     // Already initialized
 }
@@ -34,7 +36,7 @@ std::string MotionSensor::getID(void) const
  */
 void MotionSensor::turnOn(void)
 {
-    _isOn = true;
+    _store.setOn(true);
 } 
 
 /*
@@ -42,7 +44,7 @@ void MotionSensor::turnOn(void)
  */
 void MotionSensor::turnOff(void)
 {
-    _isOn = false;
+    _store.setOn(false);
 }
 
 /*
@@ -50,7 +52,7 @@ void MotionSensor::turnOff(void)
  */
 bool MotionSensor::isOn(void)
 {
-    return _isOn; 
+    return _store.isOn();
 }
 
 /*
@@ -58,11 +60,11 @@ bool MotionSensor::isOn(void)
  */
 std::string MotionSensor::getStatus(void) const
 {
-    std::string stateReturnal = _motionDetected
+    std::string stateReturnal = _store.isMotionDetected()
         ? "is detecting an object."
         : "is not detecting any objects";
 
-    return "Motion Sensor is  | " + boolToString(_isOn) + " |  and " + stateReturnal;
+    return "Motion Sensor is  | " + boolToString(_store.isOn()) + " |  and " + stateReturnal;
 }
 
 /*
@@ -70,7 +72,7 @@ std::string MotionSensor::getStatus(void) const
  */
 bool MotionSensor::isMotionDetected(void) const
 {
-    return _motionDetected;
+    return _store.isMotionDetected();
 }
 
 /*
@@ -78,7 +80,20 @@ bool MotionSensor::isMotionDetected(void) const
  */
 void MotionSensor::setMotionDetected(bool detected)
 {
-    _motionDetected = detected;
+    if (_store.isMotionDetected() == detected)
+        return;
+
+    _store.setMotionDetected(detected);
+    SmartHome::Events::EventBus::getInstance().publish(
+        { SmartHome::Core::EventType::MOTION, detected, 0.0f, this, SmartHome::Events::EventBus::nowNs() });
+}
+
+/*
+ *  Description: The sensor publishes motion state changes.
+ */
+SmartHome::Core::EventMask MotionSensor::publishedEvents(void) const
+{
+    return SmartHome::Core::eventMask(SmartHome::Core::EventType::MOTION);
 }
 
 /******************************************************************************
@@ -8,6 +8,7 @@
  ******************************************************************************/
 
 #include "SmartHome/Devices/Thermostats/BaseThermostat.hpp"
+#include "SmartHome/Events/EventBus.hpp"
 #include <algorithm> // used for std::clamp
 
 /*
@@ -18,10 +19,11 @@
  */
 SmartHome::Devices::Thermostats::BaseThermostat::BaseThermostat(
     const std::string& id, const std::string& type) 
-    : _id(id), _type(type)
+    : IDevice(SmartHome::Core::DeviceType::THERMOSTAT), _id(id), _type(type), _store(this)
 {
     _lastModeUsed = ThermostatMode::COOLING;
-    _targetTemperature = 24; // Default comfortable temperature
+    _store.setTargetTemperature(24); // Default comfortable temperature
+    _store.setCurrentTemperature(24); // No reading yet
 }
 
 /*
@@ -39,7 +41,7 @@ std::string SmartHome::Devices::Thermostats::BaseThermostat::getID(void) const
  */
 void SmartHome::Devices::Thermostats::BaseThermostat::turnOn(void)
 {
-    _mode = _lastModeUsed; 
+    applyMode(_lastModeUsed);
 }
 
 /*
@@ -49,7 +51,7 @@ void SmartHome::Devices::Thermostats::BaseThermostat::turnOn(void)
 void SmartHome::Devices::Thermostats::BaseThermostat::turnOff(void)
 {
     _lastModeUsed = _mode;
-    _mode = ThermostatMode::OFF;
+    applyMode(ThermostatMode::OFF);
 }
 
 /*
@@ -58,7 +60,7 @@ void SmartHome::Devices::Thermostats::BaseThermostat::turnOff(void)
  */
 bool SmartHome::Devices::Thermostats::BaseThermostat::isOn(void)
 {
-    return _mode != ThermostatMode::OFF;
+    return _store.isOn();
 }
 
 /*
@@ -85,8 +87,8 @@ std::string SmartHome::Devices::Thermostats::BaseThermostat::getStatus(void) con
             return _type + " | " + "OFF";
     }
     return _type + " | " + stateReturnal + " | Desired: " + 
-           std::to_string(_targetTemperature) + "°C | Current: " + 
-           std::to_string(_currentTemperature) + "°C";
+           std::to_string(_store.targetTemperature()) + "°C | Current: " + 
+           std::to_string(_store.currentTemperature()) + "°C";
 }
 
 /*
@@ -97,7 +99,7 @@ std::string SmartHome::Devices::Thermostats::BaseThermostat::getStatus(void) con
 void SmartHome::Devices::Thermostats::BaseThermostat::setTargetTemperature(
     float newTargetedTemperature)
 {   
-    _targetTemperature = clampTargetTemperatureByMode(_mode, newTargetedTemperature);
+    _store.setTargetTemperature(clampTargetTemperatureByMode(_mode, newTargetedTemperature));
 }
 
 /*
@@ -108,7 +110,21 @@ void SmartHome::Devices::Thermostats::BaseThermostat::setTargetTemperature(
 void SmartHome::Devices::Thermostats::BaseThermostat::setCurrentTemperature(
     float newTemperature)
 {
-    _currentTemperature = newTemperature;
+    if (_store.currentTemperature() == newTemperature)
+        return;
+
+    _store.setCurrentTemperature(newTemperature);
+    SmartHome::Events::EventBus::getInstance().publish(
+        { SmartHome::Core::EventType::TEMPERATURE, false, newTemperature, this,
+          SmartHome::Events::EventBus::nowNs() });
+}
+
+/*
+ *  Description : The thermostat publishes changes of its temperature reading.
+ */
+SmartHome::Core::EventMask SmartHome::Devices::Thermostats::BaseThermostat::publishedEvents(void) const
+{
+    return SmartHome::Core::eventMask(SmartHome::Core::EventType::TEMPERATURE);
 }
 
 /*
@@ -117,7 +133,7 @@ void SmartHome::Devices::Thermostats::BaseThermostat::setCurrentTemperature(
  */
 float SmartHome::Devices::Thermostats::BaseThermostat::getTargetTemperature(void) const 
 {
-    return _targetTemperature;
+    return _store.targetTemperature();
 }
 
 /*
@@ -126,7 +142,7 @@ float SmartHome::Devices::Thermostats::BaseThermostat::getTargetTemperature(void
  */
 float SmartHome::Devices::Thermostats::BaseThermostat::getCurrentTemperature(void) const
 {
-    return _currentTemperature;
+    return _store.currentTemperature();
 }
 
 /*
@@ -135,8 +151,19 @@ float SmartHome::Devices::Thermostats::BaseThermostat::getCurrentTemperature(voi
  *    - mode : New operation mode (ThermostatMode)
  */
 void SmartHome::Devices::Thermostats::BaseThermostat::setMode(ThermostatMode mode)
+{
+    applyMode(mode);
+}
+
+/*
+ *  Description : Stores the mode and keeps the store's on bit in step.
+ *  Parameters  :
+ *    - mode : New operation mode (ThermostatMode)
+ */
+void SmartHome::Devices::Thermostats::BaseThermostat::applyMode(ThermostatMode mode)
 {
     _mode = mode;
+    _store.setOn(mode != ThermostatMode::OFF);
 }
 
 /*
@@ -149,6 +176,37 @@ SmartHome::Devices::Thermostats::BaseThermostat::getMode(void) const
     return _mode;
 }
 
+/*
+ *  Description : Retrieves the mode turnOn() restores.
+ *  Returns     : Last mode used before turning off (ThermostatMode)
+ */
+SmartHome::Devices::Thermostats::BaseThermostat::ThermostatMode
+SmartHome::Devices::Thermostats::BaseThermostat::getLastMode(void) const
+{
+    return _lastModeUsed;
+}
+
+/*
+ *  Description : Overwrites the mode turnOn() restores, leaving the
+ *                current mode alone.
+ *  Parameters  :
+ *    - mode : Mode to restore on the next turnOn() (ThermostatMode)
+ */
+void SmartHome::Devices::Thermostats::BaseThermostat::setLastMode(ThermostatMode mode)
+{
+    _lastModeUsed = mode;
+}
+
+/*
+ *  Description : A base thermostat can both heat and cool.
+ *  Parameters  :
+ *    - mode : Mode to check (ThermostatMode)
+ */
+bool SmartHome::Devices::Thermostats::BaseThermostat::supportsMode(ThermostatMode) const
+{
+    return true;
+}
+
 /*
  *  Description : Applies mode-specific temperature safety limits.
  *  Parameters  :
@@ -34,15 +34,15 @@ void SmartHome::Devices::Thermostats::CoolerThermostat::setMode(ThermostatMode m
     switch(mode)
     {
         case ThermostatMode::COOLING:
-            _mode = mode;  // Accept cooling mode normally
+            applyMode(mode);  // Accept cooling mode normally
             break;
 
         case ThermostatMode::OFF:
-            _mode = mode;  // Accept off mode normally
+            applyMode(mode);  // Accept off mode normally
             break;
             
         case ThermostatMode::HEATING:
-            _mode = ThermostatMode::COOLING;  // Convert heating to cooling
+            applyMode(ThermostatMode::COOLING);  // Convert heating to cooling
             break;
     }
 }
@@ -58,6 +58,17 @@ SmartHome::Devices::Thermostats::CoolerThermostat::getMode(void) const
     return _mode;
 }
 
+/*
+ *  Description : Reports whether the mode is accepted as requested; HEATING
+ *                requests are converted, so they are not supported.
+ *  Parameters  :
+ *    - mode : Mode to check (ThermostatMode)
+ */
+bool SmartHome::Devices::Thermostats::CoolerThermostat::supportsMode(ThermostatMode mode) const
+{
+    return mode != ThermostatMode::HEATING;
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
\ No newline at end of file
@@ -34,15 +34,15 @@ void SmartHome::Devices::Thermostats::HeaterThermostat::setMode(ThermostatMode m
     switch(mode)
     {
         case ThermostatMode::HEATING:
-            _mode = mode;  // Accept heating mode normally
+            applyMode(mode);  // Accept heating mode normally
             break;
 
         case ThermostatMode::OFF:
-            _mode = mode;  // Accept off mode normally
+            applyMode(mode);  // Accept off mode normally
             break;
             
         case ThermostatMode::COOLING:
-            _mode = ThermostatMode::HEATING;  // Convert cooling to heating
+            applyMode(ThermostatMode::HEATING);  // Convert cooling to heating
             break;
     }
 }
@@ -58,6 +58,17 @@ SmartHome::Devices::Thermostats::HeaterThermostat::getMode(void) const
     return _mode;
 }
 
+/*
+ *  Description : Reports whether the mode is accepted as requested; COOLING
+ *                requests are converted, so they are not supported.
+ *  Parameters  :
+ *    - mode : Mode to check (ThermostatMode)
+ */
+bool SmartHome::Devices::Thermostats::HeaterThermostat::supportsMode(ThermostatMode mode) const
+{
+    return mode != ThermostatMode::COOLING;
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
\ No newline at end of file
@@ -0,0 +1,207 @@
+/******************************************************************************
+ *  MODULE NAME  : Event Bus Implementation
+ *  FILE         : EventBus.cpp
+ *  DESCRIPTION  : Implements subscription management, publishing and the
+ *                 dispatch thread of the EventBus.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Events/EventBus.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+using SmartHome::Events::EventBus;
+using SmartHome::Core::DeviceEvent;
+using SmartHome::Core::EventMask;
+using SmartHome::Core::IObserver;
+
+namespace
+{
+    // Backstop in case a wake-up is ever missed; normal wake-ups are immediate
+    constexpr auto IDLE_TIMEOUT = std::chrono::milliseconds(50);
+}
+
+/*
+ * Description : Returns the singleton instance of EventBus.
+ */
+EventBus& EventBus::getInstance()
+{
+    static EventBus instance;
+    return instance;
+}
+
+EventBus::EventBus()
+    : _queue(QUEUE_CAPACITY)
+{
+}
+
+EventBus::~EventBus()
+{
+    stop();
+}
+
+std::int64_t EventBus::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Description : Adds or updates a subscription and refreshes the mask that
+ *               publish() filters on.
+ */
+void EventBus::subscribe(IObserver* observer, EventMask mask)
+{
+    std::lock_guard<std::mutex> lock(_subscribersMutex);
+
+    auto it = std::find_if(_subscribers.begin(), _subscribers.end(),
+        [observer](const auto& entry) { return entry.first == observer; });
+    if (it != _subscribers.end())
+        it->second = mask;
+    else
+        _subscribers.emplace_back(observer, mask);
+
+    EventMask listening = 0;
+    for (const auto& entry : _subscribers)
+        listening |= entry.second;
+    _listening.store(listening, std::memory_order_release);
+}
+
+/*
+ * Description : Removes a subscription. Delivery holds the same mutex, so
+ *               this waits out any callback in progress.
+ */
+void EventBus::unsubscribe(IObserver* observer)
+{
+    std::lock_guard<std::mutex> lock(_subscribersMutex);
+
+    _subscribers.erase(std::remove_if(_subscribers.begin(), _subscribers.end(),
+        [observer](const auto& entry) { return entry.first == observer; }), _subscribers.end());
+
+    EventMask listening = 0;
+    for (const auto& entry : _subscribers)
+        listening |= entry.second;
+    _listening.store(listening, std::memory_order_release);
+}
+
+/*
+ * Description : Enqueues the event and wakes the dispatcher only if it is
+ *               asleep, so a busy dispatcher costs producers no syscalls.
+ */
+bool EventBus::publish(const DeviceEvent& event)
+{
+    if (!(_listening.load(std::memory_order_acquire) & Core::eventMask(event.type)))
+        return false;
+
+    if (!_queue.push(event))
+        return false;
+
+    // Pairs with the fence in dispatchLoop: either it sees the event or we see it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleeping.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _wake.notify_one();
+    }
+    return true;
+}
+
+/*
+ * Description : Pops every queued event and hands it to matching observers.
+ */
+std::size_t EventBus::drain()
+{
+    std::lock_guard<std::mutex> consumer(_consumerMutex);
+
+    std::size_t delivered = 0;
+    DeviceEvent event;
+    while (_queue.pop(event))
+    {
+        std::lock_guard<std::mutex> lock(_subscribersMutex);
+        const EventMask bit = Core::eventMask(event.type);
+        for (const auto& [observer, mask] : _subscribers)
+        {
+            if (mask & bit)
+                observer->onEvent(event);
+        }
+        ++delivered;
+    }
+    return delivered;
+}
+
+std::size_t EventBus::dispatchPending()
+{
+    if (isRunning())
+        return 0; // The dispatch thread is the consumer
+
+    return drain();
+}
+
+void EventBus::start()
+{
+    if (_running.exchange(true))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stopRequested = false;
+    }
+    _dispatcher = std::thread(&EventBus::dispatchLoop, this);
+}
+
+void EventBus::stop()
+{
+    if (!_running.exchange(false))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stopRequested = true;
+    }
+    _wake.notify_one();
+    _dispatcher.join();
+
+    drain();
+}
+
+bool EventBus::isRunning() const
+{
+    return _running.load(std::memory_order_acquire);
+}
+
+std::uint64_t EventBus::droppedCount() const
+{
+    return _queue.droppedCount();
+}
+
+/*
+ * Description : Drains until the queue is empty, then announces the intent
+ *               to sleep under the wake mutex and re-checks before waiting.
+ *               A producer that sees the flag takes the same mutex to
+ *               notify, so the wake-up cannot slip in before the wait.
+ */
+void EventBus::dispatchLoop()
+{
+    for (;;)
+    {
+        if (drain() > 0)
+            continue;
+
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        if (_stopRequested)
+            return;
+
+        _sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (_queue.empty())
+            _wake.wait_for(lock, IDLE_TIMEOUT);
+        _sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,275 @@
+/******************************************************************************
+ *  MODULE NAME  : Thread Pool Executor Implementation
+ *  FILE         : ThreadPool.cpp
+ *  DESCRIPTION  : Implements the work-stealing ThreadPool and TaskGroup.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Executors/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+
+using namespace SmartHome::Executors;
+
+namespace
+{
+    thread_local const ThreadPool* tlsPool = nullptr;   // Pool the current thread works for
+    thread_local std::size_t tlsWorkerIndex = 0;
+}
+
+/*
+ *  Description: Creates one deque per worker and starts the workers.
+ */
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+    for (std::size_t i = 0; i < threadCount; ++i)
+        _workers.push_back(std::make_unique<Worker>());
+
+    for (std::size_t i = 0; i < threadCount; ++i)
+        _threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+/*
+ *  Description: Lets the workers drain the queues, then joins them.
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+    }
+    _workAvailable.notify_all();
+
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+/*
+ *  Description: Pushes to the calling worker's own deque, or round-robin
+ *               when called from outside the pool, then wakes a sleeper.
+ */
+void ThreadPool::submit(Task task)
+{
+    if (!task)
+        return;
+
+    const std::size_t target = (tlsPool == this)
+        ? tlsWorkerIndex
+        : _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+
+    _inFlight.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(_workers[target]->mutex);
+        _workers[target]->tasks.push_back(std::move(task));
+    }
+    _queued.fetch_add(1, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    _workAvailable.notify_one();
+}
+
+/*
+ *  Description: Runs one queued task on the calling thread.
+ */
+bool ThreadPool::runPendingTask()
+{
+    Task task;
+    if (!takeTask(tlsPool == this ? tlsWorkerIndex : NOT_A_WORKER, task))
+        return false;
+
+    runTask(task);
+    return true;
+}
+
+/*
+ *  Description: Blocks until no submitted task is queued or running.
+ */
+void ThreadPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(_sleepMutex);
+    _idle.wait(lock, [this] { return _inFlight.load(std::memory_order_acquire) == 0; });
+}
+
+std::size_t ThreadPool::size() const
+{
+    return _workers.size();
+}
+
+/*
+ *  Description: Takes work until the pool stops and the queues are empty.
+ */
+void ThreadPool::workerLoop(std::size_t index)
+{
+    tlsPool = this;
+    tlsWorkerIndex = index;
+
+    while (true)
+    {
+        Task task;
+        if (takeTask(index, task))
+        {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _workAvailable.wait(lock, [this]
+        {
+            return _stopping || _queued.load(std::memory_order_acquire) > 0;
+        });
+
+        if (_stopping && _queued.load(std::memory_order_acquire) == 0)
+            break;
+    }
+}
+
+/*
+ *  Description: Own deque bottom first (LIFO), then the tops of the other
+ *               deques starting after 'self' (FIFO steal).
+ */
+bool ThreadPool::takeTask(std::size_t self, Task& task)
+{
+    if (_queued.load(std::memory_order_acquire) == 0)
+        return false;
+
+    if (self != NOT_A_WORKER)
+    {
+        Worker& own = *_workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    const std::size_t count = _workers.size();
+    const std::size_t start = (self == NOT_A_WORKER) ? 0 : self + 1;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Worker& victim = *_workers[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ *  Description: Runs the task; the last task to finish wakes waitIdle().
+ */
+void ThreadPool::runTask(Task& task)
+{
+    try
+    {
+        task();
+    }
+    catch (...)
+    {
+        // Plain submissions have nobody to report to; TaskGroup captures its own
+    }
+
+    if (_inFlight.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _idle.notify_all();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// TaskGroup
+// ---------------------------------------------------------------------------
+
+TaskGroup::TaskGroup(ThreadPool& pool)
+    : _pool(pool), _state(std::make_shared<State>())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    try
+    {
+        wait();
+    }
+    catch (...)
+    {
+        // Errors are only reported through an explicit wait()
+    }
+}
+
+/*
+ *  Description: Submits a task whose completion (and failure) is tracked by
+ *               the group.
+ */
+void TaskGroup::run(ThreadPool::Task task)
+{
+    if (!task)
+        return;
+
+    _state->outstanding.fetch_add(1, std::memory_order_relaxed);
+
+    _pool.submit([state = _state, task = std::move(task)]()
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!state->error)
+                state->error = std::current_exception();
+        }
+
+        if (state->outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->done.notify_all();
+        }
+    });
+}
+
+/*
+ *  Description: Helps execute queued work until the group is done, then
+ *               rethrows the first captured exception, if any.
+ */
+void TaskGroup::wait()
+{
+    while (_state->outstanding.load(std::memory_order_acquire) > 0)
+    {
+        if (_pool.runPendingTask())
+            continue;
+
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        _state->done.wait_for(lock, std::chrono::milliseconds(1), [this]
+        {
+            return _state->outstanding.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        std::swap(error, _state->error);
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -2,18 +2,173 @@
  *  MODULE NAME  : Smart Home - Device Factory
  *  FILE         : DeviceFactory.cpp
  *  DESCRIPTION  : Implements the DeviceFactory class which allows registration
- *                 and creation of device objects using a key-based system.
+ *                 and creation of device objects using a key-based system,
+ *                 and the compile-time lookup table of the built-in models.
  *  AUTHOR       : Hassan Darwish
  *  DATE CREATED : July 2025
  ******************************************************************************/
 
 #include "SmartHome/Factory/DeviceFactory.hpp"
-#include <algorithm>
+#include "SmartHome/Factory/DeviceRegistration.hpp"
+
+#include <array>
+#include <cstddef>
 #include <stdexcept>
 
 using namespace SmartHome::Factory;
 using SmartHome::Core::IDevice;
 
+namespace
+{
+    using Creator = std::shared_ptr<IDevice> (*)(const std::string& id, const std::string& type);
+
+    constexpr bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    constexpr char toUpper(char c)
+    {
+        return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+    /*
+     * Description : FNV-1a over the normalized characters of 'raw', so the
+     *               key never has to be copied to be normalized.
+     */
+    constexpr std::uint32_t keyHash(std::string_view raw, std::uint32_t seed = 0)
+    {
+        std::uint32_t hash = 2166136261u ^ seed;
+        for (char c : raw)
+        {
+            if (isBlank(c))
+                continue;
+            hash ^= static_cast<unsigned char>(toUpper(c));
+            hash *= 16777619u;
+        }
+        hash ^= hash >> 15;     // Spread the high bits into the slot bits
+        return hash;
+    }
+
+    /*
+     * Description : Compares 'raw' with an already normalized key.
+     */
+    constexpr bool sameKey(std::string_view raw, std::string_view normalized)
+    {
+        std::size_t n = 0;
+        for (char c : raw)
+        {
+            if (isBlank(c))
+                continue;
+            if (n == normalized.size() || toUpper(c) != normalized[n])
+                return false;
+            ++n;
+        }
+        return n == normalized.size();
+    }
+
+    constexpr bool isNormalized(std::string_view key)
+    {
+        if (key.empty())
+            return false;
+        for (char c : key)
+        {
+            if (isBlank(c) || toUpper(c) != c)
+                return false;
+        }
+        return true;
+    }
+
+    struct BuiltIn
+    {
+        std::string_view key;
+        Creator create;
+    };
+
+    template <typename... Devices>
+    constexpr std::array<BuiltIn, sizeof...(Devices)> makeBuiltIns(std::tuple<Devices...>*)
+    {
+        return {{ BuiltIn{ DeviceTraits<Devices>::KEY, &DeviceTraits<Devices>::create }... }};
+    }
+
+    constexpr auto BUILT_INS = makeBuiltIns(static_cast<BuiltInDevices*>(nullptr));
+
+    // Power of two, at least twice the number of built-ins
+    constexpr std::size_t TABLE_SIZE = [] {
+        std::size_t size = 1;
+        while (size < 2 * BUILT_INS.size())
+            size *= 2;
+        return size;
+    }();
+    constexpr std::uint8_t EMPTY_SLOT = 0xFF;
+    constexpr std::uint32_t NO_SEED = 0xFFFFFFFFu;
+
+    static_assert(BUILT_INS.size() < EMPTY_SLOT, "Too many built-in device models");
+
+    /*
+     * Description : Finds a seed under which every built-in key lands in its
+     *               own slot, so a lookup is one hash and one compare.
+     */
+    constexpr std::uint32_t findSeed(void)
+    {
+        for (std::uint32_t seed = 0; seed < 1u << 16; ++seed)
+        {
+            std::array<bool, TABLE_SIZE> used{};
+            bool perfect = true;
+            for (const BuiltIn& builtIn : BUILT_INS)
+            {
+                const std::size_t slot = keyHash(builtIn.key, seed) & (TABLE_SIZE - 1);
+                if (used[slot])
+                {
+                    perfect = false;
+                    break;
+                }
+                used[slot] = true;
+            }
+            if (perfect)
+                return seed;
+        }
+        return NO_SEED;
+    }
+
+    constexpr std::uint32_t SEED = findSeed();
+    static_assert(SEED != NO_SEED, "No perfect hash for the built-in device keys");
+
+    constexpr std::array<std::uint8_t, TABLE_SIZE> makeSlots(void)
+    {
+        std::array<std::uint8_t, TABLE_SIZE> slots{};
+        for (auto& slot : slots)
+            slot = EMPTY_SLOT;
+        for (std::size_t i = 0; i < BUILT_INS.size(); ++i)
+            slots[keyHash(BUILT_INS[i].key, SEED) & (TABLE_SIZE - 1)] = static_cast<std::uint8_t>(i);
+        return slots;
+    }
+
+    constexpr auto SLOTS = makeSlots();
+
+    constexpr bool allNormalized(void)
+    {
+        for (const BuiltIn& builtIn : BUILT_INS)
+        {
+            if (!isNormalized(builtIn.key))
+                return false;
+        }
+        return true;
+    }
+    static_assert(allNormalized(), "Built-in device keys must be upper case without spaces");
+
+    constexpr Creator findBuiltIn(std::string_view key)
+    {
+        const std::uint8_t index = SLOTS[keyHash(key, SEED) & (TABLE_SIZE - 1)];
+        if (index == EMPTY_SLOT || !sameKey(key, BUILT_INS[index].key))
+            return nullptr;
+        return BUILT_INS[index].create;
+    }
+
+    static_assert(findBuiltIn(" light :: Dimmable ") == &DeviceTraits<SmartHome::Devices::Lights::DimmableLight>::create);
+    static_assert(findBuiltIn("LIGHT::LED") == nullptr);
+}
+
 // Singleton access
 DeviceFactory& DeviceFactory::getInstance()
 {
@@ -22,44 +177,102 @@ DeviceFactory& DeviceFactory::getInstance()
 }
 
 // Register a device creator
-void DeviceFactory::registerCreator(const std::string& key, CreatorFunc creator)
+void DeviceFactory::registerCreator(std::string_view key, CreatorFunc creator)
+{
+    std::string normalized = makeKey(key);
+    if (normalized.empty())
+        throw std::invalid_argument("Device type key must not be empty.");
+    if (findBuiltIn(normalized))
+        throw std::invalid_argument("Device type '" + normalized + "' is built in.");
+
+    const std::uint32_t hash = keyHash(normalized);
+    for (CustomCreator& custom : _custom)
+    {
+        if (custom.hash == hash && custom.key == normalized)
+        {
+            custom.creator = std::move(creator);
+            return;
+        }
+    }
+    _custom.push_back({ hash, std::move(normalized), std::move(creator) });
+}
+
+// Look up a run-time registered creator
+const DeviceFactory::CustomCreator* DeviceFactory::findCustom(std::string_view key) const
 {
-    _creators[key] = std::move(creator);
+    if (_custom.empty())
+        return nullptr;
+
+    const std::uint32_t hash = keyHash(key);
+    for (const CustomCreator& custom : _custom)
+    {
+        if (custom.hash == hash && sameKey(key, custom.key))
+            return &custom;
+    }
+    return nullptr;
 }
 
 // Check if a key is already registered
-bool DeviceFactory::isRegistered(const std::string& key) const
+bool DeviceFactory::isRegistered(std::string_view key) const
 {
-    return _creators.find(key) != _creators.end();
+    return findBuiltIn(key) != nullptr || findCustom(key) != nullptr;
 }
 
 // Create a device instance by key
-std::shared_ptr<IDevice> DeviceFactory::createDevice(const std::string& key, const std::string& id, const std::string& type) const
+std::shared_ptr<IDevice> DeviceFactory::createDevice(std::string_view key, const std::string& id, const std::string& type) const
 {
-    auto it = _creators.find(key);
-    if (it != _creators.end())
+    if (const Creator create = findBuiltIn(key))
+        return create(id, type);
+    if (const CustomCreator* custom = findCustom(key))
+        return custom->creator(id, type);
+
+    throw std::invalid_argument("Device type '" + std::string(key) + "' is not registered.");
+}
+
+// Create a batch of devices of one model
+std::vector<std::shared_ptr<IDevice>> DeviceFactory::createDevices(std::string_view key, const std::vector<std::string>& ids, const std::string& type) const
+{
+    std::vector<std::shared_ptr<IDevice>> devices;
+    devices.reserve(ids.size());
+
+    if (const Creator create = findBuiltIn(key))
     {
-        return it->second(id, type);
+        for (const std::string& id : ids)
+            devices.push_back(create(id, type));
+        return devices;
+    }
+    if (const CustomCreator* custom = findCustom(key))
+    {
+        for (const std::string& id : ids)
+            devices.push_back(custom->creator(id, type));
+        return devices;
     }
 
-    throw std::invalid_argument("Device type '" + key + "' is not registered.");
+    throw std::invalid_argument("Device type '" + std::string(key) + "' is not registered.");
 }
 
 // List all registered device types
 std::vector<std::string> DeviceFactory::listSupportedDevices() const
 {
     std::vector<std::string> keys;
-    for (const auto& [k, _] : _creators)
-        keys.push_back(k);
+    keys.reserve(BUILT_INS.size() + _custom.size());
+    for (const BuiltIn& builtIn : BUILT_INS)
+        keys.emplace_back(builtIn.key);
+    for (const CustomCreator& custom : _custom)
+        keys.push_back(custom.key);
     return keys;
 }
 
-// Optional: clean key names (lowercase, remove spaces, etc.)
-std::string DeviceFactory::makeKey(const std::string& raw) const
+// Clean key names (uppercase, remove spaces)
+std::string DeviceFactory::makeKey(std::string_view raw)
 {
-    std::string key = raw;
-    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
-    key.erase(std::remove_if(key.begin(), key.end(), ::isspace), key.end());
+    std::string key;
+    key.reserve(raw.size());
+    for (char c : raw)
+    {
+        if (!isBlank(c))
+            key.push_back(toUpper(c));
+    }
     return key;
 }
 
@@ -0,0 +1,420 @@
+/******************************************************************************
+ *  MODULE NAME  : Persistence Implementation
+ *  FILE         : CommandJournal.cpp
+ *  DESCRIPTION  : Implements the CommandJournal: record encoding with
+ *                 CRC-32C, tail validation on open, the group committer and
+ *                 replay through Commands::applyValue.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Persistence/CommandJournal.hpp"
+#include "SmartHome/Commands/ApplyRecord.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using SmartHome::Persistence::CommandJournal;
+using SmartHome::Core::CommandCode;
+using SmartHome::Core::CommandRecord;
+
+namespace
+{
+    constexpr std::size_t HEADER_BYTES = 28;    // Fixed part of a record
+    constexpr std::size_t LENGTH_COVERED = 20;  // Fixed bytes after the length field
+    constexpr std::size_t MAX_ID_LENGTH = 0xFFFF;
+
+    /*
+     * Description : CRC-32C (Castagnoli) lookup table, built at compile time.
+     */
+    constexpr std::array<std::uint32_t, 256> makeCrcTable()
+    {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i = 0; i < 256; ++i)
+        {
+            std::uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc >> 1) ^ ((crc & 1u) ? 0x82F63B78u : 0u);
+            table[i] = crc;
+        }
+        return table;
+    }
+
+    constexpr std::array<std::uint32_t, 256> CRC_TABLE = makeCrcTable();
+
+    std::uint32_t crc32c(const char* data, std::size_t size)
+    {
+        std::uint32_t crc = 0xFFFFFFFFu;
+        for (std::size_t i = 0; i < size; ++i)
+            crc = CRC_TABLE[(crc ^ static_cast<unsigned char>(data[i])) & 0xFFu] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    template <typename T>
+    void put(char*& out, T value)
+    {
+        std::memcpy(out, &value, sizeof(T));
+        out += sizeof(T);
+    }
+
+    template <typename T>
+    T get(const char* in)
+    {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        return value;
+    }
+
+    /*
+     * Description : Appends one encoded record to 'out'.
+     */
+    void encode(std::string& out, std::uint64_t lsn, const CommandRecord& record, std::string_view id)
+    {
+        const std::size_t start = out.size();
+        out.resize(start + HEADER_BYTES + id.size());
+
+        char* p = &out[start + 4];
+        put<std::uint32_t>(p, static_cast<std::uint32_t>(LENGTH_COVERED + id.size()));
+        put<std::uint64_t>(p, lsn);
+        put<std::uint8_t>(p, static_cast<std::uint8_t>(record.code));
+        put<std::uint8_t>(p, 0);
+        put<std::uint16_t>(p, static_cast<std::uint16_t>(id.size()));
+        put<float>(p, record.oldValue);
+        put<float>(p, record.newValue);
+        std::memcpy(p, id.data(), id.size());
+
+        char* crc = &out[start];
+        put<std::uint32_t>(crc, crc32c(&out[start + 4], HEADER_BYTES - 4 + id.size()));
+    }
+
+    struct Decoded
+    {
+        std::uint64_t lsn;
+        CommandCode code;
+        float oldValue;
+        float newValue;
+        std::string_view id;
+    };
+
+    /*
+     * Description : Calls 'visit(const Decoded&)' for each valid record and
+     *               returns the length of the valid prefix. Stops at the
+     *               first record that is short, fails its CRC or goes back
+     *               in LSN: everything after it is a torn write.
+     */
+    template <typename Visit>
+    std::size_t scan(const std::string& data, Visit&& visit)
+    {
+        std::size_t offset = 0;
+        std::uint64_t lastLsn = 0;
+
+        while (data.size() - offset >= HEADER_BYTES)
+        {
+            const char* p = data.data() + offset;
+            const std::uint32_t length = get<std::uint32_t>(p + 4);
+            if (length < LENGTH_COVERED || length > data.size() - offset - 8)
+                break;
+
+            const std::uint16_t idLength = get<std::uint16_t>(p + 18);
+            if (length != LENGTH_COVERED + idLength || get<std::uint32_t>(p) != crc32c(p + 4, length + 4))
+                break;
+
+            Decoded record{ get<std::uint64_t>(p + 8), static_cast<CommandCode>(get<std::uint8_t>(p + 16)),
+                            get<float>(p + 20), get<float>(p + 24), std::string_view(p + HEADER_BYTES, idLength) };
+            if (record.lsn <= lastLsn || record.code >= CommandCode::COUNT)
+                break;
+
+            lastLsn = record.lsn;
+            visit(record);
+            offset += 8 + length;
+        }
+        return offset;
+    }
+
+    std::string readAll(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return {};
+        std::ostringstream content;
+        content << in.rdbuf();
+        return content.str();
+    }
+}
+
+CommandJournal::CommandJournal(JournalOptions options)
+    : _options(options)
+{
+}
+
+CommandJournal::~CommandJournal()
+{
+    close();
+}
+
+/*
+ * Description : Replays in LSN order. Records whose target no longer exists
+ *               or has a different type are counted and skipped.
+ */
+CommandJournal::ReplayResult CommandJournal::replay(const std::string& path, const Resolver& resolve)
+{
+    const std::string data = readAll(path);
+    ReplayResult result;
+
+    const std::size_t valid = scan(data, [&](const Decoded& record)
+    {
+        result.lastLsn = record.lsn;
+
+        const std::shared_ptr<Core::IDevice> target = resolve(record.id);
+        if (!target)
+        {
+            ++result.skipped;
+            return;
+        }
+
+        try
+        {
+            Commands::applyValue(*target, record.code, record.newValue);
+            ++result.applied;
+        }
+        catch (const std::invalid_argument&)
+        {
+            ++result.skipped;
+        }
+    });
+
+    result.tornBytes = data.size() - valid;
+    return result;
+}
+
+/*
+ * Description : Cuts an invalid tail off before appending, so new records
+ *               never sit behind garbage that replay would stop at.
+ */
+void CommandJournal::open(const std::string& path)
+{
+    close();
+
+    const std::string data = readAll(path);
+    std::uint64_t lastLsn = 0;
+    const std::size_t valid = scan(data, [&lastLsn](const Decoded& record) { lastLsn = record.lsn; });
+
+    std::error_code error;
+    if (valid < data.size())
+        std::filesystem::resize_file(path, valid, error);
+    if (error)
+        throw std::runtime_error("journal: cannot truncate " + path + ": " + error.message());
+
+    std::FILE* file = std::fopen(path.c_str(), "ab");
+    if (!file)
+        throw std::runtime_error("journal: cannot open " + path);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _path = path;
+    _file = file;
+    _lastLsn = std::max(_lastLsn, lastLsn);
+    _durableLsn = _lastLsn;
+    _failed = false;
+    _stop = false;
+
+    if (_options.policy == SyncPolicy::GROUP_COMMIT)
+        _committer = std::thread(&CommandJournal::commitLoop, this);
+}
+
+void CommandJournal::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_file)
+            return;
+        _stop = true;
+    }
+    _wake.notify_all();
+    if (_committer.joinable())
+        _committer.join();    // The committer drains the pending batch first
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::fclose(_file);
+    _file = nullptr;
+    _committed.notify_all();
+}
+
+bool CommandJournal::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _file != nullptr;
+}
+
+std::uint64_t CommandJournal::append(const CommandRecord& record, std::string_view targetId)
+{
+    if (targetId.size() > MAX_ID_LENGTH)
+        throw std::invalid_argument("journal: target ID too long");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_file)
+        return 0;
+
+    const std::uint64_t lsn = ++_lastLsn;
+    const bool wasEmpty = _pending.empty();
+    encode(_pending, lsn, record, targetId);
+
+    if (_options.policy == SyncPolicy::EVERY_RECORD)
+    {
+        const bool ok = writeAndSync(_pending);
+        _pending.clear();
+        ++_syncs;
+        if (!ok)
+        {
+            _failed = true;
+            throw std::runtime_error("journal: cannot write " + _path);
+        }
+        _durableLsn = lsn;
+        return lsn;
+    }
+
+    // The committer sleeps until a batch starts, then until it is due or full
+    if (wasEmpty || _pending.size() >= _options.maxBatchBytes)
+        _wake.notify_one();
+    return lsn;
+}
+
+/*
+ * Description : A waiter cuts the batching delay short; records appended
+ *               while the current batch is being synced share the next one.
+ */
+void CommandJournal::waitDurable(std::uint64_t lsn)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_durableLsn >= lsn)
+        return;
+
+    ++_waiters;
+    _wake.notify_one();
+    _committed.wait(lock, [this, lsn]() { return _durableLsn >= lsn || _failed || !_file; });
+    --_waiters;
+
+    if (_durableLsn < lsn)
+        throw std::runtime_error("journal: records up to " + std::to_string(lsn) + " are not durable");
+}
+
+void CommandJournal::flush()
+{
+    std::uint64_t lsn;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        lsn = _lastLsn;
+    }
+    waitDurable(lsn);
+}
+
+/*
+ * Description : Rewrites the file once no batch is being written. Written
+ *               records are in LSN order, so the ones kept are a suffix.
+ *               Records still pending come after all of them and go to the
+ *               rewritten file.
+ */
+void CommandJournal::reset(std::uint64_t coveredLsn)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_file)
+        return;
+    _committed.wait(lock, [this]() { return !_committing; });
+
+    const std::string data = readAll(_path);
+    std::size_t keepFrom = 0;
+    const std::size_t valid = scan(data, [&keepFrom, coveredLsn](const Decoded& record)
+    {
+        if (record.lsn <= coveredLsn)
+            keepFrom += HEADER_BYTES + record.id.size();
+    });
+
+    std::fclose(_file);
+    _file = std::fopen(_path.c_str(), "wb");
+    if (!_file || !writeAndSync(data.substr(keepFrom, valid - keepFrom)))
+    {
+        _failed = true;
+        throw std::runtime_error("journal: cannot reset " + _path);
+    }
+}
+
+std::uint64_t CommandJournal::lastLsn() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _lastLsn;
+}
+
+std::uint64_t CommandJournal::durableLsn() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _durableLsn;
+}
+
+std::uint64_t CommandJournal::syncCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _syncs;
+}
+
+bool CommandJournal::writeAndSync(const std::string& bytes)
+{
+    if (!bytes.empty() && std::fwrite(bytes.data(), 1, bytes.size(), _file) != bytes.size())
+        return false;
+    if (std::fflush(_file) != 0)
+        return false;
+#if defined(_WIN32)
+    return ::_commit(::_fileno(_file)) == 0;
+#else
+    return ::fsync(::fileno(_file)) == 0;
+#endif
+}
+
+void CommandJournal::commitLoop()
+{
+    std::string batch;
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true)
+    {
+        _wake.wait(lock, [this]() { return _stop || !_pending.empty(); });
+        if (_pending.empty())
+            break;    // Stopping with nothing left to write
+
+        // Let the batch grow unless someone waits, it is full, or we stop
+        _wake.wait_for(lock, _options.maxDelay, [this]()
+        {
+            return _stop || _waiters > 0 || _pending.size() >= _options.maxBatchBytes;
+        });
+
+        batch.clear();
+        batch.swap(_pending);
+        const std::uint64_t upTo = _lastLsn;
+        _committing = true;
+
+        lock.unlock();
+        const bool ok = writeAndSync(batch);
+        lock.lock();
+
+        _committing = false;
+        ++_syncs;
+        if (ok)
+            _durableLsn = upTo;
+        else
+            _failed = true;
+        _committed.notify_all();
+    }
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
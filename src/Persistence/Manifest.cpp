@@ -0,0 +1,586 @@
+/******************************************************************************
+ *  MODULE NAME  : Persistence Implementation
+ *  FILE         : Manifest.cpp
+ *  DESCRIPTION  : Implements the Manifest: a line parser for the CSV and
+ *                 JSON-lines forms that keeps views into the mapped file,
+ *                 and the builder that creates devices through the
+ *                 DeviceFactory in batches, applies their initial state and
+ *                 fills the groups in one pass.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Persistence/Manifest.hpp"
+#include "SmartHome/Persistence/MappedFile.hpp"
+#include "SmartHome/Commands/ApplyRecord.hpp"
+#include "SmartHome/Core/CommandRecord.hpp"
+#include "SmartHome/Devices/Thermostats/BaseThermostat.hpp"
+#include "SmartHome/Factory/DeviceFactory.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+using SmartHome::Persistence::Manifest;
+using SmartHome::Persistence::MappedFile;
+using SmartHome::Core::CommandCode;
+using SmartHome::Core::IDevice;
+using SmartHome::Devices::DeviceGroup;
+
+namespace
+{
+    using ThermostatMode = SmartHome::Devices::Thermostats::BaseThermostat::ThermostatMode;
+
+    constexpr std::uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    struct StateWrite
+    {
+        CommandCode code;
+        float value;
+    };
+
+    /*
+     * Description : One device line. Groups and state are ranges of the
+     *               parser's shared arrays; strings point into the manifest.
+     */
+    struct DeviceRow
+    {
+        std::string_view id;
+        std::string_view model;
+        std::string_view type;
+        std::uint32_t groupsBegin, groupsEnd;
+        std::uint32_t stateBegin, stateEnd;
+        std::size_t line;
+    };
+
+    struct GroupRow
+    {
+        std::string_view name;
+        std::string_view parent;
+        std::size_t line;
+    };
+
+    bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    std::string_view trim(std::string_view text)
+    {
+        while (!text.empty() && isBlank(text.front()))
+            text.remove_prefix(1);
+        while (!text.empty() && isBlank(text.back()))
+            text.remove_suffix(1);
+        return text;
+    }
+
+    bool equalsIgnoreCase(std::string_view text, std::string_view lower)
+    {
+        if (text.size() != lower.size())
+            return false;
+        for (std::size_t i = 0; i < text.size(); ++i)
+        {
+            const char c = (text[i] >= 'A' && text[i] <= 'Z') ? static_cast<char>(text[i] - 'A' + 'a') : text[i];
+            if (c != lower[i])
+                return false;
+        }
+        return true;
+    }
+
+    /*
+     * Description : Splits off the text up to the next 'separator'.
+     */
+    std::string_view nextField(std::string_view& rest, char separator)
+    {
+        const std::size_t end = rest.find(separator);
+        const std::string_view field = rest.substr(0, end);
+        rest = (end == std::string_view::npos) ? std::string_view() : rest.substr(end + 1);
+        return trim(field);
+    }
+
+    /******************************************************************************
+     *  CLASS NAME   : ManifestParser
+     *  DESCRIPTION  : Turns the manifest text into rows without building
+     *                 anything, so the builder can batch by model and size
+     *                 every container up front.
+     ******************************************************************************/
+    class ManifestParser
+    {
+    public:
+        std::vector<DeviceRow> devices;
+        std::vector<GroupRow> groups;
+        std::vector<std::string_view> memberships;     // Group names of the device rows
+        std::vector<StateWrite> states;
+        std::size_t lines = 0;
+
+        void parse(std::string_view text)
+        {
+            while (!text.empty())
+            {
+                const std::size_t end = text.find('\n');
+                const std::string_view line = trim(text.substr(0, end));
+                text = (end == std::string_view::npos) ? std::string_view() : text.substr(end + 1);
+                ++lines;
+
+                if (line.empty() || line.front() == '#')
+                    continue;
+                if (line.front() == '{')
+                    parseJson(line);
+                else
+                    parseCsv(line);
+            }
+        }
+
+        [[noreturn]] static void fail(std::size_t line, const std::string& what)
+        {
+            throw std::runtime_error("manifest: line " + std::to_string(line) + ": " + what);
+        }
+
+    private:
+        std::deque<std::string> _unescaped;     // JSON strings that had escapes; stable addresses
+
+        [[noreturn]] void fail(const std::string& what) const
+        {
+            fail(lines, what);
+        }
+
+        void parseCsv(std::string_view rest)
+        {
+            const std::string_view kind = nextField(rest, ',');
+            if (kind == "device")
+            {
+                const std::string_view id = nextField(rest, ',');
+                const std::string_view model = nextField(rest, ',');
+                const std::string_view type = nextField(rest, ',');
+                DeviceRow row = beginDevice(id, model, type);
+
+                std::string_view groupList = nextField(rest, ',');
+                while (!groupList.empty())
+                    addMembership(nextField(groupList, ';'));
+
+                std::string_view stateList = nextField(rest, ',');
+                while (!stateList.empty())
+                {
+                    std::string_view entry = nextField(stateList, ';');
+                    if (entry.empty())
+                        continue;
+                    const std::string_view key = nextField(entry, '=');
+                    addState(key, trim(entry));
+                }
+                if (!trim(rest).empty())
+                    fail("too many fields");
+                endDevice(row);
+            }
+            else if (kind == "group")
+            {
+                const std::string_view name = nextField(rest, ',');
+                const std::string_view parent = nextField(rest, ',');
+                if (!trim(rest).empty())
+                    fail("too many fields");
+                addGroup(name, parent);
+            }
+            else if (kind == "kind" && devices.empty() && groups.empty())
+            {
+                return;     // Header
+            }
+            else
+            {
+                fail("unknown record '" + std::string(kind) + "'");
+            }
+        }
+
+        /*
+         * Description : Reads one flat JSON object. Scalars are kept as text
+         *               and converted by the same code as CSV values.
+         */
+        void parseJson(std::string_view line)
+        {
+            std::size_t pos = 0;
+            auto skipBlank = [&]() { while (pos < line.size() && (isBlank(line[pos]) || line[pos] == '\n')) ++pos; };
+            auto expect = [&](char c)
+            {
+                skipBlank();
+                if (pos >= line.size() || line[pos] != c)
+                    fail(std::string("expected '") + c + "'");
+                ++pos;
+            };
+            auto peek = [&]() { skipBlank(); return pos < line.size() ? line[pos] : '\0'; };
+            auto string = [&]() { skipBlank(); return readString(line, pos); };
+            auto scalar = [&]() -> std::string_view
+            {
+                if (peek() == '"')
+                    return string();
+                const std::size_t start = pos;
+                while (pos < line.size() && line[pos] != ',' && line[pos] != '}' && line[pos] != ']')
+                    ++pos;
+                const std::string_view text = trim(line.substr(start, pos - start));
+                if (text.empty())
+                    fail("expected a value");
+                return text;
+            };
+
+            std::string_view device, model, type, group, parent;
+            bool isDevice = false;
+            bool isGroup = false;
+            const std::size_t groupsBegin = memberships.size();
+            const std::size_t stateBegin = states.size();
+
+            expect('{');
+            if (peek() == '}')
+                fail("empty object");
+            do
+            {
+                const std::string_view key = string();
+                expect(':');
+                if (key == "groups")
+                {
+                    if (peek() == '[')
+                    {
+                        ++pos;
+                        if (peek() != ']')
+                        {
+                            do
+                                addMembership(string());
+                            while (peek() == ',' && ++pos);
+                        }
+                        expect(']');
+                    }
+                    else
+                    {
+                        addMembership(string());
+                    }
+                }
+                else if (key == "state")
+                {
+                    expect('{');
+                    if (peek() != '}')
+                    {
+                        do
+                        {
+                            const std::string_view name = string();
+                            expect(':');
+                            addState(name, scalar());
+                        }
+                        while (peek() == ',' && ++pos);
+                    }
+                    expect('}');
+                }
+                else if (key == "device") { device = scalar(); isDevice = true; }
+                else if (key == "model")  { model = scalar(); }
+                else if (key == "type")   { type = scalar(); }
+                else if (key == "group")  { group = scalar(); isGroup = true; }
+                else if (key == "parent") { parent = scalar(); }
+                else
+                    fail("unknown key '" + std::string(key) + "'");
+            }
+            while (peek() == ',' && ++pos);
+            expect('}');
+            if (peek() != '\0')
+                fail("text after the object");
+
+            if (isDevice == isGroup)
+                fail("a record needs exactly one of \"device\" and \"group\"");
+            if (isGroup)
+            {
+                if (memberships.size() != groupsBegin || states.size() != stateBegin || !model.empty() || !type.empty())
+                    fail("a group takes only \"parent\"");
+                addGroup(group, parent);
+                return;
+            }
+            if (!parent.empty())
+                fail("a device takes \"groups\", not \"parent\"");
+
+            DeviceRow row = beginDevice(device, model, type);
+            row.groupsBegin = static_cast<std::uint32_t>(groupsBegin);
+            row.stateBegin = static_cast<std::uint32_t>(stateBegin);
+            endDevice(row);
+        }
+
+        /*
+         * Description : Reads a JSON string at 'pos'. Escape-free strings are
+         *               returned as views into the line.
+         */
+        std::string_view readString(std::string_view line, std::size_t& pos)
+        {
+            if (pos >= line.size() || line[pos] != '"')
+                fail("expected a string");
+            const std::size_t start = ++pos;
+            while (pos < line.size() && line[pos] != '"' && line[pos] != '\\')
+                ++pos;
+            if (pos < line.size() && line[pos] == '"')
+                return line.substr(start, pos++ - start);
+
+            std::string decoded(line.substr(start, pos - start));
+            while (pos < line.size() && line[pos] != '"')
+            {
+                char c = line[pos++];
+                if (c == '\\')
+                {
+                    if (pos >= line.size())
+                        break;
+                    switch (line[pos++])
+                    {
+                        case '"':  c = '"';  break;
+                        case '\\': c = '\\'; break;
+                        case '/':  c = '/';  break;
+                        case 'n':  c = '\n'; break;
+                        case 't':  c = '\t'; break;
+                        case 'r':  c = '\r'; break;
+                        default:   fail("unsupported escape in string");
+                    }
+                }
+                decoded.push_back(c);
+            }
+            if (pos >= line.size())
+                fail("unterminated string");
+            ++pos;
+            _unescaped.push_back(std::move(decoded));
+            return _unescaped.back();
+        }
+
+        DeviceRow beginDevice(std::string_view id, std::string_view model, std::string_view type)
+        {
+            if (id.empty())
+                fail("device without an id");
+            if (model.empty())
+                fail("device '" + std::string(id) + "' has no model");
+
+            DeviceRow row{};
+            row.id = id;
+            row.model = model;
+            row.type = type;
+            row.groupsBegin = static_cast<std::uint32_t>(memberships.size());
+            row.stateBegin = static_cast<std::uint32_t>(states.size());
+            row.line = lines;
+            return row;
+        }
+
+        void endDevice(DeviceRow& row)
+        {
+            row.groupsEnd = static_cast<std::uint32_t>(memberships.size());
+            row.stateEnd = static_cast<std::uint32_t>(states.size());
+            devices.push_back(row);
+        }
+
+        void addMembership(std::string_view group)
+        {
+            if (!group.empty())
+                memberships.push_back(group);
+        }
+
+        void addGroup(std::string_view name, std::string_view parent)
+        {
+            if (name.empty())
+                fail("group without a name");
+            if (name == parent)
+                fail("group '" + std::string(name) + "' is its own parent");
+            groups.push_back({ name, parent, lines });
+        }
+
+        void addState(std::string_view key, std::string_view value)
+        {
+            if (key == "power")            states.push_back({ CommandCode::POWER, flag(value) });
+            else if (key == "brightness")  states.push_back({ CommandCode::BRIGHTNESS, number(value) });
+            else if (key == "target")      states.push_back({ CommandCode::TARGET_TEMPERATURE, number(value) });
+            else if (key == "mode")        states.push_back({ CommandCode::THERMOSTAT_MODE, mode(value) });
+            else if (key == "locked")      states.push_back({ CommandCode::LOCK, flag(value) });
+            else if (key == "recording")   states.push_back({ CommandCode::RECORDING, flag(value) });
+            else if (key == "nightvision") states.push_back({ CommandCode::NIGHT_VISION, flag(value) });
+            else
+                fail("unknown state '" + std::string(key) + "'");
+        }
+
+        float flag(std::string_view value) const
+        {
+            if (value == "1" || equalsIgnoreCase(value, "true") || equalsIgnoreCase(value, "on"))
+                return 1.0f;
+            if (value == "0" || equalsIgnoreCase(value, "false") || equalsIgnoreCase(value, "off"))
+                return 0.0f;
+            fail("expected true or false, got '" + std::string(value) + "'");
+        }
+
+        float number(std::string_view value) const
+        {
+            char buffer[32];
+            if (value.empty() || value.size() >= sizeof(buffer))
+                fail("expected a number, got '" + std::string(value) + "'");
+            value.copy(buffer, value.size());
+            buffer[value.size()] = '\0';
+
+            char* end = nullptr;
+            const float parsed = std::strtof(buffer, &end);
+            if (end != buffer + value.size())
+                fail("expected a number, got '" + std::string(value) + "'");
+            return parsed;
+        }
+
+        float mode(std::string_view value) const
+        {
+            if (equalsIgnoreCase(value, "heating"))
+                return static_cast<float>(static_cast<int>(ThermostatMode::HEATING));
+            if (equalsIgnoreCase(value, "cooling"))
+                return static_cast<float>(static_cast<int>(ThermostatMode::COOLING));
+            if (equalsIgnoreCase(value, "off"))
+                return static_cast<float>(static_cast<int>(ThermostatMode::OFF));
+            fail("unknown thermostat mode '" + std::string(value) + "'");
+        }
+    };
+
+    /*
+     * Description : Index of group 'name', creating it if the manifest only
+     *               refers to it.
+     */
+    std::uint32_t groupIndex(std::string_view name,
+                             std::unordered_map<std::string_view, std::uint32_t>& index,
+                             std::vector<std::shared_ptr<DeviceGroup>>& groups)
+    {
+        const auto [it, inserted] = index.emplace(name, static_cast<std::uint32_t>(groups.size()));
+        if (inserted)
+            groups.push_back(std::make_shared<DeviceGroup>(std::string(name)));
+        return it->second;
+    }
+}
+
+Manifest::Contents Manifest::load(const std::string& path)
+{
+    const MappedFile file(path, "manifest");
+    return parse(std::string_view(file.data(), file.size()));
+}
+
+/*
+ * Description : Parses everything first, then builds: groups, devices in
+ *               runs of the same model and type, their state, and finally
+ *               all memberships with each group sized once.
+ */
+Manifest::Contents Manifest::parse(std::string_view text)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    ManifestParser parser;
+    parser.parse(text);
+
+    Contents contents;
+
+    // Groups, declared ones first so their order is kept
+    std::unordered_map<std::string_view, std::uint32_t> groupIndices;
+    groupIndices.reserve(parser.groups.size());
+    for (const GroupRow& row : parser.groups)
+    {
+        if (groupIndices.count(row.name))
+            ManifestParser::fail(row.line, "group '" + std::string(row.name) + "' declared twice");
+        groupIndex(row.name, groupIndices, contents.groups);
+    }
+
+    std::vector<std::uint32_t> parents;
+    for (const GroupRow& row : parser.groups)
+    {
+        const std::uint32_t child = groupIndices.at(row.name);
+        const std::uint32_t parent = row.parent.empty() ? NO_PARENT : groupIndex(row.parent, groupIndices, contents.groups);
+        parents.resize(contents.groups.size(), NO_PARENT);
+        parents[child] = parent;
+    }
+    parents.resize(contents.groups.size(), NO_PARENT);
+
+    // A parent chain longer than the number of groups loops
+    for (const GroupRow& row : parser.groups)
+    {
+        std::uint32_t group = groupIndices.at(row.name);
+        for (std::size_t depth = 0; group != NO_PARENT; ++depth)
+        {
+            if (depth > parents.size())
+                ManifestParser::fail(row.line, "group '" + std::string(row.name) + "' is nested in itself");
+            group = parents[group];
+        }
+    }
+
+    std::vector<std::uint32_t> memberGroups(parser.memberships.size());
+    for (std::size_t m = 0; m < parser.memberships.size(); ++m)
+        memberGroups[m] = groupIndex(parser.memberships[m], groupIndices, contents.groups);
+    parents.resize(contents.groups.size(), NO_PARENT);
+
+    // Devices, one factory call per run of rows with the same model and type
+    const Factory::DeviceFactory& factory = Factory::DeviceFactory::getInstance();
+    std::unordered_set<std::string_view> seenIds;
+    seenIds.reserve(parser.devices.size());
+    contents.devices.reserve(parser.devices.size());
+
+    std::vector<std::string> ids;
+    for (std::size_t first = 0; first < parser.devices.size();)
+    {
+        const DeviceRow& head = parser.devices[first];
+        if (!factory.isRegistered(head.model))
+            ManifestParser::fail(head.line, "unknown device model '" + std::string(head.model) + "'");
+
+        std::size_t last = first;
+        ids.clear();
+        while (last < parser.devices.size() && parser.devices[last].model == head.model && parser.devices[last].type == head.type)
+        {
+            const DeviceRow& row = parser.devices[last];
+            if (!seenIds.insert(row.id).second)
+                ManifestParser::fail(row.line, "device '" + std::string(row.id) + "' listed twice");
+            ids.emplace_back(row.id);
+            ++last;
+        }
+
+        auto batch = factory.createDevices(head.model, ids, std::string(head.type));
+        for (auto& device : batch)
+            contents.devices.push_back(std::move(device));
+        first = last;
+    }
+
+    // Initial state; power first, since switching it resets the rest
+    for (std::size_t d = 0; d < parser.devices.size(); ++d)
+    {
+        const DeviceRow& row = parser.devices[d];
+        IDevice& device = *contents.devices[d];
+        try
+        {
+            for (std::uint32_t s = row.stateBegin; s < row.stateEnd; ++s)
+                if (parser.states[s].code == CommandCode::POWER)
+                    Commands::applyValue(device, CommandCode::POWER, parser.states[s].value);
+            for (std::uint32_t s = row.stateBegin; s < row.stateEnd; ++s)
+                if (parser.states[s].code != CommandCode::POWER)
+                    Commands::applyValue(device, parser.states[s].code, parser.states[s].value);
+        }
+        catch (const std::invalid_argument&)
+        {
+            ManifestParser::fail(row.line, "device '" + std::string(row.id) + "' of model '"
+                                 + std::string(row.model) + "' does not support its initial state");
+        }
+        contents.stats.stateWrites += row.stateEnd - row.stateBegin;
+    }
+
+    // Memberships, each group sized once
+    std::vector<std::size_t> sizes(contents.groups.size(), 0);
+    for (const std::uint32_t group : memberGroups)
+        ++sizes[group];
+    for (const std::uint32_t parent : parents)
+        if (parent != NO_PARENT)
+            ++sizes[parent];
+    for (std::size_t g = 0; g < contents.groups.size(); ++g)
+        contents.groups[g]->reserve(sizes[g]);
+
+    for (std::size_t d = 0; d < parser.devices.size(); ++d)
+    {
+        const DeviceRow& row = parser.devices[d];
+        for (std::uint32_t m = row.groupsBegin; m < row.groupsEnd; ++m)
+            contents.stats.memberships += contents.groups[memberGroups[m]]->addDevice(contents.devices[d]) ? 1 : 0;
+    }
+    for (std::size_t g = 0; g < parents.size(); ++g)
+        if (parents[g] != NO_PARENT)
+            contents.stats.memberships += contents.groups[parents[g]]->addDevice(contents.groups[g]) ? 1 : 0;
+
+    contents.stats.lines = parser.lines;
+    contents.stats.devices = contents.devices.size();
+    contents.stats.groups = contents.groups.size();
+    contents.stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return contents;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,75 @@
+/******************************************************************************
+ *  MODULE NAME  : Persistence Implementation
+ *  FILE         : MappedFile.cpp
+ *  DESCRIPTION  : Implements the MappedFile: mmap on POSIX, a plain read on
+ *                 Windows.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Persistence/MappedFile.hpp"
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using SmartHome::Persistence::MappedFile;
+
+MappedFile::MappedFile(const std::string& path, std::string_view reader)
+{
+    const std::string prefix = std::string(reader) + ": ";
+#if defined(_WIN32)
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+        throw std::runtime_error(prefix + "cannot open " + path);
+    _buffer.resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read(_buffer.data(), static_cast<std::streamsize>(_buffer.size())))
+        throw std::runtime_error(prefix + "cannot read " + path);
+    _data = _buffer.data();
+    _size = _buffer.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error(prefix + "cannot open " + path);
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error(prefix + "cannot stat " + path);
+    }
+
+    _size = static_cast<std::size_t>(info.st_size);
+    if (_size > 0)
+    {
+        void* mapped = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED)
+        {
+            ::close(fd);
+            throw std::runtime_error(prefix + "cannot map " + path);
+        }
+        _data = static_cast<const char*>(mapped);
+    }
+    ::close(fd);    // The mapping keeps the file alive
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(_WIN32)
+    if (_data)
+        ::munmap(const_cast<char*>(_data), _size);
+#endif
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
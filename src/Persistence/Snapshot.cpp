@@ -0,0 +1,707 @@
+/******************************************************************************
+ *  MODULE NAME  : Persistence Implementation
+ *  FILE         : Snapshot.cpp
+ *  DESCRIPTION  : Implements the Snapshot: the on-disk record layout, the
+ *                 SnapshotCodec that reads and writes device state, the
+ *                 crash-safe writer and the memory-mapped, validating reader.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Persistence/Snapshot.hpp"
+#include "SmartHome/Persistence/MappedFile.hpp"
+#include "SmartHome/Devices/SupportedDevices.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+using SmartHome::Persistence::MappedFile;
+using SmartHome::Persistence::Snapshot;
+using SmartHome::Core::DeviceType;
+using SmartHome::Core::IDevice;
+using SmartHome::Devices::DeviceGroup;
+
+namespace
+{
+    constexpr char MAGIC[8] = { 'S', 'H', 'S', 'N', 'A', 'P', '0', '1' };
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304u;    // Reads back swapped on a foreign-endian host
+    constexpr std::uint32_t GROUP_MEMBER = 0x80000000u;       // Member index names a group, not a device
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t deviceCount;
+        std::uint32_t groupCount;
+        std::uint32_t memberCount;
+        std::uint32_t secretCount;
+        std::uint64_t devicesOffset;
+        std::uint64_t groupsOffset;
+        std::uint64_t membersOffset;
+        std::uint64_t secretsOffset;
+        std::uint64_t stringsOffset;
+        std::uint64_t stringsSize;
+        std::uint64_t fileSize;
+    };
+
+    struct StringRef
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    /*
+     * Description : Concrete class of a stored device; decides what is built
+     *               on load.
+     */
+    enum class DeviceModel : std::uint8_t
+    {
+        BASE_LIGHT,
+        DIMMABLE_LIGHT,
+        BASE_CAMERA,
+        WIRELESS_CAMERA,
+        BASE_THERMOSTAT,
+        COOLER_THERMOSTAT,
+        HEATER_THERMOSTAT,
+        DOOR_LOCK,
+        MOTION_SENSOR,
+        COUNT
+    };
+
+    enum DeviceFlag : std::uint8_t
+    {
+        FLAG_ON           = 1u << 0,
+        FLAG_LOCKED       = 1u << 1,
+        FLAG_MOTION       = 1u << 2,
+        FLAG_RECORDING    = 1u << 3,
+        FLAG_NIGHT_VISION = 1u << 4,
+        FLAG_CHARGING     = 1u << 5,
+        FLAG_REGISTERED   = 1u << 6     // Was in the saved device list, not only in a group
+    };
+
+    /*
+     * Description : One device, every model in the same fixed-size record.
+     *               Fields a model does not have stay zero.
+     */
+    struct DeviceRecord
+    {
+        StringRef id;
+        StringRef type;
+        StringRef pin;                  // Door lock keypad PIN
+        std::uint32_t secretsBegin;     // Door lock cards, then phone tokens
+        std::uint32_t cardCount;
+        std::uint32_t phoneCount;
+        float targetTemperature;
+        float currentTemperature;
+        std::uint8_t model;
+        std::uint8_t flags;
+        std::uint8_t mode;              // Thermostat mode
+        std::uint8_t lastMode;          // Thermostat mode restored by turnOn
+        std::uint8_t brightness;
+        std::uint8_t battery;
+        std::uint8_t lastAuth;          // Door lock last authentication method
+        std::uint8_t reserved;
+    };
+
+    enum GroupFlag : std::uint32_t
+    {
+        GROUP_LISTED = 1u << 0          // Was in the saved group list, not only nested
+    };
+
+    struct GroupRecord
+    {
+        StringRef name;
+        std::uint32_t membersBegin;
+        std::uint32_t memberCount;
+        std::uint32_t flags;
+    };
+
+    static_assert(sizeof(Header) == 88, "snapshot header layout changed; bump Snapshot::VERSION");
+    static_assert(sizeof(StringRef) == 8, "snapshot string layout changed; bump Snapshot::VERSION");
+    static_assert(sizeof(DeviceRecord) == 52, "snapshot device layout changed; bump Snapshot::VERSION");
+    static_assert(sizeof(GroupRecord) == 20, "snapshot group layout changed; bump Snapshot::VERSION");
+    static_assert(std::is_trivially_copyable<DeviceRecord>::value
+               && std::is_trivially_copyable<GroupRecord>::value, "records are read in place");
+
+    /*
+     * Description : Appends strings to the pool; type names and PINs repeat
+     *               across thousands of devices and are stored once.
+     */
+    class StringPool
+    {
+    public:
+        StringRef add(const std::string& text)
+        {
+            const StringRef ref{ static_cast<std::uint32_t>(_bytes.size()),
+                                 static_cast<std::uint32_t>(text.size()) };
+            _bytes.append(text);
+            return ref;
+        }
+
+        StringRef addShared(const std::string& text)
+        {
+            auto it = _shared.find(text);
+            if (it != _shared.end())
+                return it->second;
+            return _shared.emplace(text, add(text)).first->second;
+        }
+
+        const std::string& bytes() const { return _bytes; }
+
+    private:
+        std::string _bytes;
+        std::unordered_map<std::string, StringRef> _shared;
+    };
+
+    [[noreturn]] void corrupt(const std::string& what)
+    {
+        throw std::runtime_error("snapshot: corrupt file (" + what + ")");
+    }
+
+    /*
+     * Description : True if some group contains itself, directly or through
+     *               nested groups. Member indices must already be in range.
+     *               Iterative depth-first search, so a deep chain in a
+     *               damaged file cannot overflow the stack either.
+     */
+    bool hasGroupCycle(const GroupRecord* groups, std::uint32_t groupCount, const std::uint32_t* members)
+    {
+        enum : std::uint8_t { UNSEEN, ON_PATH, DONE };
+        std::vector<std::uint8_t> state(groupCount, UNSEEN);
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> path;   // (group, next member)
+
+        for (std::uint32_t root = 0; root < groupCount; ++root)
+        {
+            if (state[root] != UNSEEN)
+                continue;
+            state[root] = ON_PATH;
+            path.emplace_back(root, 0);
+
+            while (!path.empty())
+            {
+                auto& [group, next] = path.back();
+                if (next == groups[group].memberCount)
+                {
+                    state[group] = DONE;
+                    path.pop_back();
+                    continue;
+                }
+
+                const std::uint32_t member = members[groups[group].membersBegin + next++];
+                if (!(member & GROUP_MEMBER))
+                    continue;
+                const std::uint32_t child = member & ~GROUP_MEMBER;
+                if (state[child] == ON_PATH)
+                    return true;
+                if (state[child] == UNSEEN)
+                {
+                    state[child] = ON_PATH;
+                    path.emplace_back(child, 0);
+                }
+            }
+        }
+        return false;
+    }
+
+    /*
+     * Description : True if 'count' records of 'size' bytes fit in the file
+     *               at 'offset'. Written to rule out overflow.
+     */
+    bool fits(std::uint64_t offset, std::uint64_t count, std::uint64_t size, std::uint64_t fileSize)
+    {
+        return offset <= fileSize && offset % alignof(std::uint32_t) == 0
+            && count <= (fileSize - offset) / size;
+    }
+}
+
+namespace SmartHome::Persistence
+{
+    /******************************************************************************
+     *  CLASS NAME   : SnapshotCodec
+     *  DESCRIPTION  : Moves device state between objects and records. Friend
+     *                 of the device classes: restoring writes state directly,
+     *                 so a load neither publishes events nor runs side effects.
+     ******************************************************************************/
+    class SnapshotCodec
+    {
+    public:
+        using Lights = Devices::Lights::BaseLight;
+        using Camera = Devices::Cameras::BaseCamera;
+        using Wireless = Devices::Cameras::WirelessCamera;
+        using Thermostat = Devices::Thermostats::BaseThermostat;
+        using Lock = Devices::DoorLock;
+        using Motion = Devices::Sensors::MotionSensor;
+
+        /*
+         * Description : Fills 'record' from 'device'. The concrete class is
+         *               matched exactly, so a subclass this codec does not
+         *               know is refused instead of silently sliced.
+         */
+        static void encode(const IDevice& device, DeviceRecord& record,
+                           std::vector<StringRef>& secrets, StringPool& strings)
+        {
+            const std::type_info& model = typeid(device);
+
+            switch (device.getType())
+            {
+                case DeviceType::LIGHT:
+                {
+                    const auto& light = static_cast<const Lights&>(device);
+                    if (model == typeid(Devices::Lights::DimmableLight))
+                        record.model = static_cast<std::uint8_t>(DeviceModel::DIMMABLE_LIGHT);
+                    else if (model == typeid(Lights))
+                        record.model = static_cast<std::uint8_t>(DeviceModel::BASE_LIGHT);
+                    else
+                        break;
+                    record.id = strings.add(light._id);
+                    record.type = strings.addShared(light._type);
+                    record.flags |= light._store.isOn() ? FLAG_ON : 0;
+                    record.brightness = static_cast<std::uint8_t>(light._store.brightness());
+                    return;
+                }
+
+                case DeviceType::CAMERA:
+                {
+                    const auto& camera = static_cast<const Camera&>(device);
+                    if (model == typeid(Wireless))
+                    {
+                        const auto& wireless = static_cast<const Wireless&>(device);
+                        record.model = static_cast<std::uint8_t>(DeviceModel::WIRELESS_CAMERA);
+                        record.flags |= wireless._isCharging ? FLAG_CHARGING : 0;
+                        record.battery = static_cast<std::uint8_t>(wireless._batteryPercentage);
+                    }
+                    else if (model == typeid(Camera))
+                        record.model = static_cast<std::uint8_t>(DeviceModel::BASE_CAMERA);
+                    else
+                        break;
+                    record.id = strings.add(camera._id);
+                    record.type = strings.addShared(camera._type);
+                    record.flags |= camera._store.isOn() ? FLAG_ON : 0;
+                    record.flags |= camera._store.isRecording() ? FLAG_RECORDING : 0;
+                    record.flags |= camera._store.isNightVision() ? FLAG_NIGHT_VISION : 0;
+                    return;
+                }
+
+                case DeviceType::THERMOSTAT:
+                {
+                    const auto& thermostat = static_cast<const Thermostat&>(device);
+                    if (model == typeid(Devices::Thermostats::CoolerThermostat))
+                        record.model = static_cast<std::uint8_t>(DeviceModel::COOLER_THERMOSTAT);
+                    else if (model == typeid(Devices::Thermostats::HeaterThermostat))
+                        record.model = static_cast<std::uint8_t>(DeviceModel::HEATER_THERMOSTAT);
+                    else if (model == typeid(Thermostat))
+                        record.model = static_cast<std::uint8_t>(DeviceModel::BASE_THERMOSTAT);
+                    else
+                        break;
+                    record.id = strings.add(thermostat._id);
+                    record.type = strings.addShared(thermostat._type);
+                    record.flags |= thermostat._store.isOn() ? FLAG_ON : 0;
+                    record.targetTemperature = thermostat._store.targetTemperature();
+                    record.currentTemperature = thermostat._store.currentTemperature();
+                    record.mode = static_cast<std::uint8_t>(thermostat._mode);
+                    record.lastMode = static_cast<std::uint8_t>(thermostat._lastModeUsed);
+                    return;
+                }
+
+                case DeviceType::DOOR_LOCK:
+                {
+                    if (model != typeid(Lock))
+                        break;
+                    const auto& lock = static_cast<const Lock&>(device);
+                    record.model = static_cast<std::uint8_t>(DeviceModel::DOOR_LOCK);
+                    record.id = strings.add(lock._id);
+                    record.type = strings.addShared(lock._type);
+                    record.pin = strings.addShared(lock._pinCode);
+                    record.flags |= lock._store.isOn() ? FLAG_ON : 0;
+                    record.flags |= lock._store.isLocked() ? FLAG_LOCKED : 0;
+                    record.lastAuth = static_cast<std::uint8_t>(lock._lastAuthMethod);
+
+                    record.secretsBegin = static_cast<std::uint32_t>(secrets.size());
+                    record.cardCount = static_cast<std::uint32_t>(lock._authorizedCards.size());
+                    record.phoneCount = static_cast<std::uint32_t>(lock._authorizedPhones.size());
+                    for (const std::string& card : lock._authorizedCards)
+                        secrets.push_back(strings.add(card));
+                    for (const std::string& phone : lock._authorizedPhones)
+                        secrets.push_back(strings.add(phone));
+                    return;
+                }
+
+                case DeviceType::MOTION_SENSOR:
+                {
+                    if (model != typeid(Motion))
+                        break;
+                    const auto& sensor = static_cast<const Motion&>(device);
+                    record.model = static_cast<std::uint8_t>(DeviceModel::MOTION_SENSOR);
+                    record.id = strings.add(sensor._id);
+                    record.flags |= sensor._store.isOn() ? FLAG_ON : 0;
+                    record.flags |= sensor._store.isMotionDetected() ? FLAG_MOTION : 0;
+                    return;
+                }
+
+                default:
+                    break;
+            }
+
+            throw std::invalid_argument("snapshot: cannot store device '" + device.getID()
+                                        + "' of unsupported class " + model.name());
+        }
+
+        /*
+         * Description : Builds the device a record describes. 'text' resolves
+         *               string references already checked by the caller.
+         */
+        template <typename Text>
+        static std::shared_ptr<IDevice> decode(const DeviceRecord& record, const StringRef* secrets, Text text)
+        {
+            const bool on = (record.flags & FLAG_ON) != 0;
+
+            switch (static_cast<DeviceModel>(record.model))
+            {
+                case DeviceModel::BASE_LIGHT:
+                case DeviceModel::DIMMABLE_LIGHT:
+                {
+                    std::shared_ptr<Lights> light;
+                    if (static_cast<DeviceModel>(record.model) == DeviceModel::DIMMABLE_LIGHT)
+                        light = std::make_shared<Devices::Lights::DimmableLight>(text(record.id), text(record.type));
+                    else
+                        light = std::make_shared<Lights>(text(record.id), text(record.type));
+                    light->_store.setOn(on);
+                    light->_store.setBrightness(record.brightness);
+                    return light;
+                }
+
+                case DeviceModel::BASE_CAMERA:
+                case DeviceModel::WIRELESS_CAMERA:
+                {
+                    std::shared_ptr<Camera> camera;
+                    if (static_cast<DeviceModel>(record.model) == DeviceModel::WIRELESS_CAMERA)
+                        camera = std::make_shared<Wireless>(text(record.id), text(record.type), record.battery,
+                                                            (record.flags & FLAG_CHARGING) != 0);
+                    else
+                        camera = std::make_shared<Camera>(text(record.id), text(record.type));
+                    camera->_store.setOn(on);
+                    camera->_store.setRecording((record.flags & FLAG_RECORDING) != 0);
+                    camera->_store.setNightVision((record.flags & FLAG_NIGHT_VISION) != 0);
+                    return camera;
+                }
+
+                case DeviceModel::BASE_THERMOSTAT:
+                case DeviceModel::COOLER_THERMOSTAT:
+                case DeviceModel::HEATER_THERMOSTAT:
+                {
+                    std::shared_ptr<Thermostat> thermostat;
+                    if (static_cast<DeviceModel>(record.model) == DeviceModel::COOLER_THERMOSTAT)
+                        thermostat = std::make_shared<Devices::Thermostats::CoolerThermostat>(text(record.id), text(record.type));
+                    else if (static_cast<DeviceModel>(record.model) == DeviceModel::HEATER_THERMOSTAT)
+                        thermostat = std::make_shared<Devices::Thermostats::HeaterThermostat>(text(record.id), text(record.type));
+                    else
+                        thermostat = std::make_shared<Thermostat>(text(record.id), text(record.type));
+                    thermostat->_store.setOn(on);
+                    thermostat->_store.setTargetTemperature(record.targetTemperature);
+                    thermostat->_store.setCurrentTemperature(record.currentTemperature);
+                    thermostat->_mode = static_cast<Thermostat::ThermostatMode>(record.mode);
+                    thermostat->_lastModeUsed = static_cast<Thermostat::ThermostatMode>(record.lastMode);
+                    return thermostat;
+                }
+
+                case DeviceModel::DOOR_LOCK:
+                {
+                    auto lock = std::make_shared<Lock>(text(record.id), text(record.type));
+                    lock->_store.setOn(on);
+                    lock->_store.setLocked((record.flags & FLAG_LOCKED) != 0);
+                    lock->_pinCode = text(record.pin);
+                    lock->_lastAuthMethod = static_cast<Lock::AuthMethod>(record.lastAuth);
+
+                    const StringRef* secret = secrets + record.secretsBegin;
+                    lock->_authorizedCards.reserve(record.cardCount);
+                    for (std::uint32_t i = 0; i < record.cardCount; ++i)
+                        lock->_authorizedCards.insert(text(*secret++));
+                    lock->_authorizedPhones.reserve(record.phoneCount);
+                    for (std::uint32_t i = 0; i < record.phoneCount; ++i)
+                        lock->_authorizedPhones.insert(text(*secret++));
+                    return lock;
+                }
+
+                case DeviceModel::MOTION_SENSOR:
+                {
+                    auto sensor = std::make_shared<Motion>(text(record.id));
+                    sensor->_store.setOn(on);
+                    sensor->_store.setMotionDetected((record.flags & FLAG_MOTION) != 0);
+                    return sensor;
+                }
+
+                default:
+                    break;
+            }
+            corrupt("unknown device model");
+        }
+
+        /*
+         * Description : Range checks a record before decode() trusts it.
+         */
+        static bool isValid(const DeviceRecord& record)
+        {
+            if (record.model >= static_cast<std::uint8_t>(DeviceModel::COUNT))
+                return false;
+            switch (static_cast<DeviceModel>(record.model))
+            {
+                case DeviceModel::BASE_THERMOSTAT:
+                case DeviceModel::COOLER_THERMOSTAT:
+                case DeviceModel::HEATER_THERMOSTAT:
+                    return record.mode <= static_cast<std::uint8_t>(Thermostat::ThermostatMode::OFF)
+                        && record.lastMode <= static_cast<std::uint8_t>(Thermostat::ThermostatMode::OFF);
+                case DeviceModel::DOOR_LOCK:
+                    return record.lastAuth <= static_cast<std::uint8_t>(Lock::AuthMethod::PHONE);
+                default:
+                    return true;
+            }
+        }
+    };
+}
+
+using SmartHome::Persistence::SnapshotCodec;
+
+/*
+ * Description : Numbers the devices and groups (registered ones first, then
+ *               anything reachable only through a group), encodes them and
+ *               writes the sections back to back.
+ */
+void Snapshot::save(const std::string& path,
+                    const std::vector<std::shared_ptr<IDevice>>& devices,
+                    const std::vector<std::shared_ptr<DeviceGroup>>& groups)
+{
+    std::vector<const IDevice*> deviceOrder;
+    std::vector<const DeviceGroup*> groupOrder;
+    std::unordered_map<const IDevice*, std::uint32_t> deviceIndex;
+    std::unordered_map<const DeviceGroup*, std::uint32_t> groupIndex;
+
+    auto numberDevice = [&](const IDevice* device)
+    {
+        auto inserted = deviceIndex.emplace(device, static_cast<std::uint32_t>(deviceOrder.size()));
+        if (inserted.second)
+            deviceOrder.push_back(device);
+        return inserted.first->second;
+    };
+    auto numberGroup = [&](const DeviceGroup* group)
+    {
+        auto inserted = groupIndex.emplace(group, static_cast<std::uint32_t>(groupOrder.size()));
+        if (inserted.second)
+            groupOrder.push_back(group);
+        return inserted.first->second;
+    };
+
+    deviceIndex.reserve(devices.size());
+    deviceOrder.reserve(devices.size());
+    for (const auto& device : devices)
+        if (device)
+            numberDevice(device.get());
+    const std::size_t registeredCount = deviceOrder.size();
+
+    for (const auto& group : groups)
+        if (group)
+            numberGroup(group.get());
+    const std::size_t listedCount = groupOrder.size();
+
+    // Groups are numbered as they are found, so nested ones join the walk
+    StringPool strings;
+    std::vector<GroupRecord> groupRecords;
+    std::vector<std::uint32_t> members;
+    for (std::size_t g = 0; g < groupOrder.size(); ++g)
+    {
+        const DeviceGroup& group = *groupOrder[g];
+        GroupRecord record{};
+        record.name = strings.add(group.getID());
+        record.membersBegin = static_cast<std::uint32_t>(members.size());
+        record.flags = g < listedCount ? static_cast<std::uint32_t>(GROUP_LISTED) : 0u;
+
+        for (const auto& entry : group.getDevices())
+        {
+            const IDevice* member = entry.second.get();
+            if (member->getType() == DeviceType::GROUP)
+                members.push_back(GROUP_MEMBER | numberGroup(static_cast<const DeviceGroup*>(member)));
+            else
+                members.push_back(numberDevice(member));
+        }
+        record.memberCount = static_cast<std::uint32_t>(members.size()) - record.membersBegin;
+        groupRecords.push_back(record);
+    }
+
+    if (deviceOrder.size() >= GROUP_MEMBER || groupOrder.size() >= GROUP_MEMBER)
+        throw std::invalid_argument("snapshot: too many devices");
+
+    std::vector<DeviceRecord> deviceRecords(deviceOrder.size());
+    std::vector<StringRef> secrets;
+    for (std::size_t d = 0; d < deviceOrder.size(); ++d)
+    {
+        SnapshotCodec::encode(*deviceOrder[d], deviceRecords[d], secrets, strings);
+        if (d < registeredCount)
+            deviceRecords[d].flags |= FLAG_REGISTERED;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.deviceCount = static_cast<std::uint32_t>(deviceRecords.size());
+    header.groupCount = static_cast<std::uint32_t>(groupRecords.size());
+    header.memberCount = static_cast<std::uint32_t>(members.size());
+    header.secretCount = static_cast<std::uint32_t>(secrets.size());
+    header.devicesOffset = sizeof(Header);
+    header.groupsOffset = header.devicesOffset + deviceRecords.size() * sizeof(DeviceRecord);
+    header.membersOffset = header.groupsOffset + groupRecords.size() * sizeof(GroupRecord);
+    header.secretsOffset = header.membersOffset + members.size() * sizeof(std::uint32_t);
+    header.stringsOffset = header.secretsOffset + secrets.size() * sizeof(StringRef);
+    header.stringsSize = strings.bytes().size();
+    header.fileSize = header.stringsOffset + header.stringsSize;
+
+    const std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file)
+        throw std::runtime_error("snapshot: cannot create " + temporary);
+
+    auto write = [file](const void* data, std::size_t bytes)
+    {
+        return bytes == 0 || std::fwrite(data, 1, bytes, file) == bytes;
+    };
+
+    bool written = write(&header, sizeof(header))
+                && write(deviceRecords.data(), deviceRecords.size() * sizeof(DeviceRecord))
+                && write(groupRecords.data(), groupRecords.size() * sizeof(GroupRecord))
+                && write(members.data(), members.size() * sizeof(std::uint32_t))
+                && write(secrets.data(), secrets.size() * sizeof(StringRef))
+                && write(strings.bytes().data(), strings.bytes().size())
+                && std::fflush(file) == 0;
+#if !defined(_WIN32)
+    written = written && ::fsync(::fileno(file)) == 0;   // Data on disk before the rename publishes it
+#endif
+    written = (std::fclose(file) == 0) && written;
+
+#if defined(_WIN32)
+    std::remove(path.c_str());    // rename() does not replace on Windows
+#endif
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("snapshot: cannot write " + path);
+    }
+}
+
+/*
+ * Description : Validates the header and every cross-reference up front,
+ *               then builds objects straight from the mapped records.
+ */
+Snapshot::Contents Snapshot::load(const std::string& path)
+{
+    const MappedFile file(path, "snapshot");
+    const char* base = file.data();
+
+    Header header;
+    if (file.size() < sizeof(Header))
+        corrupt("truncated header");
+    std::memcpy(&header, base, sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error("snapshot: " + path + " is not a snapshot file");
+    if (header.byteOrder != BYTE_ORDER_MARK)
+        throw std::runtime_error("snapshot: " + path + " was written on a host of different byte order");
+    if (header.version != VERSION)
+        throw std::runtime_error("snapshot: " + path + " has unsupported version " + std::to_string(header.version));
+
+    const std::uint64_t size = file.size();
+    if (header.fileSize != size)
+        corrupt("size mismatch");
+    if (!fits(header.devicesOffset, header.deviceCount, sizeof(DeviceRecord), size)
+     || !fits(header.groupsOffset, header.groupCount, sizeof(GroupRecord), size)
+     || !fits(header.membersOffset, header.memberCount, sizeof(std::uint32_t), size)
+     || !fits(header.secretsOffset, header.secretCount, sizeof(StringRef), size)
+     || !fits(header.stringsOffset, header.stringsSize, 1, size))
+        corrupt("section out of bounds");
+
+    // Sections are 4-byte aligned in a page-aligned mapping: read in place
+    const auto* devices = reinterpret_cast<const DeviceRecord*>(base + header.devicesOffset);
+    const auto* groups = reinterpret_cast<const GroupRecord*>(base + header.groupsOffset);
+    const auto* members = reinterpret_cast<const std::uint32_t*>(base + header.membersOffset);
+    const auto* secrets = reinterpret_cast<const StringRef*>(base + header.secretsOffset);
+    const char* strings = base + header.stringsOffset;
+
+    auto validString = [&header](const StringRef& ref)
+    {
+        return ref.offset <= header.stringsSize && ref.length <= header.stringsSize - ref.offset;
+    };
+    auto text = [strings](const StringRef& ref)
+    {
+        return std::string(strings + ref.offset, ref.length);
+    };
+
+    for (std::uint32_t i = 0; i < header.secretCount; ++i)
+        if (!validString(secrets[i]))
+            corrupt("secret string");
+
+    std::vector<std::shared_ptr<IDevice>> built(header.deviceCount);
+    Contents contents;
+    contents.devices.reserve(header.deviceCount);
+    for (std::uint32_t d = 0; d < header.deviceCount; ++d)
+    {
+        const DeviceRecord& record = devices[d];
+        const std::uint64_t secretEnd = std::uint64_t{record.secretsBegin} + record.cardCount + record.phoneCount;
+        if (!SnapshotCodec::isValid(record) || !validString(record.id) || !validString(record.type)
+         || !validString(record.pin) || secretEnd > header.secretCount)
+            corrupt("device record " + std::to_string(d));
+
+        built[d] = SnapshotCodec::decode(record, secrets, text);
+        if (record.flags & FLAG_REGISTERED)
+            contents.devices.push_back(built[d]);
+    }
+
+    std::vector<std::shared_ptr<DeviceGroup>> builtGroups(header.groupCount);
+    for (std::uint32_t g = 0; g < header.groupCount; ++g)
+    {
+        const GroupRecord& record = groups[g];
+        if (!validString(record.name)
+         || std::uint64_t{record.membersBegin} + record.memberCount > header.memberCount)
+            corrupt("group record " + std::to_string(g));
+        builtGroups[g] = std::make_shared<DeviceGroup>(text(record.name));
+    }
+
+    for (std::uint32_t i = 0; i < header.memberCount; ++i)
+    {
+        const std::uint32_t index = members[i] & ~GROUP_MEMBER;
+        if ((members[i] & GROUP_MEMBER) ? index >= header.groupCount : index >= header.deviceCount)
+            corrupt("group member");
+    }
+    if (hasGroupCycle(groups, header.groupCount, members))
+        corrupt("group cycle");
+
+    for (std::uint32_t g = 0; g < header.groupCount; ++g)
+    {
+        const GroupRecord& record = groups[g];
+        DeviceGroup& group = *builtGroups[g];
+        for (std::uint32_t m = 0; m < record.memberCount; ++m)
+        {
+            const std::uint32_t member = members[record.membersBegin + m];
+            const std::uint32_t index = member & ~GROUP_MEMBER;
+            if (member & GROUP_MEMBER)
+                group.addDevice(builtGroups[index]);
+            else
+                group.addDevice(built[index]);
+        }
+        if (record.flags & GROUP_LISTED)
+            contents.groups.push_back(builtGroups[g]);
+    }
+
+    return contents;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
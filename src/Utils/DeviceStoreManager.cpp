@@ -0,0 +1,166 @@
+/******************************************************************************
+ *  MODULE NAME  : Device State Store Implementation
+ *  FILE         : DeviceStoreManager.cpp
+ *  DESCRIPTION  : Implements row allocation, release and the column scans of
+ *                 the DeviceStoreManager.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Utils/DeviceStoreManager.hpp"
+
+#include <stdexcept>
+
+using SmartHome::Utils::DeviceStoreManager;
+using SmartHome::Core::IDevice;
+
+/*
+ * Description : Returns the singleton instance of DeviceStoreManager.
+ */
+DeviceStoreManager& DeviceStoreManager::getInstance()
+{
+    static DeviceStoreManager instance;
+    return instance;
+}
+
+/*
+ * Description : Frees every page.
+ */
+DeviceStoreManager::~DeviceStoreManager()
+{
+    for (auto& page : _pages)
+        delete page.load();
+}
+
+/*
+ * Description : Claims a row in the store for 'owner'.
+ */
+DeviceStoreManager::Row::Row(IDevice* owner)
+{
+    _page = DeviceStoreManager::getInstance().allocate(owner->getType(), owner, _index);
+    _slot = _index & (PAGE_ROWS - 1);
+}
+
+/*
+ * Description : Returns the row to the store.
+ */
+DeviceStoreManager::Row::~Row()
+{
+    DeviceStoreManager::getInstance().release(_index);
+}
+
+/*
+ * Description : Reuses a released row when possible; otherwise takes the
+ *               next row, adding a page when the last one is full. A new
+ *               row starts with every flag cleared and zeroed values.
+ */
+DeviceStoreManager::Page* DeviceStoreManager::allocate(DeviceKind kind, IDevice* owner, std::uint32_t& index)
+{
+    std::lock_guard<std::mutex> lock(_allocMutex);
+
+    if (!_freeRows.empty())
+    {
+        index = _freeRows.back();
+        _freeRows.pop_back();
+    }
+    else
+    {
+        if (_nextIndex == MAX_PAGES * PAGE_ROWS)
+            throw std::length_error("DeviceStoreManager: device capacity exhausted");
+
+        index = _nextIndex++;
+        if ((index & (PAGE_ROWS - 1)) == 0)
+        {
+            _pages[index >> PAGE_BITS].store(new Page(), std::memory_order_release);
+            _pageCount.store((index >> PAGE_BITS) + 1, std::memory_order_release);
+        }
+    }
+
+    Page* page = _pages[index >> PAGE_BITS].load(std::memory_order_relaxed);
+    const std::size_t slot = index & (PAGE_ROWS - 1);
+
+    page->brightness[slot].store(0, std::memory_order_relaxed);
+    page->targetTemperature[slot].store(0.0f, std::memory_order_relaxed);
+    page->currentTemperature[slot].store(0.0f, std::memory_order_relaxed);
+    page->owner[slot].store(owner, std::memory_order_relaxed);
+    page->kinds[static_cast<std::size_t>(kind)][slot >> 6]
+        .fetch_or(std::uint64_t{1} << (slot & 63), std::memory_order_release);
+
+    ++_liveRows;
+    return page;
+}
+
+/*
+ * Description : Drops the row from every kind and flag bitmap so scans skip
+ *               it, then makes it available again.
+ */
+void DeviceStoreManager::release(std::uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(_allocMutex);
+
+    Page* page = _pages[index >> PAGE_BITS].load(std::memory_order_relaxed);
+    const std::size_t slot = index & (PAGE_ROWS - 1);
+    const std::uint64_t keep = ~(std::uint64_t{1} << (slot & 63));
+
+    for (auto& column : page->kinds)
+        column[slot >> 6].fetch_and(keep, std::memory_order_relaxed);
+    for (auto& column : page->flags)
+        column[slot >> 6].fetch_and(keep, std::memory_order_relaxed);
+    page->owner[slot].store(nullptr, std::memory_order_relaxed);
+
+    _freeRows.push_back(index);
+    --_liveRows;
+}
+
+/*
+ * Description : Popcount over (kind & flag) words; no device is touched.
+ */
+std::size_t DeviceStoreManager::count(DeviceKind kind, Flag flag, bool value) const
+{
+    const std::size_t pages = _pageCount.load(std::memory_order_acquire);
+    const std::size_t k = static_cast<std::size_t>(kind);
+    const std::size_t f = static_cast<std::size_t>(flag);
+
+    std::size_t total = 0;
+    for (std::size_t p = 0; p < pages; ++p)
+    {
+        const Page& page = *_pages[p].load(std::memory_order_acquire);
+        for (std::size_t w = 0; w < PAGE_WORDS; ++w)
+        {
+            const std::uint64_t bits = page.flags[f][w].load(std::memory_order_relaxed);
+            total += static_cast<std::size_t>(__builtin_popcountll(
+                page.kinds[k][w].load(std::memory_order_relaxed) & (value ? bits : ~bits)));
+        }
+    }
+    return total;
+}
+
+/*
+ * Description : Sums the brightness column over lights that are on.
+ */
+double DeviceStoreManager::averageBrightnessOn() const
+{
+    std::size_t lights = 0;
+    std::uint64_t sum = 0;
+
+    scan(DeviceKind::LIGHT, Flag::ON, true, [&](const Page& page, std::size_t slot)
+    {
+        sum += page.brightness[slot].load(std::memory_order_relaxed);
+        ++lights;
+    });
+
+    return lights ? static_cast<double>(sum) / lights : 0.0;
+}
+
+/*
+ * Description : Number of rows currently held by devices.
+ */
+std::size_t DeviceStoreManager::liveCount() const
+{
+    std::lock_guard<std::mutex> lock(_allocMutex);
+    return _liveRows;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
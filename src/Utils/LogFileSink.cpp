@@ -0,0 +1,96 @@
+/******************************************************************************
+ *  MODULE NAME  : Log File Sink
+ *  FILE         : LogFileSink.cpp
+ *  DESCRIPTION  : Implements the append-only, rotating NDJSON log writer.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Utils/LogFileSink.hpp"
+#include <filesystem>
+#include <system_error>
+
+using namespace SmartHome::Utils;
+
+namespace fs = std::filesystem;
+
+/*
+ * Description : Opens the active file, continuing an existing one if present.
+ */
+LogFileSink::LogFileSink(LogStreamConfig config)
+    : _config(std::move(config))
+{
+    open();
+}
+
+/*
+ * Description : Appends one entry, rotating first when a limit is reached.
+ */
+void LogFileSink::append(std::string_view entry)
+{
+    const bool tooLarge = _bytesWritten > 0 && _bytesWritten + entry.size() + 1 > _config.maxFileBytes;
+    const bool tooOld = std::chrono::system_clock::now() - _openedAt >= _config.maxFileAge;
+
+    if (tooLarge || tooOld)
+        rotate();
+
+    _out.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+    _out.put('\n');
+    _bytesWritten += entry.size() + 1;
+}
+
+/*
+ * Description : Pushes buffered bytes to the operating system.
+ */
+void LogFileSink::flush()
+{
+    _out.flush();
+}
+
+const LogStreamConfig& LogFileSink::config() const
+{
+    return _config;
+}
+
+/*
+ * Description : Shifts rotated files up by one, dropping the oldest, then
+ *               moves the active file to ".1" and reopens it empty.
+ */
+void LogFileSink::rotate()
+{
+    _out.close();
+
+    std::error_code ec;
+    const std::string& base = _config.filePath;
+
+    if (_config.maxRotatedFiles == 0)
+    {
+        fs::remove(base, ec);
+    }
+    else
+    {
+        fs::remove(base + "." + std::to_string(_config.maxRotatedFiles), ec);
+        for (std::size_t i = _config.maxRotatedFiles - 1; i >= 1; --i)
+            fs::rename(base + "." + std::to_string(i), base + "." + std::to_string(i + 1), ec);
+        fs::rename(base, base + ".1", ec);
+    }
+
+    open();
+}
+
+/*
+ * Description : Opens the active file in append mode and picks up its size.
+ */
+void LogFileSink::open()
+{
+    std::error_code ec;
+    const auto existing = fs::file_size(_config.filePath, ec);
+    _bytesWritten = ec ? 0 : static_cast<std::size_t>(existing);
+
+    _out.open(_config.filePath, std::ios::out | std::ios::app | std::ios::binary);
+    _openedAt = std::chrono::system_clock::now();
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,146 @@
+/******************************************************************************
+ *  MODULE NAME  : Log Formatter
+ *  FILE         : LogFormatter.cpp
+ *  DESCRIPTION  : Implements JSON rendering of log entries with a cached,
+ *                 second-resolution timestamp.
+ *  AUTHOR       : Hassan Darwish
+ *  DATE CREATED : July 2025
+ ******************************************************************************/
+
+#include "SmartHome/Utils/LogFormatter.hpp"
+#include <cstring>
+#include <ctime>
+
+using namespace SmartHome::Utils;
+
+LogFormatter::LogFormatter()
+{
+    _buffer.reserve(INITIAL_CAPACITY);
+}
+
+/*
+ * Description : Renders { "timestamp": ..., "source": ..., "action": ...
+ *               [, "target": ...] [, "result": ...] } into the buffer,
+ *               escaping every field so each record stays one valid line.
+ */
+std::string_view LogFormatter::format(std::int64_t timestampNs,
+                                      std::string_view source,
+                                      std::string_view action,
+                                      std::string_view target,
+                                      std::string_view result)
+{
+    std::int64_t epochSecond = timestampNs / 1000000000;
+    if (timestampNs < 0 && timestampNs % 1000000000 != 0)
+        --epochSecond;
+
+    if (epochSecond != _cachedSecond)
+        refreshTimestamp(epochSecond);
+
+    _buffer.clear();
+    _buffer.append("{ \"timestamp\": \"");
+    _buffer.append(_timestamp, TIMESTAMP_LENGTH);
+    _buffer.append("\", \"source\": \"");
+    appendEscaped(source);
+    _buffer.append("\", \"action\": \"");
+    appendEscaped(action);
+    _buffer.push_back('"');
+
+    if (!target.empty())
+    {
+        _buffer.append(", \"target\": \"");
+        appendEscaped(target);
+        _buffer.push_back('"');
+    }
+
+    if (!result.empty())
+    {
+        _buffer.append(", \"result\": \"");
+        appendEscaped(result);
+        _buffer.push_back('"');
+    }
+
+    _buffer.append(" }");
+    return _buffer;
+}
+
+/*
+ * Description : Copies runs of plain characters in one append each; only
+ *               '"', '\' and control characters are replaced. Plain text
+ *               is skipped eight bytes at a time. Bytes of UTF-8
+ *               sequences are passed through unchanged.
+ */
+void LogFormatter::appendEscaped(std::string_view text)
+{
+    static constexpr char HEX[] = "0123456789abcdef";
+    constexpr std::uint64_t ONES = 0x0101010101010101ull;
+    constexpr std::uint64_t HIGHS = 0x8080808080808080ull;
+
+    const char* const data = text.data();
+    const std::size_t size = text.size();
+
+    std::size_t plainFrom = 0;
+    std::size_t i = 0;
+    while (i < size)
+    {
+        if (size - i >= sizeof(std::uint64_t))
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+
+            // High bit set for a byte below 0x20, a '"' or a '\' (no false negatives)
+            const std::uint64_t quote = word ^ (ONES * '"');
+            const std::uint64_t slash = word ^ (ONES * '\\');
+            const std::uint64_t special = ((word - ONES * 0x20) | (quote - ONES) | (slash - ONES)) & ~word & HIGHS;
+            if (special == 0)
+            {
+                i += sizeof(word);
+                continue;
+            }
+        }
+
+        const unsigned char c = static_cast<unsigned char>(data[i++]);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        _buffer.append(data + plainFrom, i - 1 - plainFrom);
+        plainFrom = i;
+
+        switch (c)
+        {
+            case '"':  _buffer.append("\\\""); break;
+            case '\\': _buffer.append("\\\\"); break;
+            case '\n': _buffer.append("\\n"); break;
+            case '\r': _buffer.append("\\r"); break;
+            case '\t': _buffer.append("\\t"); break;
+            default:
+            {
+                const char escape[] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF] };
+                _buffer.append(escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    _buffer.append(data + plainFrom, size - plainFrom);
+}
+
+/*
+ * Description : Converts the second to local time once and caches the text.
+ */
+void LogFormatter::refreshTimestamp(std::int64_t epochSecond)
+{
+    const std::time_t timeT = static_cast<std::time_t>(epochSecond);
+    std::tm tm{};
+
+#if defined(_WIN32)
+    localtime_s(&tm, &timeT);
+#else
+    localtime_r(&timeT, &tm);
+#endif
+
+    std::strftime(_timestamp, sizeof(_timestamp), "%Y-%m-%d %H:%M:%S", &tm);
+    _cachedSecond = epochSecond;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -9,12 +9,32 @@
 
 #include "SmartHome/Utils/Logger.hpp"
 #include <chrono>
-#include <ctime>
-#include <sstream>
-#include <iomanip>
 
 using namespace SmartHome::Utils;
 
+namespace
+{
+    /*
+     * Description : Hands the thread's ring back to the pool when the thread exits.
+     */
+    struct RingLease
+    {
+        LogRingBuffer* ring = nullptr;
+
+        ~RingLease()
+        {
+            if (ring)
+                ring->release();
+        }
+    };
+
+    thread_local RingLease tlsLease;
+
+    constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(2);
+
+    constexpr std::size_t ENTRY_RESERVE = 256;  // Initial capacity of each in-memory entry
+}
+
 /*
  * Description : Returns the singleton instance of Logger.
  */
@@ -24,61 +44,82 @@ Logger& Logger::getInstance()
     return instance;
 }
 
+/*
+ * Description : Stops the drain thread and closes the stream so no record is
+ *               lost at shutdown.
+ */
+Logger::~Logger()
+{
+    stopAsync();
+    closeStream();
+}
+
 /*
  * Description : Appends a timestamped log entry to the internal log buffer.
+ *               In asynchronous mode the entry is copied into the calling
+ *               thread's ring and formatted later by the drain thread.
  * Parameters  :
  *   - source : Class or function where the event originated.
  *   - action : Description of the event or behavior.
  *   - target : (Optional) Device or group involved.
  *   - result : (Optional) Result of the action (e.g., "OK", "FAILED").
  */
-void Logger::log(const std::string& source,
-                 const std::string& action,
-                 const std::string& target,
-                 const std::string& result)
+void Logger::log(std::string_view source,
+                 std::string_view action,
+                 std::string_view target,
+                 std::string_view result)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-
-    // Get current time
-    auto now = std::chrono::system_clock::now();
-    auto timeT = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&timeT);
-
-    std::ostringstream logStream;
-    logStream << "{ ";
-    logStream << "\"timestamp\": \"" << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "\", ";
-    logStream << "\"source\": \"" << source << "\", ";
-    logStream << "\"action\": \"" << action << "\"";
+    const auto now = std::chrono::system_clock::now();
+    const std::int64_t timestampNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
 
-    if (!target.empty())
-        logStream << ", \"target\": \"" << target << "\"";
-
-    if (!result.empty())
-        logStream << ", \"result\": \"" << result << "\"";
+    if (_async.load(std::memory_order_acquire))
+    {
+        LogRingBuffer* ring = localRing();
+        LogRecord* record = ring->reserve();
+        if (!record)
+            return; // Ring full: counted as dropped, never block the caller
 
-    logStream << " }";
+        record->timestampNs  = timestampNs;
+        record->sourceLength = LogRecord::store(record->source, LogRecord::SOURCE_CAPACITY, source.data(), source.size());
+        record->actionLength = LogRecord::store(record->action, LogRecord::ACTION_CAPACITY, action.data(), action.size());
+        record->targetLength = LogRecord::store(record->target, LogRecord::TARGET_CAPACITY, target.data(), target.size());
+        record->resultLength = LogRecord::store(record->result, LogRecord::RESULT_CAPACITY, result.data(), result.size());
+        ring->commit();
+        return;
+    }
 
-    _entries.push_back(logStream.str());
+    std::lock_guard<std::mutex> lock(_mutex);
+    appendEntry(_formatter.format(timestampNs, source, action, target, result));
 }
 
 /*
- * Description : Saves all buffered log entries to a file.
+ * Description : Saves the in-memory log entries to a file, oldest first.
  * Parameters  :
  *   - filePath : Target file path (default = "logs.json").
  */
 void Logger::flush(const std::string& filePath)
 {
+    drainRings();
+
     std::lock_guard<std::mutex> lock(_mutex);
 
+    if (_stream)
+    {
+        _stream->flush();
+        _unflushed = 0;
+        return;
+    }
+
     std::ofstream out(filePath);
     if (!out.is_open())
         return;
 
     out << "[\n";
-    for (size_t i = 0; i < _entries.size(); ++i)
+    for (size_t i = 0; i < _entriesCount; ++i)
     {
-        out << "  " << _entries[i];
-        if (i < _entries.size() - 1)
+        out << "  " << _entries[(_entriesHead + i) % MEMORY_ENTRIES];
+        if (i < _entriesCount - 1)
             out << ",";
         out << "\n";
     }
@@ -87,6 +128,239 @@ void Logger::flush(const std::string& filePath)
     out.close();
 }
 
+/*
+ * Description : Opens the streaming sink; entries already kept in memory
+ *               are the first ones written to it.
+ */
+void Logger::openStream(const LogStreamConfig& config)
+{
+    drainRings();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_stream)
+        _stream->flush();
+
+    _stream = std::make_unique<LogFileSink>(config);
+    spillEntries();
+    _stream->flush();
+    _unflushed = 0;
+}
+
+/*
+ * Description : Writes out what is pending and returns to in-memory logging.
+ */
+void Logger::closeStream()
+{
+    drainRings();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_stream)
+        return;
+
+    _stream->flush();
+    _stream.reset();
+    _unflushed = 0;
+}
+
+/*
+ * Description : Starts the drain thread and routes producers to their rings.
+ */
+void Logger::startAsync(std::size_t ringCapacity)
+{
+    if (_async.load(std::memory_order_acquire))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+        _ringCapacity = ringCapacity;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_drainSignalMutex);
+        _stopDrain = false;
+    }
+
+    _drainThread = std::thread(&Logger::drainLoop, this);
+    _async.store(true, std::memory_order_release);
+}
+
+/*
+ * Description : Returns producers to the synchronous path, then joins the
+ *               drain thread after a final drain.
+ */
+void Logger::stopAsync()
+{
+    _async.store(false, std::memory_order_release);
+
+    if (!_drainThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_drainSignalMutex);
+        _stopDrain = true;
+    }
+    _drainSignal.notify_one();
+    _drainThread.join();
+
+    drainRings();
+}
+
+bool Logger::isAsync() const
+{
+    return _async.load(std::memory_order_acquire);
+}
+
+/*
+ * Description : Sums the dropped-record counters of all rings.
+ */
+std::uint64_t Logger::droppedCount() const
+{
+    std::lock_guard<std::mutex> lock(_ringsMutex);
+
+    std::uint64_t dropped = 0;
+    for (const auto& ring : _rings)
+        dropped += ring->droppedCount();
+    return dropped;
+}
+
+/*
+ * Description : Returns the ring owned by the calling thread. The first call
+ *               on a thread reuses a ring released by an exited thread or
+ *               registers a new one; later calls are a single TLS read.
+ */
+LogRingBuffer* Logger::localRing()
+{
+    if (tlsLease.ring)
+        return tlsLease.ring;
+
+    std::lock_guard<std::mutex> lock(_ringsMutex);
+
+    for (auto& ring : _rings)
+    {
+        if (ring->claim())
+        {
+            tlsLease.ring = ring.get();
+            return tlsLease.ring;
+        }
+    }
+
+    _rings.push_back(std::make_unique<LogRingBuffer>(_ringCapacity));
+    _rings.back()->claim();
+    tlsLease.ring = _rings.back().get();
+    return tlsLease.ring;
+}
+
+/*
+ * Description : Formats every published record into the stream or _entries.
+ */
+std::size_t Logger::drainRings()
+{
+    std::lock_guard<std::mutex> drainLock(_drainMutex);
+
+    std::vector<LogRingBuffer*> rings;
+    {
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+        rings.reserve(_rings.size());
+        for (auto& ring : _rings)
+            rings.push_back(ring.get());
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::size_t drained = 0;
+    for (LogRingBuffer* ring : rings)
+    {
+        drained += ring->drain([this](const LogRecord& record)
+        {
+            appendEntry(_formatter.format(
+                record.timestampNs,
+                std::string_view(record.source, record.sourceLength),
+                std::string_view(record.action, record.actionLength),
+                std::string_view(record.target, record.targetLength),
+                std::string_view(record.result, record.resultLength)));
+        });
+    }
+
+    return drained;
+}
+
+/*
+ * Description : Drains the rings until stopAsync() is requested, sleeping
+ *               briefly whenever there is nothing to do. Idle passes also
+ *               flush whatever the stream has not flushed yet.
+ */
+void Logger::drainLoop()
+{
+    while (true)
+    {
+        if (drainRings() > 0)
+            continue;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stream && _unflushed > 0)
+            {
+                _stream->flush();
+                _unflushed = 0;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(_drainSignalMutex);
+        if (_stopDrain)
+            break;
+        _drainSignal.wait_for(lock, DRAIN_INTERVAL, [this] { return _stopDrain; });
+    }
+}
+
+/*
+ * Description : With a stream open the formatter's buffer is written to it
+ *               directly. Otherwise the entry is copied into the oldest
+ *               slot of the ring, whose buffer is reused, so neither path
+ *               allocates once the ring is warm.
+ */
+void Logger::appendEntry(std::string_view entry)
+{
+    if (_stream)
+    {
+        _stream->append(entry);
+        if (++_unflushed >= _stream->config().maxBufferedEntries)
+        {
+            _stream->flush();
+            _unflushed = 0;
+        }
+        return;
+    }
+
+    if (_entries.empty())
+    {
+        _entries.resize(MEMORY_ENTRIES);
+        for (auto& slot : _entries)
+            slot.reserve(ENTRY_RESERVE);
+    }
+
+    const std::size_t slot = (_entriesHead + _entriesCount) % MEMORY_ENTRIES;
+    if (_entriesCount == MEMORY_ENTRIES)
+        _entriesHead = (_entriesHead + 1) % MEMORY_ENTRIES;  // Overwrite the oldest
+    else
+        ++_entriesCount;
+
+    _entries[slot].assign(entry.data(), entry.size());
+}
+
+/*
+ * Description : Appends the in-memory entries to the stream, oldest first,
+ *               and empties the ring (its buffers are kept).
+ */
+void Logger::spillEntries()
+{
+    if (!_stream)
+        return;
+
+    for (std::size_t i = 0; i < _entriesCount; ++i)
+        _stream->append(_entries[(_entriesHead + i) % MEMORY_ENTRIES]);
+    _entriesHead = 0;
+    _entriesCount = 0;
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/